@@ -24,9 +24,12 @@
 #include "osm2rdf/Version.h"
 #include "osm2rdf/config/Config.h"
 #include "osm2rdf/config/ExitCode.h"
+#include "osm2rdf/osm/LocationHandler.h"
 #include "osm2rdf/osm/OsmiumHandler.h"
+#include "osm2rdf/osm/UpdateHandler.h"
 #include "osm2rdf/ttl/Writer.h"
 #include "osm2rdf/util/Ram.h"
+#include "osm2rdf/util/Shards.h"
 #include "osm2rdf/util/Time.h"
 #include "osmium/util/memory.hpp"
 
@@ -35,7 +38,7 @@
 #endif
 
 // ____________________________________________________________________________
-template <typename T>
+template <typename T, typename L>
 void run(const osm2rdf::config::Config& config) {
   // Setup
   // Input file reference
@@ -45,15 +48,18 @@ void run(const osm2rdf::config::Config& config) {
     exit(1);
   }
   osm2rdf::ttl::Writer<T> writer{config, &output};
-  writer.writeHeader();
+  // Shards are concatenated, only the first one starts with the header.
+  if (!config.shardWorker || config.shard == 0) {
+    writer.writeHeader();
+  }
 
   osm2rdf::osm::GeometryHandler<T> geomHandler(config, &writer);
 
   {
     osm2rdf::osm::FactHandler<T> factHandler(config, &writer);
 
-    osm2rdf::osm::OsmiumHandler osmiumHandler{config, &factHandler,
-                                              &geomHandler};
+    osm2rdf::osm::OsmiumHandler<T, L> osmiumHandler{config, &factHandler,
+                                                    &geomHandler};
     osmiumHandler.handle();
   }
 
@@ -79,6 +85,57 @@ void run(const osm2rdf::config::Config& config) {
   }
 }
 
+// ____________________________________________________________________________
+template <typename T>
+void update(const osm2rdf::config::Config& config) {
+  osm2rdf::util::Output output{config, config.output};
+  if (!output.open()) {
+    std::cerr << "Error opening outputfile: " << config.output << std::endl;
+    exit(1);
+  }
+  osm2rdf::ttl::Writer<T> writer{config, &output};
+  {
+    osm2rdf::osm::FactHandler<T> factHandler(config, &writer);
+    osm2rdf::osm::UpdateHandler<T> updateHandler{config, &factHandler,
+                                                 &writer, &output};
+    updateHandler.handle();
+  }
+
+  osmium::MemoryUsage memory;
+  std::cerr << osm2rdf::util::formattedTimeSpacer
+            << "Memory used: " << memory.peak() << " MBytes" << std::endl;
+
+  output.close();
+}
+
+// ____________________________________________________________________________
+template <typename T>
+void run(const osm2rdf::config::Config& config) {
+  if (!config.updateChanges.empty()) {
+    update<T>(config);
+    return;
+  }
+  // Select the location handler once, all per node calls are resolved at
+  // compile time.
+  if (config.storeLocations == "disk-sparse") {
+    run<T, osm2rdf::osm::LocationHandlerFSSparse>(config);
+  } else if (config.storeLocations == "disk-dense") {
+    run<T, osm2rdf::osm::LocationHandlerFSDense>(config);
+  } else if (config.storeLocations == "disk-persistent") {
+    run<T, osm2rdf::osm::LocationHandlerFSPersistent>(config);
+  } else if (config.storeLocations == "mem-compressed") {
+    run<T, osm2rdf::osm::LocationHandlerRAMCompressed>(config);
+  } else if (config.storeLocations == "mem-required") {
+    run<T, osm2rdf::osm::LocationHandlerRAMRequired>(config);
+  } else if (config.storeLocations == "mem-dense-paged") {
+    run<T, osm2rdf::osm::LocationHandlerRAMDensePaged>(config);
+  } else if (config.storeLocations == "mem-dense") {
+    run<T, osm2rdf::osm::LocationHandlerRAMDense>(config);
+  } else {
+    run<T, osm2rdf::osm::LocationHandlerRAMFlex>(config);
+  }
+}
+
 // ____________________________________________________________________________
 int main(int argc, char** argv) {
   std::cerr << osm2rdf::util::currentTimeFormatted()
@@ -96,6 +153,17 @@ int main(int argc, char** argv) {
                    (osm2rdf::util::ram::GIGA * 1.0)
             << "G" << std::endl;
 
+  if (config.shards > 1 && !config.shardWorker) {
+    const int exitCode = osm2rdf::util::runShards(config, argc, argv);
+    std::cerr << osm2rdf::util::currentTimeFormatted()
+              << "osm2rdf :: " << osm2rdf::version::GIT_INFO
+              << (exitCode == osm2rdf::config::ExitCode::SUCCESS
+                      ? " :: FINISHED"
+                      : " :: ERROR")
+              << std::endl;
+    std::exit(exitCode);
+  }
+
 #if defined(_OPENMP)
   omp_set_num_threads(config.numThreads);
 #endif
@@ -0,0 +1,79 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/OrientedBoundingBox.h"
+
+#include <cmath>
+
+#include "benchmark/benchmark.h"
+#include "util/geo/Geo.h"
+
+// ---------------------------------------------------------------------------
+// Builds a closed, coastline-like ring with count vertices: a circle whose
+// radius is perturbed by several harmonics so that the hull stays large.
+static ::util::geo::DLine createCoastline(size_t count) {
+  ::util::geo::DLine line;
+  line.reserve(count + 1);
+  for (size_t i = 0; i < count; ++i) {
+    const double a = 2 * M_PI * i / count;
+    const double r = 1.0 + 0.1 * std::sin(7 * a) + 0.05 * std::sin(31 * a) +
+                     0.02 * std::sin(257 * a);
+    line.emplace_back(7.8 + 0.4 * r * std::cos(a),
+                      48.0 + 0.2 * r * std::sin(a));
+  }
+  line.push_back(line.front());
+  return line;
+}
+
+// ---------------------------------------------------------------------------
+// Previous approach: rotate the full geometry in 1 degree steps and keep the
+// smallest axis-aligned envelope.
+static void OrientedBoundingBox_rotationSearch(benchmark::State& state) {
+  const auto line = createCoastline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ::util::geo::convexHull(::util::geo::getOrientedEnvelope(line)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(OrientedBoundingBox_rotationSearch)->Range(1 << 8, 1 << 16);
+
+// ---------------------------------------------------------------------------
+// Rotating calipers on the convex hull, including the hull computation.
+static void OrientedBoundingBox_rotatingCalipers(benchmark::State& state) {
+  const auto line = createCoastline(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(osm2rdf::osm::orientedBoundingBox(
+        ::util::geo::convexHull(line)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(OrientedBoundingBox_rotatingCalipers)->Range(1 << 8, 1 << 16);
+
+// ---------------------------------------------------------------------------
+// Rotating calipers on an already computed hull, as done in finalize().
+static void OrientedBoundingBox_rotatingCalipersHullOnly(
+    benchmark::State& state) {
+  const auto hull = ::util::geo::convexHull(createCoastline(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(osm2rdf::osm::orientedBoundingBox(hull));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(OrientedBoundingBox_rotatingCalipersHullOnly)
+    ->Range(1 << 8, 1 << 16);
@@ -0,0 +1,85 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/OsmiumHandler.h"
+
+#include <filesystem>
+
+#include "benchmark/benchmark.h"
+#include "osm2rdf/ttl/Format.h"
+#include "osm2rdf/util/Output.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/builder/osm_object_builder.hpp"
+#include "osmium/visitor.hpp"
+
+// ---------------------------------------------------------------------------
+static osmium::memory::Buffer createNodes(size_t count) {
+  osmium::memory::Buffer buffer{count * 128,
+                                osmium::memory::Buffer::auto_grow::yes};
+  for (size_t i = 0; i < count; ++i) {
+    osmium::builder::add_node(
+        buffer, osmium::builder::attr::_id(i + 1),
+        osmium::builder::attr::_location(
+            osmium::Location(7.51 + (i % 1000) * 0.001, 48.0)),
+        osmium::builder::attr::_tag("city", "Freiburg"));
+  }
+  return buffer;
+}
+
+// ---------------------------------------------------------------------------
+// Dumps facts and geometries of state.range(1) nodes with a batch size of
+// state.range(0). A batch size of 1 spawns one task per object.
+static void OsmiumHandler_QLEVER_nodes(benchmark::State& state) {
+  osm2rdf::config::Config config;
+  config.batchSize = state.range(0);
+  config.outputCompress = osm2rdf::config::NONE;
+  config.mergeOutput = osm2rdf::util::OutputMergeMode::NONE;
+  config.output = config.getTempPath("OsmiumHandlerBenchmark", "output");
+  auto buffer = createNodes(state.range(1));
+
+  osm2rdf::util::Output output{config, config.output};
+  output.open();
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::QLEVER> writer{config, &output};
+  osm2rdf::osm::FactHandler<osm2rdf::ttl::format::QLEVER> factHandler(
+      config, &writer);
+  osm2rdf::osm::GeometryHandler<osm2rdf::ttl::format::QLEVER> geomHandler(
+      config, &writer);
+
+  for (auto _ : state) {
+    osm2rdf::osm::OsmiumHandler<osm2rdf::ttl::format::QLEVER> osmiumHandler{
+        config, &factHandler, &geomHandler};
+#pragma omp parallel
+    {
+#pragma omp single
+      { osmium::apply(buffer, osmiumHandler); }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+
+  output.close();
+  for (const auto& entry : std::filesystem::directory_iterator(
+           config.output.parent_path())) {
+    if (entry.path().filename().string().rfind(
+            config.output.filename().string(), 0) == 0) {
+      std::filesystem::remove(entry.path());
+    }
+  }
+}
+BENCHMARK(OsmiumHandler_QLEVER_nodes)
+    ->ArgsProduct({{1, 64, 1024}, {1 << 14, 1 << 17}})
+    ->UseRealTime();
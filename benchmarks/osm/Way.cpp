@@ -0,0 +1,127 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/Way.h"
+
+#include <cmath>
+
+#include "benchmark/benchmark.h"
+#include "osm2rdf/osm/Area.h"
+#include "osm2rdf/osm/FixedGeom.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/builder/osm_object_builder.hpp"
+#include "util/geo/Geo.h"
+
+// ---------------------------------------------------------------------------
+static osmium::memory::Buffer createWay(size_t count) {
+  osmium::memory::Buffer buffer{count * 32,
+                                osmium::memory::Buffer::auto_grow::yes};
+  {
+    osmium::builder::WayBuilder builder{buffer};
+    builder.set_id(42);
+    osmium::builder::WayNodeListBuilder nodes{builder};
+    for (size_t i = 0; i < count; ++i) {
+      nodes.add_node_ref(osmium::NodeRef(
+          i + 1, osmium::Location(7.51 + i * 0.0001, 48.0 + (i % 2) * 0.001)));
+    }
+  }
+  buffer.commit();
+  return buffer;
+}
+
+// ---------------------------------------------------------------------------
+// Converts the geometry of a way with state.range(0) nodes and measures its
+// length twice (length triple and WKT simplification) with separate calls.
+static void Way_metrics_separate(benchmark::State& state) {
+  auto buffer = createWay(state.range(0));
+  for (auto _ : state) {
+    const osm2rdf::osm::Way way{buffer.get<osmium::Way>(0)};
+    const auto geom = osm2rdf::osm::toDouble(way.fixedGeom());
+    benchmark::DoNotOptimize(::util::geo::len(geom));
+    benchmark::DoNotOptimize(::util::geo::len(geom));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Way_metrics_separate)->Range(1 << 4, 1 << 16);
+
+// ---------------------------------------------------------------------------
+// Same as above using the length measured while converting the geometry.
+static void Way_metrics_fused(benchmark::State& state) {
+  auto buffer = createWay(state.range(0));
+  for (auto _ : state) {
+    const osm2rdf::osm::Way way{buffer.get<osmium::Way>(0)};
+    benchmark::DoNotOptimize(way.geom());
+    benchmark::DoNotOptimize(way.length());
+    benchmark::DoNotOptimize(way.length());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Way_metrics_fused)->Range(1 << 4, 1 << 16);
+
+// ---------------------------------------------------------------------------
+static osmium::memory::Buffer createArea(size_t count) {
+  osmium::memory::Buffer buffer{count * 32,
+                                osmium::memory::Buffer::auto_grow::yes};
+  {
+    osmium::builder::AreaBuilder builder{buffer};
+    builder.set_id(42);
+    osmium::builder::OuterRingBuilder ring{builder};
+    for (size_t i = 0; i < count; ++i) {
+      const double angle = 2 * M_PI * i / count;
+      ring.add_node_ref(osmium::NodeRef(
+          i + 1, osmium::Location(7.8 + 0.1 * std::cos(angle),
+                                  48.0 + 0.1 * std::sin(angle))));
+    }
+    ring.add_node_ref(osmium::NodeRef(1, osmium::Location(7.9, 48.0)));
+  }
+  buffer.commit();
+  return buffer;
+}
+
+// ---------------------------------------------------------------------------
+// Converts the geometry of an area with state.range(0) nodes, measures its
+// perimeter (WKT simplification) and computes its centroid twice with
+// separate calls.
+static void Area_metrics_separate(benchmark::State& state) {
+  auto buffer = createArea(state.range(0));
+  for (auto _ : state) {
+    const osm2rdf::osm::Area area{buffer.get<osmium::Area>(0)};
+    const auto geom = osm2rdf::osm::toDouble(area.fixedGeom());
+    benchmark::DoNotOptimize(::util::geo::len(geom));
+    benchmark::DoNotOptimize(::util::geo::centroid(geom));
+    benchmark::DoNotOptimize(::util::geo::centroid(geom));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Area_metrics_separate)->Range(1 << 4, 1 << 16);
+
+// ---------------------------------------------------------------------------
+// Same as above using the perimeter measured while converting the geometry
+// and the memoized centroid.
+static void Area_metrics_fused(benchmark::State& state) {
+  auto buffer = createArea(state.range(0));
+  for (auto _ : state) {
+    const osm2rdf::osm::Area area{buffer.get<osmium::Area>(0)};
+    benchmark::DoNotOptimize(area.geom());
+    benchmark::DoNotOptimize(area.length());
+    benchmark::DoNotOptimize(area.centroid());
+    benchmark::DoNotOptimize(area.centroid());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Area_metrics_fused)->Range(1 << 4, 1 << 16);
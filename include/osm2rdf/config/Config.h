@@ -51,6 +51,15 @@ enum SourceDataset {
 struct Config {
   // Select what to do
   std::string storeLocations;
+  bool parallelLocations = false;
+  bool parallelAreas = false;
+  bool blobIndex = false;
+  // Only keep objects inside this region, empty for the whole input
+  std::string clipBbox;
+  std::filesystem::path clipPolygon;
+  // Write a SPARQL Update for this change file, input is the file it applies
+  // to
+  std::filesystem::path updateChanges;
 
   bool noFacts = false;
   bool noAreaFacts = false;
@@ -79,8 +88,20 @@ struct Config {
   bool addUntaggedWays = true;
   bool addUntaggedRelations = true;
   bool addUntaggedAreas = true;
+  // Only output objects matching this expression, see TagFilter
+  std::string tagFilter;
 
   int numThreads = std::thread::hardware_concurrency();
+  // Limits for queued objects in the second pass, 0 for unlimited
+  size_t maxInFlightObjects = 1 << 16;
+  size_t maxInFlightBytes = 0;
+  // Number of objects processed in a single task in the second pass
+  size_t batchSize = 1024;
+  // Number of worker processes converting disjoint id ranges, see Shards
+  size_t shards = 1;
+  // Set in worker processes, which only convert objects of shard
+  bool shardWorker = false;
+  size_t shard = 0;
 
   // Default settings for data
   std::unordered_set<std::string> semicolonTagKeys;
@@ -109,6 +130,10 @@ struct Config {
 
   // osmium location cache
   std::filesystem::path cache{std::filesystem::temp_directory_path()};
+  // Store and reuse the results of the first pass in the cache directory
+  bool snapshot = false;
+  // Keep the state needed by later updates in the cache directory
+  bool updateState = false;
 
   // Input file
   std::filesystem::path input;
@@ -122,6 +147,9 @@ struct Config {
   // Generate a path inside the cache directory.
   [[nodiscard]] std::filesystem::path getTempPath(
       const std::string& path, const std::string& suffix) const;
+
+  // Returns true if objects with the given id are converted by this process.
+  [[nodiscard]] bool isInShard(uint64_t id) const;
 };
 }  // namespace osm2rdf::config
 
@@ -55,6 +55,23 @@ const static inline std::string CACHE_OPTION_SHORT = "t";
 const static inline std::string CACHE_OPTION_LONG = "cache";
 const static inline std::string CACHE_OPTION_HELP = "Path to cache directory";
 
+const static inline std::string SNAPSHOT_INFO =
+    "Reusing first pass snapshots from cache";
+const static inline std::string SNAPSHOT_OPTION_SHORT = "";
+const static inline std::string SNAPSHOT_OPTION_LONG = "snapshot";
+const static inline std::string SNAPSHOT_OPTION_HELP =
+    "Store the results of the first pass in the cache directory and reuse "
+    "them on later runs over the same input";
+
+const static inline std::string UPDATE_STATE_INFO =
+    "Keeping update state in cache";
+const static inline std::string UPDATE_STATE_OPTION_SHORT = "";
+const static inline std::string UPDATE_STATE_OPTION_LONG = "update-state";
+const static inline std::string UPDATE_STATE_OPTION_HELP =
+    "Store all ways and relations and the objects referencing them in the "
+    "cache directory for later --update runs; implies --store-locations "
+    "disk-persistent and a single shard";
+
 const static inline std::string INPUT_INFO = "Input:";
 
 const static inline std::string OUTPUT_INFO = "Output:";
@@ -88,7 +105,59 @@ const static inline std::string STORE_LOCATIONS_SHORT = "";
 const static inline std::string STORE_LOCATIONS_LONG = "store-locations";
 const static inline std::string STORE_LOCATIONS_HELP =
     "Method used to store locations, valid values: mem-flex (default), "
-    "mem-dense, disk-sparse, disk-dense ";
+    "mem-dense, mem-dense-paged (pages allocated on first use), "
+    "mem-compressed (delta encoded blocks, expects sorted input), "
+    "mem-required (only nodes referenced by ways or relations, default for "
+    "shard workers), "
+    "disk-sparse, disk-dense, disk-persistent (kept in the cache directory "
+    "and reused for the same input)";
+
+const static inline std::string CLIP_BBOX_INFO = "Clipping to bounding box:";
+const static inline std::string CLIP_BBOX_OPTION_SHORT = "";
+const static inline std::string CLIP_BBOX_OPTION_LONG = "clip-bbox";
+const static inline std::string CLIP_BBOX_OPTION_HELP =
+    "Only keep objects inside the bounding box minLon,minLat,maxLon,maxLat, "
+    "ways and relations are kept complete";
+
+const static inline std::string CLIP_POLYGON_INFO = "Clipping to polygon:";
+const static inline std::string CLIP_POLYGON_OPTION_SHORT = "";
+const static inline std::string CLIP_POLYGON_OPTION_LONG = "clip-polygon";
+const static inline std::string CLIP_POLYGON_OPTION_HELP =
+    "Only keep objects inside the polygons of an Osmosis polygon filter "
+    "(.poly) file, ways and relations are kept complete";
+
+const static inline std::string UPDATE_INFO = "Writing SPARQL Update for:";
+const static inline std::string UPDATE_OPTION_SHORT = "";
+const static inline std::string UPDATE_OPTION_LONG = "update";
+const static inline std::string UPDATE_OPTION_HELP =
+    "Write a SPARQL Update for the given OSM change file (.osc) instead of "
+    "the full output and apply it to the state written with --update-state; "
+    "the input has to be the one of that run, implies N-Triples, the target "
+    "has to be written with --write-ogc-geo-triples none";
+
+const static inline std::string PARALLEL_LOCATIONS_INFO =
+    "Resolving way node locations in parallel";
+const static inline std::string PARALLEL_LOCATIONS_OPTION_SHORT = "";
+const static inline std::string PARALLEL_LOCATIONS_OPTION_LONG =
+    "parallel-locations";
+const static inline std::string PARALLEL_LOCATIONS_OPTION_HELP =
+    "Resolve the node locations of all ways in a block with multiple threads";
+
+const static inline std::string PARALLEL_AREAS_INFO =
+    "Assembling multipolygon areas in parallel";
+const static inline std::string PARALLEL_AREAS_OPTION_SHORT = "";
+const static inline std::string PARALLEL_AREAS_OPTION_LONG = "parallel-areas";
+const static inline std::string PARALLEL_AREAS_OPTION_HELP =
+    "Assemble the areas of multipolygon relations in separate threads "
+    "instead of the reading thread";
+
+const static inline std::string BLOB_INDEX_INFO =
+    "Decoding PBF blobs of the first pass in parallel";
+const static inline std::string BLOB_INDEX_OPTION_SHORT = "";
+const static inline std::string BLOB_INDEX_OPTION_LONG = "blob-index";
+const static inline std::string BLOB_INDEX_OPTION_HELP =
+    "Index the blobs of PBF input and decode them with independent readers "
+    "in parallel during the first pass";
 
 const static inline std::string NO_FACTS_INFO = "Not dumping facts";
 const static inline std::string NO_FACTS_OPTION_SHORT = "";
@@ -207,6 +276,17 @@ const static inline std::string NO_UNTAGGED_AREAS_OPTION_LONG =
 const static inline std::string NO_UNTAGGED_AREAS_OPTION_HELP =
     "Do not output untagged areas";
 
+const static inline std::string TAG_FILTER_INFO =
+    "Only output objects matching:";
+const static inline std::string TAG_FILTER_OPTION_SHORT = "";
+const static inline std::string TAG_FILTER_OPTION_LONG = "tag-filter";
+const static inline std::string TAG_FILTER_OPTION_HELP =
+    "Only output objects whose tags match the expression: terms separated by "
+    "',' of which one has to match, each a list of conditions separated by "
+    "'&' which all have to match, e.g. "
+    "'highway=*,boundary=administrative&admin_level=2|4', '!' negates a "
+    "condition";
+
 const static inline std::string ADD_AREA_WAY_LINESTRINGS_INFO =
     "Adding linestrings for ways which form areas";
 const static inline std::string ADD_AREA_WAY_LINESTRINGS_OPTION_SHORT = "";
@@ -319,6 +399,46 @@ const static inline std::string NUM_THREADS_OPTION_LONG = "num-threads";
 const static inline std::string NUM_THREADS_OPTION_HELP =
     "Number of threads to use";
 
+const static inline std::string MAX_IN_FLIGHT_OBJECTS_INFO =
+    "Max in-flight objects:";
+const static inline std::string MAX_IN_FLIGHT_OBJECTS_OPTION_SHORT = "";
+const static inline std::string MAX_IN_FLIGHT_OBJECTS_OPTION_LONG =
+    "max-in-flight-objects";
+const static inline std::string MAX_IN_FLIGHT_OBJECTS_OPTION_HELP =
+    "Maximal number of objects waiting to be dumped before reading is "
+    "paused, 0 for unlimited";
+
+const static inline std::string MAX_IN_FLIGHT_BYTES_INFO =
+    "Max in-flight bytes:";
+const static inline std::string MAX_IN_FLIGHT_BYTES_OPTION_SHORT = "";
+const static inline std::string MAX_IN_FLIGHT_BYTES_OPTION_LONG =
+    "max-in-flight-bytes";
+const static inline std::string MAX_IN_FLIGHT_BYTES_OPTION_HELP =
+    "Maximal size of objects waiting to be dumped before reading is paused, "
+    "0 for unlimited";
+
+const static inline std::string BATCH_SIZE_INFO = "Objects per task:";
+const static inline std::string BATCH_SIZE_OPTION_SHORT = "";
+const static inline std::string BATCH_SIZE_OPTION_LONG = "batch-size";
+const static inline std::string BATCH_SIZE_OPTION_HELP =
+    "Maximal number of objects of the same type processed in a single task, "
+    "1 to process each object in its own task";
+
+const static inline std::string SHARDS_INFO = "Worker processes:";
+const static inline std::string SHARDS_OPTION_SHORT = "";
+const static inline std::string SHARDS_OPTION_LONG = "shards";
+const static inline std::string SHARDS_OPTION_HELP =
+    "Convert with this many worker processes, each handling a disjoint set "
+    "of id ranges with an equal share of --num-threads and its own "
+    "directory in --cache, and concatenate their outputs in order; requires "
+    "an output file, disables geometric relations";
+
+const static inline std::string SHARD_INFO = "Converting shard:";
+const static inline std::string SHARD_OPTION_SHORT = "";
+const static inline std::string SHARD_OPTION_LONG = "shard";
+const static inline std::string SHARD_OPTION_HELP =
+    "Only convert the given shard of --shards, used by the worker processes";
+
 const static inline std::string WKT_PRECISION_INFO =
     "Dumping WKT with precision: ";
 const static inline std::string WKT_PRECISION_OPTION_SHORT = "";
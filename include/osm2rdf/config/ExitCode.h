@@ -30,7 +30,10 @@ enum ExitCode {
   INPUT_NOT_EXISTS,
   INPUT_IS_DIRECTORY,
   CACHE_NOT_EXISTS = 21,
-  CACHE_NOT_DIRECTORY
+  CACHE_NOT_DIRECTORY,
+  CLIP_POLYGON_NOT_EXISTS = 31,
+  UPDATE_CHANGES_NOT_EXISTS,
+  UPDATE_REQUIRES_NO_GEOMETRIC_RELATIONS
 };
 
 }
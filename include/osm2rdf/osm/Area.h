@@ -41,12 +41,17 @@ struct Area {
   // OSM id.
   [[nodiscard]] id_t objId() const noexcept;
 
+  // Converted from the fixed-point geometry on first use, not thread-safe.
   [[nodiscard]] const ::util::geo::DMultiPolygon& geom() const noexcept;
+  [[nodiscard]] const ::util::geo::I32MultiPolygon& fixedGeom() const noexcept;
+  // Perimeter of the outer rings of geom(), measured while converting it.
+  [[nodiscard]] double length() const noexcept;
   [[nodiscard]] double geomArea() const noexcept;
   [[nodiscard]] const ::util::geo::DBox& envelope() const noexcept;
   [[nodiscard]] double envelopeArea() const noexcept;
   [[nodiscard]] const ::util::geo::DPolygon& convexHull() const noexcept;
   [[nodiscard]] const ::util::geo::DPolygon& orientedBoundingBox() const noexcept;
+  // Computed on first use, not thread-safe.
   [[nodiscard]] const ::util::geo::DPoint centroid() const noexcept;
   [[nodiscard]] bool fromWay() const noexcept;
   [[nodiscard]] bool hasName() const noexcept;
@@ -64,7 +69,11 @@ struct Area {
   bool _hasName = false;
   double _geomArea = 0;
   double _envelopeArea = 0;
-  ::util::geo::DMultiPolygon _geom;
+  ::util::geo::I32MultiPolygon _fixedGeom;
+  mutable ::util::geo::DMultiPolygon _geom;
+  mutable double _length = 0;
+  mutable ::util::geo::DPoint _centroid;
+  mutable bool _hasCentroid = false;
   ::util::geo::DBox _envelope;
   ::util::geo::DPolygon _convexHull;
   ::util::geo::DPolygon _obb;
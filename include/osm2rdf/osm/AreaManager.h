@@ -0,0 +1,100 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_AREAMANAGER_H_
+#define OSM2RDF_OSM_AREAMANAGER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "osmium/area/assembler.hpp"
+#include "osmium/area/stats.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/relation.hpp"
+#include "osmium/osm/way.hpp"
+#include "osmium/relations/relations_manager.hpp"
+
+namespace osm2rdf::osm {
+
+// Replacement for osmium::area::MultipolygonManager selecting the same
+// multipolygon and boundary relations and closed ways. With numThreads > 0,
+// each complete multipolygon relation is copied together with its member
+// ways and queued for a pool of numThreads assembly threads owned by the
+// manager. The reading thread never assembles relations, it only collects
+// the finished areas with drain(). The pool is separate from OpenMP, so
+// task scheduling points of the reading thread never pick up an assembly.
+class AreaManager
+    : public osmium::relations::RelationsManager<AreaManager, false, true,
+                                                 false> {
+ public:
+  AreaManager(const osmium::area::Assembler::config_type& assemblerConfig,
+              std::size_t numThreads);
+  virtual ~AreaManager();
+
+  // Called by osmium::relations::RelationsManager.
+  [[nodiscard]] bool new_relation(
+      const osmium::Relation& relation) const noexcept;
+  [[nodiscard]] bool new_member(const osmium::Relation& relation,
+                                const osmium::RelationMember& member,
+                                std::size_t n) const noexcept;
+  void complete_relation(const osmium::Relation& relation);
+  void after_way(const osmium::Way& way);
+
+  // Passes all areas assembled by the pool since the last call to callback.
+  // Only called by the reading thread.
+  void drain(const std::function<void(osmium::memory::Buffer&&)>& callback);
+  // Blocks until all queued relations are assembled.
+  void wait();
+  // Number of relations handed to the pool and not yet assembled.
+  [[nodiscard]] size_t pending() const noexcept;
+  [[nodiscard]] osmium::area::area_stats stats() const;
+
+ protected:
+  // Assembles relation from ways into buffer.
+  virtual void assemble(const osmium::Relation& relation,
+                        const std::vector<const osmium::Way*>& ways,
+                        osmium::memory::Buffer* buffer);
+  // Loop of the assembly threads.
+  void work();
+
+  const osmium::area::Assembler::config_type _assemblerConfig;
+  std::atomic<size_t> _pending{0};
+  mutable std::mutex _mutex;
+  // Guarded by _mutex.
+  osmium::area::area_stats _stats;
+  std::vector<osmium::memory::Buffer> _assembled;
+  // Each buffer holds a relation followed by its member ways. Guarded by
+  // _queueMutex, _queueChanged signals new buffers, assembled relations and
+  // stopping.
+  std::mutex _queueMutex;
+  std::condition_variable _queueChanged;
+  std::deque<std::unique_ptr<osmium::memory::Buffer>> _queue;
+  bool _stopping = false;
+  std::vector<std::thread> _threads;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_AREAMANAGER_H_
@@ -0,0 +1,109 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_CLIPHANDLER_H
+#define OSM2RDF_OSM_CLIPHANDLER_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "osm2rdf/config/Config.h"
+#include "osm2rdf/osm/ClipRegion.h"
+#include "osm2rdf/util/RankBitVector.h"
+#include "osmium/handler.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/node.hpp"
+#include "osmium/osm/object.hpp"
+#include "osmium/osm/relation.hpp"
+#include "osmium/osm/way.hpp"
+
+namespace osm2rdf::osm {
+
+// Decides which objects are kept when clipping the input to a region. Nodes
+// inside the region, ways with at least one node inside the region together
+// with all of their nodes, and relations with at least one kept member are
+// kept. Kept relations are kept complete with all of their member nodes and
+// ways, so that areas and relation geometries crossing the border are not
+// truncated. Member relations are only kept if they have kept members
+// themselves. Needs to see all objects in input order during the first read,
+// the nodes of member ways outside the region are collected in a second read
+// of the ways, see completeWay.
+class ClipHandler : public osmium::handler::Handler {
+ public:
+  explicit ClipHandler(ClipRegion region);
+  // Helper returning the handler for the configured region, nullptr if the
+  // input is not clipped.
+  static std::unique_ptr<ClipHandler> create(
+      const osm2rdf::config::Config& config);
+
+  void node(const osmium::Node& node);
+  void way(const osmium::Way& way);
+  void relation(const osmium::Relation& relation);
+  // Called after the first read. Keeps relations whose only kept members are
+  // relations appearing later in the input and the members of all kept
+  // relations.
+  void prepare_for_lookup();
+  // True if kept relations have member ways outside the region. Their nodes
+  // are only known after all ways of the input were passed to completeWay,
+  // followed by a call to finalize.
+  [[nodiscard]] bool hasIncompleteWays() const noexcept;
+  void completeWay(const osmium::Way& way);
+  void finalize();
+
+  [[nodiscard]] bool keep(const osmium::OSMObject& object) const noexcept;
+  // Returns a buffer containing only the kept objects of buffer.
+  [[nodiscard]] osmium::memory::Buffer filter(
+      const osmium::memory::Buffer& buffer) const;
+
+  [[nodiscard]] uint64_t numNodes() const noexcept { return _nodes.count(); }
+  [[nodiscard]] uint64_t numWays() const noexcept { return _ways.count(); }
+  [[nodiscard]] uint64_t numRelations() const noexcept {
+    return _relations.count();
+  }
+  // Id range of all kept nodes, including nodes outside the region.
+  [[nodiscard]] uint64_t minNodeId() const noexcept { return _minNodeId; }
+  [[nodiscard]] uint64_t maxNodeId() const noexcept { return _maxNodeId; }
+
+ protected:
+  void keepNode(uint64_t id);
+
+  ClipRegion _region;
+  osm2rdf::util::RankBitVector _insideNodes;
+  osm2rdf::util::RankBitVector _nodes;
+  osm2rdf::util::RankBitVector _ways;
+  osm2rdf::util::RankBitVector _relations;
+  // Relations with relation members not kept when they were seen, as pairs of
+  // member and relation id.
+  std::vector<std::pair<uint64_t, uint64_t>> _relationMembers;
+  // Node and way members of these relations, as pairs of relation and member
+  // id.
+  std::vector<std::pair<uint64_t, uint64_t>> _pendingNodes;
+  std::vector<std::pair<uint64_t, uint64_t>> _pendingWays;
+  // Sorted ids of member ways of kept relations, which were not kept because
+  // of the region.
+  std::vector<uint64_t> _incompleteWays;
+  uint64_t _minNodeId = std::numeric_limits<uint64_t>::max();
+  uint64_t _maxNodeId = 0;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_CLIPHANDLER_H
@@ -0,0 +1,73 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_CLIPREGION_H
+#define OSM2RDF_OSM_CLIPREGION_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "osmium/osm/box.hpp"
+#include "osmium/osm/location.hpp"
+
+namespace osm2rdf::osm {
+
+// Region the input is clipped to, either a bounding box or the polygons of an
+// Osmosis polygon filter file.
+class ClipRegion {
+ public:
+  // Parses a bounding box given as "minLon,minLat,maxLon,maxLat".
+  static ClipRegion fromBbox(std::string_view bbox);
+  // Reads an Osmosis polygon filter file. Sections starting with ! are holes.
+  static ClipRegion fromPolyFile(const std::filesystem::path& path);
+
+  [[nodiscard]] bool contains(const osmium::Location& location) const noexcept;
+  [[nodiscard]] const osmium::Box& envelope() const noexcept {
+    return _envelope;
+  }
+
+ protected:
+  ClipRegion() = default;
+  // Adds a closed ring, holes and outer rings are handled by the even-odd
+  // rule.
+  void addRing(const std::vector<osmium::Location>& ring);
+  // Sorts all edges into horizontal bands, needs to be called after the last
+  // ring was added.
+  void buildBands();
+
+  // Edge of a ring in osmium coordinates with y1 <= y2.
+  struct Edge {
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+  };
+
+  osmium::Box _envelope;
+  // Empty for bounding boxes.
+  std::vector<Edge> _edges;
+  // Edges crossing each band of _bandHeight rows, starting at the envelope.
+  std::vector<std::vector<Edge>> _bands;
+  int64_t _bandHeight = 1;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_CLIPREGION_H
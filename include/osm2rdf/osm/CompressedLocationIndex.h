@@ -0,0 +1,94 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_COMPRESSEDLOCATIONINDEX_H
+#define OSM2RDF_OSM_COMPRESSEDLOCATIONINDEX_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "osmium/index/index.hpp"
+#include "osmium/index/map.hpp"
+#include "osmium/osm/location.hpp"
+#include "osmium/osm/types.hpp"
+
+namespace osm2rdf::osm {
+
+// In-memory node location index storing locations in blocks of
+// kBlockSize consecutive ids. Each block consists of a bitmap of the ids
+// present and the zigzag varint encoded deltas of their coordinates. Gaps in
+// the id space only cost one offset per block.
+//
+// Locations are expected to be set in ascending id order, as they appear in
+// sorted input files. The block currently being filled is kept uncompressed.
+// Setting a location in an already compressed block re-encodes that block.
+// Lookups decode whole blocks and keep the last decoded blocks in a small
+// per-thread cache.
+class CompressedLocationIndex final
+    : public osmium::index::map::Map<osmium::unsigned_object_id_type,
+                                     osmium::Location> {
+ public:
+  static constexpr size_t kBlockBits = 8;
+  static constexpr size_t kBlockSize = 1 << kBlockBits;
+
+  CompressedLocationIndex(size_t minNodeId, size_t maxNodeId);
+
+  size_t size() const noexcept final { return _size; }
+  size_t used_memory() const noexcept final;
+
+  void set(const osmium::unsigned_object_id_type id,
+           const osmium::Location value) final;
+  osmium::Location get_noexcept(
+      const osmium::unsigned_object_id_type id) const noexcept final;
+  osmium::Location get(const osmium::unsigned_object_id_type id) const final;
+
+  void clear() final;
+  void sort() final {}
+
+ protected:
+  using Block = std::array<osmium::Location, kBlockSize>;
+  static constexpr size_t kChunkSize = 64 * 1024 * 1024;
+  static constexpr uint64_t kNoBlock = ~0ULL;
+
+  // Compresses the currently open block and stores it.
+  void closeBlock();
+  // Appends the encoded block and returns its offset.
+  uint64_t store(const Block& block);
+  // Decodes the block at given index into block.
+  void load(size_t blockIndex, Block* block) const;
+
+  size_t _offset;
+  size_t _size;
+  // Unique per index, used to validate entries of the thread local cache.
+  uint64_t _instance;
+  // Offset of each encoded block, kNoBlock for empty blocks.
+  std::vector<uint64_t> _blockOffsets;
+  std::vector<std::unique_ptr<uint8_t[]>> _chunks;
+  size_t _chunkUsed = kChunkSize;
+  // Block currently filled by set.
+  size_t _openBlockIndex = kNoBlock;
+  Block _openBlock;
+  // Incremented whenever a stored block is modified.
+  uint64_t _generation = 0;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_COMPRESSEDLOCATIONINDEX_H
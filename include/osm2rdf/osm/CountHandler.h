@@ -19,18 +19,47 @@
 #ifndef OSM2RDF_OSM_COUNTHANDLER_H
 #define OSM2RDF_OSM_COUNTHANDLER_H
 
+#include <memory>
+#include <vector>
+
 #include "osm2rdf/config/Config.h"
 #include "osm2rdf/osm/LocationHandler.h"
+#include "osm2rdf/osm/TagFilter.h"
+#include "osm2rdf/util/RankBitVector.h"
 
 namespace osm2rdf::osm {
 
 class CountHandler : public osmium::handler::Handler {
  public:
-  CountHandler(const osm2rdf::config::Config& config) : _config(config) {};
+  CountHandler(const osm2rdf::config::Config& config)
+      : _collectRequiredNodes(config.storeLocations == "mem-required"),
+        _config(config),
+        _tagFilter(config.tagFilter) {};
   void node(const osmium::Node& node);
   void relation(const osmium::Relation& relation);
   void way(const osmium::Way& way);
   void prepare_for_lookup();
+  // Counts nodes summarized without decoding them, see PbfBlobIndex::scan.
+  void countNodes(size_t numNodes, size_t numTaggedNodes, size_t minNodeId,
+                  size_t maxNodeId);
+  // Adds the results of other, which handled a disjoint part of the input.
+  void merge(const CountHandler& other);
+  // Collects the ids of required nodes in a list until flushRequiredNodes is
+  // called, instead of setting them in an own bit vector. Lets threads
+  // counting parts of the input share a single bit vector.
+  void bufferRequiredNodes();
+  [[nodiscard]] size_t numBufferedRequiredNodes() const;
+  // Sets all buffered ids in target and clears the list.
+  void flushRequiredNodes(osm2rdf::util::RankBitVector* target);
+  // Only collects the required nodes of objects converted by a shard worker:
+  // of ways and relations in its shard and of the relations and ways given,
+  // see ShardMemberHandler.
+  void restrictToShard(std::vector<uint64_t> relationIds,
+                       std::vector<uint64_t> wayIds);
+  // Restores the results of a previous first pass, see Snapshot.
+  void restore(size_t numNodes, size_t numRelations, size_t numWays,
+               size_t minNodeId, size_t maxNodeId,
+               osm2rdf::util::RankBitVector requiredNodes);
 
   size_t numNodes() const;
   size_t numRelations() const;
@@ -38,16 +67,33 @@ class CountHandler : public osmium::handler::Handler {
 
   size_t minNodeId() const { return _minId; };
   size_t maxNodeId() const { return _maxId; };
+  // Ids of all nodes referenced by ways or relations, see restrictToShard.
+  // Only collected for --store-locations mem-required, empty otherwise.
+  osm2rdf::util::RankBitVector& requiredNodes() { return _requiredNodes; };
 
  protected:
+  void addRequiredNode(uint64_t id);
+  // Returns true if the nodes of the object with id are required, i.e. if
+  // not restricted to a shard, if the id is in the shard or in ids.
+  [[nodiscard]] bool requiresMembers(uint64_t id,
+                                     const std::vector<uint64_t>* ids) const;
+
   size_t _numNodes = 0;
   size_t _numRelations = 0;
   size_t _numWays = 0;
   bool _firstPassDone = false;
   size_t _minId = std::numeric_limits<size_t>::max();
   size_t _maxId = 0;
+  bool _collectRequiredNodes;
+  bool _bufferRequiredNodes = false;
+  osm2rdf::util::RankBitVector _requiredNodes;
+  std::vector<uint64_t> _requiredNodeIds;
+  // Shared by all copies counting parts of the input.
+  std::shared_ptr<const std::vector<uint64_t>> _shardRelationIds;
+  std::shared_ptr<const std::vector<uint64_t>> _shardWayIds;
 
   osm2rdf::config::Config _config;
+  osm2rdf::osm::TagFilter _tagFilter;
 };
 }
 
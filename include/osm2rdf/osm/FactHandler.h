@@ -21,6 +21,8 @@
 #define OSM2RDF_OSM_FACTHANDLER_H_
 
 #include <ostream>
+#include <string>
+#include <string_view>
 
 #include "gtest/gtest_prod.h"
 #include "osm2rdf/config/Config.h"
@@ -51,6 +53,10 @@ class FactHandler {
   template <typename G>
   void writeGeometry(const std::string& s, const std::string& p,
                           const G& g);
+  // Same as above if the length or perimeter of g is already known.
+  template <typename G>
+  void writeGeometry(const std::string& s, const std::string& p,
+                          const G& g, double length);
 
  protected:
   void writeBox(const std::string& s, const std::string& p,
@@ -73,6 +79,7 @@ class FactHandler {
 
   void writeTagList(const std::string& s, const osm2rdf::osm::TagList& tags);
   FRIEND_TEST(OSM_FactHandler, writeTagList);
+  FRIEND_TEST(OSM_FactHandler, writeTagListKeyWithSpace);
   FRIEND_TEST(OSM_FactHandler, writeTagListWikidata);
   FRIEND_TEST(OSM_FactHandler, writeTagListRefSingle);
   FRIEND_TEST(OSM_FactHandler, writeTagListRefDouble);
@@ -103,10 +110,18 @@ class FactHandler {
                          const std::time_t& t);
   FRIEND_TEST(OSM_FactHandler, writeSecondsAsISO);
 
-  bool hasSuffix(const std::string& s, const std::string& suffix) const;
+  bool hasSuffix(std::string_view s, std::string_view suffix) const;
 
   const osm2rdf::config::Config _config;
   osm2rdf::ttl::Writer<W>* _writer;
+  // Literal suffixes and predicates written for most objects, built once.
+  const std::string _doubleSuffix;
+  const std::string _decimalSuffix;
+  const std::string _integerSuffix;
+  const std::string _wktSuffix;
+  const std::string _areaIRI;
+  const std::string _completeGeometryIRI;
+  const std::string _memberIRI;
 };
 
 }  // namespace osm2rdf::osm
@@ -0,0 +1,39 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_FIXEDGEOM_H_
+#define OSM2RDF_OSM_FIXEDGEOM_H_
+
+#include "osmium/osm/node_ref.hpp"
+#include "util/geo/Geo.h"
+
+namespace osm2rdf::osm {
+
+// Geometries are stored with osmium's fixed-point coordinates (1e-7 degrees)
+// until they are handled, and only converted to doubles for the geometry
+// algorithms. The conversion yields the same values as osmium::Location::lon()
+// and lat().
+::util::geo::I32Point toFixed(const osmium::NodeRef& nodeRef);
+::util::geo::DPoint toDouble(const ::util::geo::I32Point& point);
+::util::geo::DLine toDouble(const ::util::geo::I32Line& line);
+::util::geo::DMultiPolygon toDouble(
+    const ::util::geo::I32MultiPolygon& multiPolygon);
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_FIXEDGEOM_H_
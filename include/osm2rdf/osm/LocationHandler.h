@@ -20,13 +20,19 @@
 #define OSM2RDF_OSM_LOCATIONHANDLER_H_
 
 #include "osm2rdf/config/Config.h"
+#include "osm2rdf/osm/CompressedLocationIndex.h"
 #include "osm2rdf/osm/DenseMemIndex.h"
+#include "osm2rdf/osm/PagedDenseMemIndex.h"
+#include "osm2rdf/osm/PersistentLocationIndex.h"
+#include "osm2rdf/osm/RequiredLocationIndex.h"
 #include "osm2rdf/util/CacheFile.h"
+#include "osm2rdf/util/RankBitVector.h"
 #include "osmium/handler.hpp"
 #include "osmium/handler/node_locations_for_ways.hpp"
 #include "osmium/index/map/dense_file_array.hpp"
 #include "osmium/index/map/flex_mem.hpp"
 #include "osmium/index/map/sparse_file_array.hpp"
+#include "osmium/memory/buffer.hpp"
 #include "osmium/osm/node.hpp"
 #include "osmium/osm/relation.hpp"
 #include "osmium/osm/types.hpp"
@@ -40,6 +46,16 @@ class LocationHandler : public osmium::handler::Handler {
   virtual ~LocationHandler() {}
   virtual void node(const osmium::Node& node) = 0;
   virtual void way(osmium::Way& way) = 0;
+  // Stores all node locations of buffer and sets the locations of all way
+  // nodes in buffer, the latter in parallel using OpenMP tasks. Replaces
+  // applying this handler to buffer.
+  virtual void setLocations(osmium::memory::Buffer& buffer) = 0;
+  // Called after all nodes have been handled.
+  virtual void finalize() {}
+  // Called before the first node with the ids of all nodes referenced by ways
+  // or relations, see CountHandler::requiredNodes.
+  virtual void setRequiredNodes(
+      osm2rdf::util::RankBitVector&& /*requiredNodes*/) {}
   [[nodiscard]] virtual osmium::Location get_node_location(
       const osmium::object_id_type id) const = 0;
   // Helper creating the correct instance.
@@ -47,15 +63,20 @@ class LocationHandler : public osmium::handler::Handler {
                                  size_t nodeIdMin, size_t nodeIdMax);
 };
 
+// The implementations are final and define the per object methods inline,
+// calls through the concrete type are resolved at compile time.
 template <typename T>
-class LocationHandlerImpl : public LocationHandler {
+class LocationHandlerImpl final : public LocationHandler {
  public:
   explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
                                size_t nodeIdMin, size_t nodeIdMax);
-  void node(const osmium::Node& node);
-  void way(osmium::Way& way);
+  void node(const osmium::Node& node) final { _handler.node(node); }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
   [[nodiscard]] osmium::Location get_node_location(
-      const osmium::object_id_type nodeId) const;
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
 
  protected:
   T _index;
@@ -65,14 +86,17 @@ class LocationHandlerImpl : public LocationHandler {
 template <>
 class LocationHandlerImpl<osmium::index::map::SparseFileArray<
     osmium::unsigned_object_id_type, osmium::Location>>
-    : public LocationHandler {
+    final : public LocationHandler {
  public:
   explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
                                size_t nodeIdMin, size_t nodeIdMax);
-  void node(const osmium::Node& node);
-  void way(osmium::Way& way);
+  void node(const osmium::Node& node) final { _handler.node(node); }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
   [[nodiscard]] osmium::Location get_node_location(
-      const osmium::object_id_type nodeId) const;
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
 
  protected:
   osm2rdf::util::CacheFile _cacheFile;
@@ -87,14 +111,17 @@ class LocationHandlerImpl<osmium::index::map::SparseFileArray<
 template <>
 class LocationHandlerImpl<osmium::index::map::DenseFileArray<
     osmium::unsigned_object_id_type, osmium::Location>>
-    : public LocationHandler {
+    final : public LocationHandler {
  public:
   explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
                                size_t nodeIdMin, size_t nodeIdMax);
-  void node(const osmium::Node& node);
-  void way(osmium::Way& way);
+  void node(const osmium::Node& node) final { _handler.node(node); }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
   [[nodiscard]] osmium::Location get_node_location(
-      const osmium::object_id_type nodeId) const;
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
 
  protected:
   osm2rdf::util::CacheFile _cacheFile;
@@ -109,14 +136,17 @@ class LocationHandlerImpl<osmium::index::map::DenseFileArray<
 template <>
 class LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
     osmium::unsigned_object_id_type, osmium::Location>>
-    : public LocationHandler {
+    final : public LocationHandler {
  public:
   explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
                                size_t nodeIdMin, size_t nodeIdMax);
-  void node(const osmium::Node& node);
-  void way(osmium::Way& way);
+  void node(const osmium::Node& node) final { _handler.node(node); }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
   [[nodiscard]] osmium::Location get_node_location(
-      const osmium::object_id_type nodeId) const;
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
 
  protected:
   osm2rdf::osm::DenseMemIndex<osmium::unsigned_object_id_type, osmium::Location>
@@ -126,16 +156,118 @@ class LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
       _handler;
 };
 
+template <>
+class LocationHandlerImpl<osm2rdf::osm::PagedDenseMemIndex<
+    osmium::unsigned_object_id_type, osmium::Location>>
+    final : public LocationHandler {
+ public:
+  explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
+                               size_t nodeIdMin, size_t nodeIdMax);
+  void node(const osmium::Node& node) final { _handler.node(node); }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
+  [[nodiscard]] osmium::Location get_node_location(
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
+
+ protected:
+  osm2rdf::osm::PagedDenseMemIndex<osmium::unsigned_object_id_type,
+                                   osmium::Location>
+      _index;
+  osmium::handler::NodeLocationsForWays<osm2rdf::osm::PagedDenseMemIndex<
+      osmium::unsigned_object_id_type, osmium::Location>>
+      _handler;
+};
+
+template <>
+class LocationHandlerImpl<osm2rdf::osm::PersistentLocationIndex> final
+    : public LocationHandler {
+ public:
+  explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
+                               size_t nodeIdMin, size_t nodeIdMax);
+  void node(const osmium::Node& node) final {
+    // A reused index already contains all locations.
+    if (!_index.reused()) {
+      _handler.node(node);
+    }
+  }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
+  void finalize() final;
+  [[nodiscard]] osmium::Location get_node_location(
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
+
+ protected:
+  osm2rdf::osm::PersistentLocationIndex _index;
+  osmium::handler::NodeLocationsForWays<osm2rdf::osm::PersistentLocationIndex>
+      _handler;
+  // Clipped runs only store the nodes of the region, see ClipHandler.
+  const bool _clipped;
+};
+
+template <>
+class LocationHandlerImpl<osm2rdf::osm::CompressedLocationIndex> final
+    : public LocationHandler {
+ public:
+  explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
+                               size_t nodeIdMin, size_t nodeIdMax);
+  void node(const osmium::Node& node) final { _handler.node(node); }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
+  [[nodiscard]] osmium::Location get_node_location(
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
+
+ protected:
+  osm2rdf::osm::CompressedLocationIndex _index;
+  osmium::handler::NodeLocationsForWays<osm2rdf::osm::CompressedLocationIndex>
+      _handler;
+};
+
+template <>
+class LocationHandlerImpl<osm2rdf::osm::RequiredLocationIndex> final
+    : public LocationHandler {
+ public:
+  explicit LocationHandlerImpl(const osm2rdf::config::Config& config,
+                               size_t nodeIdMin, size_t nodeIdMax);
+  void node(const osmium::Node& node) final { _handler.node(node); }
+  void way(osmium::Way& way) final { _handler.way(way); }
+  void setLocations(osmium::memory::Buffer& buffer) final;
+  void setRequiredNodes(osm2rdf::util::RankBitVector&& requiredNodes) final;
+  [[nodiscard]] osmium::Location get_node_location(
+      const osmium::object_id_type nodeId) const final {
+    return _handler.get_node_location(nodeId);
+  }
+
+ protected:
+  osm2rdf::osm::RequiredLocationIndex _index;
+  osmium::handler::NodeLocationsForWays<osm2rdf::osm::RequiredLocationIndex>
+      _handler;
+};
+
 using LocationHandlerRAMDense = LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
     osmium::unsigned_object_id_type, osmium::Location>>;
+using LocationHandlerRAMDensePaged =
+    LocationHandlerImpl<osm2rdf::osm::PagedDenseMemIndex<
+        osmium::unsigned_object_id_type, osmium::Location>>;
 using LocationHandlerRAMFlex = LocationHandlerImpl<osmium::index::map::FlexMem<
     osmium::unsigned_object_id_type, osmium::Location>>;
+using LocationHandlerRAMCompressed =
+    LocationHandlerImpl<osm2rdf::osm::CompressedLocationIndex>;
+using LocationHandlerRAMRequired =
+    LocationHandlerImpl<osm2rdf::osm::RequiredLocationIndex>;
 using LocationHandlerFSSparse =
     LocationHandlerImpl<osmium::index::map::SparseFileArray<
         osmium::unsigned_object_id_type, osmium::Location>>;
 using LocationHandlerFSDense =
     LocationHandlerImpl<osmium::index::map::DenseFileArray<
         osmium::unsigned_object_id_type, osmium::Location>>;
+using LocationHandlerFSPersistent =
+    LocationHandlerImpl<osm2rdf::osm::PersistentLocationIndex>;
 
 }  // namespace osm2rdf::osm
 
@@ -19,6 +19,8 @@
 #ifndef OSM2RDF_OSM_NODE_H_
 #define OSM2RDF_OSM_NODE_H_
 
+#include <memory_resource>
+
 #include "osm2rdf/osm/TagList.h"
 #include "osmium/osm/node.hpp"
 #include "osmium/osm/node_ref.hpp"
@@ -30,7 +32,9 @@ class Node {
  public:
   typedef uint64_t id_t;
   explicit Node();
-  explicit Node(const osmium::Node& node);
+  explicit Node(
+      const osmium::Node& node,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
   explicit Node(const osmium::NodeRef& nodeRef);
   [[nodiscard]] id_t id() const noexcept;
   [[nodiscard]] std::time_t timestamp() const noexcept;
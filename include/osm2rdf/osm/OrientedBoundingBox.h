@@ -0,0 +1,35 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_ORIENTEDBOUNDINGBOX_H_
+#define OSM2RDF_OSM_ORIENTEDBOUNDINGBOX_H_
+
+#include "util/geo/Geo.h"
+
+namespace osm2rdf::osm {
+
+// Returns the minimum-area rectangle enclosing the given convex hull. One side
+// of this rectangle is collinear with a hull edge, all edges are checked with
+// rotating calipers in time linear in the hull size. Returns an empty polygon
+// if the hull has less than three distinct vertices, callers fall back to
+// ::util::geo::getOrientedEnvelope in this case.
+::util::geo::DPolygon orientedBoundingBox(const ::util::geo::DPolygon& hull);
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_ORIENTEDBOUNDINGBOX_H_
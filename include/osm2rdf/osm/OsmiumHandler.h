@@ -20,11 +20,31 @@
 #ifndef OSM2RDF_OSM_OSMIUMHANDLER_H
 #define OSM2RDF_OSM_OSMIUMHANDLER_H
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
 #include "osm2rdf/config/Config.h"
+#include "osm2rdf/osm/Area.h"
+#include "osm2rdf/osm/AreaManager.h"
+#include "osm2rdf/osm/CountHandler.h"
 #include "osm2rdf/osm/FactHandler.h"
 #include "osm2rdf/osm/GeometryHandler.h"
+#include "osm2rdf/osm/LocationHandler.h"
+#include "osm2rdf/osm/Node.h"
+#include "osm2rdf/osm/Relation.h"
+#include "osm2rdf/osm/RelationHandler.h"
+#include "osm2rdf/osm/Snapshot.h"
+#include "osm2rdf/osm/TagFilter.h"
+#include "osm2rdf/osm/Way.h"
 #include "osm2rdf/ttl/Writer.h"
 #include "osm2rdf/util/ProgressBar.h"
+#include "osm2rdf/util/TaskLimiter.h"
+#include "osm2rdf/util/ThreadCounters.h"
+#include "osmium/area/assembler.hpp"
 #include "osmium/handler.hpp"
 #include "osmium/osm/area.hpp"
 #include "osmium/osm/node.hpp"
@@ -33,17 +53,28 @@
 
 namespace osm2rdf::osm {
 
-template <typename W>
+const static inline std::chrono::milliseconds PROGRESS_REPORT_INTERVAL{100};
+
+// L is the type of the location handler used in the second pass, see
+// RelationHandler.
+template <typename W, typename L = osm2rdf::osm::LocationHandler>
 class OsmiumHandler : public osmium::handler::Handler {
  public:
   OsmiumHandler(const osm2rdf::config::Config& config,
                 osm2rdf::osm::FactHandler<W>* factHandler,
                 osm2rdf::osm::GeometryHandler<W>* geomHandler);
+  ~OsmiumHandler();
   void handle();
   void area(const osmium::Area& area);
   void node(const osmium::Node& node);
   void relation(const osmium::Relation& relation);
   void way(const osmium::Way& way);
+  // Applies this handler to the given buffer and keeps it alive until all
+  // tasks for objects read from it are done.
+  void handleBuffer(osmium::memory::Buffer&& buffer);
+  // Spawns tasks for all collected objects, called by osmium::apply after
+  // each buffer.
+  void flush();
 
   [[nodiscard]] size_t areasSeen() const;
   [[nodiscard]] size_t areasDumped() const;
@@ -59,26 +90,80 @@ class OsmiumHandler : public osmium::handler::Handler {
   [[nodiscard]] size_t wayGeometriesHandled() const;
 
  protected:
+  // Spawn one task for all collected objects of the given type.
+  void flushAreas();
+  void flushNodes();
+  void flushRelations();
+  void flushWays();
+  // Periodically updates the progress bar from a separate thread.
+  void startProgressReporter();
+  void stopProgressReporter();
+  // Registers a read object and pauses reading once the in-flight limits
+  // are reached, until enough batches are done, see TaskLimiter.
+  void throttle(size_t bytes);
+  // First pass over PBF input using a PbfBlobIndex: counts all blobs in
+  // parallel, only scanning node blobs, then handles the relation blobs in
+  // input order. Shard workers decode node blobs spanning several shards.
+  void countBlobs(osm2rdf::osm::CountHandler* countHandler,
+                  osm2rdf::osm::AreaManager* mpManager,
+                  osm2rdf::osm::Snapshot* snapshot);
+
   osm2rdf::config::Config _config;
   osm2rdf::osm::FactHandler<W>* _factHandler;
   osm2rdf::osm::GeometryHandler<W>* _geometryHandler;
 
-  osm2rdf::osm::RelationHandler _relationHandler;
+  osm2rdf::osm::RelationHandler<L> _relationHandler;
+  osm2rdf::osm::TagFilter _tagFilter;
   osm2rdf::util::ProgressBar _progressBar;
+  osm2rdf::util::TaskLimiter _taskLimiter;
+  // Only modified by the reading thread.
   size_t _areasSeen = 0;
-  size_t _areasDumped = 0;
-  size_t _areaGeometriesHandled = 0;
   size_t _nodesSeen = 0;
-  size_t _nodesDumped = 0;
-  size_t _nodeGeometriesHandled = 0;
   size_t _relationsSeen = 0;
-  size_t _relationsDumped = 0;
-  size_t _relationGeometriesHandled = 0;
   size_t _waysSeen = 0;
-  size_t _waysDumped = 0;
-  size_t _wayGeometriesHandled = 0;
 
-  size_t _numTasksDone = 0;
+  // Modified by all worker threads.
+  enum Counter : size_t {
+    AREAS_DUMPED,
+    AREA_GEOMETRIES_HANDLED,
+    NODES_DUMPED,
+    NODE_GEOMETRIES_HANDLED,
+    RELATIONS_DUMPED,
+    RELATION_GEOMETRIES_HANDLED,
+    WAYS_DUMPED,
+    WAY_GEOMETRIES_HANDLED,
+    TASKS_DONE,
+    NUM_COUNTERS
+  };
+  osm2rdf::util::ThreadCounters _counters;
+  std::thread _reporter;
+  std::atomic<bool> _reporterRunning{false};
+
+  // Converted objects waiting to be processed in a single task. The objects
+  // and their tag and member lists are allocated from the batch's arena,
+  // which is released at once when the task deletes the batch.
+  template <typename T>
+  struct Batch {
+    explicit Batch(size_t size)
+        : arena(2 * size * sizeof(T)), objects(&arena) {
+      objects.reserve(size);
+    }
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<T> objects;
+    // Size of the osmium objects, see TaskLimiter.
+    size_t bytes = 0;
+    // Buffers the objects point into, see _pinnedBuffers.
+    std::vector<std::shared_ptr<osmium::memory::Buffer>> pins;
+  };
+  std::vector<osm2rdf::osm::Area> _areaBatch;
+  size_t _areaBatchBytes = 0;
+  std::unique_ptr<Batch<osm2rdf::osm::Node>> _nodeBatch;
+  std::unique_ptr<Batch<osm2rdf::osm::Relation>> _relationBatch;
+  std::unique_ptr<Batch<osm2rdf::osm::Way>> _wayBatch;
+  // Buffers currently handled by the reading thread. Nodes, ways and
+  // relations only hold views on their tags, members and way nodes, each
+  // batch keeps a reference on these buffers until its task is done.
+  std::vector<std::shared_ptr<osmium::memory::Buffer>> _pinnedBuffers;
 };
 }  // namespace osm2rdf::osm
 
@@ -0,0 +1,68 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_PAGEDDENSEMEMINDEX_H
+#define OSM2RDF_OSM_PAGEDDENSEMEMINDEX_H
+
+#include <memory>
+#include <vector>
+
+#include <osmium/index/index.hpp>
+#include <osmium/index/map.hpp>
+
+namespace osm2rdf::osm {
+
+// Variant of DenseMemIndex which splits the id range into pages of
+// kPageSize ids. Pages are allocated on the first write into them, memory
+// usage is proportional to the number of distinct pages written instead of
+// the size of the id range.
+template <typename TId, typename TValue>
+class PagedDenseMemIndex : public osmium::index::map::Map<TId, TValue> {
+ public:
+  static constexpr size_t kPageBits = 16;
+  static constexpr size_t kPageSize = 1 << kPageBits;
+
+  explicit PagedDenseMemIndex(size_t minNodeId, size_t maxNodeId);
+
+  size_t size() const noexcept final { return _size; }
+
+  size_t used_memory() const noexcept final {
+    return sizeof(PagedDenseMemIndex) +
+           _pages.size() * sizeof(std::unique_ptr<TValue[]>) +
+           _numPages * kPageSize * sizeof(TValue);
+  }
+
+  void set(const TId id, const TValue value) final;
+
+  TValue get_noexcept(const TId id) const noexcept final;
+
+  TValue get(const TId id) const final;
+
+  void clear() final;
+
+  void sort() final{};
+
+ private:
+  size_t _offset;
+  size_t _size;
+  size_t _numPages = 0;
+  std::vector<std::unique_ptr<TValue[]>> _pages;
+};
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_PAGEDDENSEMEMINDEX_H
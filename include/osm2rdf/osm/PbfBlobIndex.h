@@ -0,0 +1,119 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_PBFBLOBINDEX_H
+#define OSM2RDF_OSM_PBFBLOBINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "osmium/handler.hpp"
+#include "osmium/io/detail/pbf_decoder.hpp"
+#include "osmium/io/file.hpp"
+#include "osmium/osm/entity_bits.hpp"
+#include "osmium/osm/object.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+// Position and content summary of a single OSMData blob of a PBF file.
+struct PbfBlob {
+  // Offset of the blob in the file, starting with the length of its header.
+  uint64_t offset = 0;
+  // Size of the length, the header and the data.
+  uint64_t size = 0;
+  // Types and id range of the objects in the blob, only known after the blob
+  // was decoded with apply.
+  osmium::osm_entity_bits::type entities = osmium::osm_entity_bits::nothing;
+  uint64_t minId = std::numeric_limits<uint64_t>::max();
+  uint64_t maxId = 0;
+};
+
+// Nodes of a single blob, collected without decoding them.
+struct PbfNodeSummary {
+  uint64_t numNodes = 0;
+  uint64_t numTaggedNodes = 0;
+  uint64_t minId = std::numeric_limits<uint64_t>::max();
+  uint64_t maxId = 0;
+};
+
+// Index of all blobs of a PBF file, built by only reading the blob headers.
+// Each blob can be decoded on its own, allowing multiple threads to decode
+// different blobs.
+class PbfBlobIndex {
+ public:
+  explicit PbfBlobIndex(const std::filesystem::path& path);
+  ~PbfBlobIndex();
+  PbfBlobIndex(const PbfBlobIndex&) = delete;
+  PbfBlobIndex& operator=(const PbfBlobIndex&) = delete;
+
+  [[nodiscard]] size_t numBlobs() const noexcept { return _blobs.size(); }
+  [[nodiscard]] const PbfBlob& blob(size_t index) const {
+    return _blobs.at(index);
+  }
+  // Returns a complete PBF file consisting of the file header and the blob
+  // with the given index. Thread-safe.
+  [[nodiscard]] std::string read(size_t index) const;
+  // Returns the Blob message of the blob with the given index, without its
+  // length and header. Thread-safe.
+  [[nodiscard]] std::string readBlob(size_t index) const;
+
+  // Records types and ids of the objects in the blob with the given index and
+  // summarizes its nodes by only walking the protobuf messages, without
+  // building any objects. Returns false if the blob uses a compression other
+  // than zlib, in which case it needs to be decoded with apply. Thread-safe
+  // for different blobs.
+  bool scan(size_t index, PbfNodeSummary* nodes);
+
+  // Decodes the objects of the given types in the blob with the given index
+  // in the calling thread and applies all handlers to them. Records the types
+  // and ids of all objects in the blob. Thread-safe for different blobs.
+  template <typename... THandlers>
+  void apply(size_t index, osmium::osm_entity_bits::type types,
+             THandlers&... handlers) {
+    osmium::io::detail::PBFDataBlobDecoder decoder{
+        readBlob(index), types, osmium::io::read_meta::yes};
+    auto buffer = decoder();
+    auto& blob = _blobs.at(index);
+    for (const auto& object : buffer.select<osmium::OSMObject>()) {
+      blob.entities |= osmium::osm_entity_bits::from_item_type(object.type());
+      blob.minId = std::min(blob.minId, object.positive_id());
+      blob.maxId = std::max(blob.maxId, object.positive_id());
+    }
+    osmium::apply(buffer, handlers...);
+  }
+
+ protected:
+  // Reads size bytes at offset, throws if the file is too short.
+  void readAt(uint64_t offset, char* data, size_t size) const;
+
+  std::filesystem::path _path;
+  int _fileDescriptor = -1;
+  // Complete OSMHeader blob including its length.
+  std::string _header;
+  std::vector<PbfBlob> _blobs;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_PBFBLOBINDEX_H
@@ -0,0 +1,106 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_PERSISTENTLOCATIONINDEX_H
+#define OSM2RDF_OSM_PERSISTENTLOCATIONINDEX_H
+
+#include <cstdint>
+#include <filesystem>
+
+#include "osmium/index/index.hpp"
+#include "osmium/index/map.hpp"
+#include "osmium/osm/location.hpp"
+#include "osmium/osm/types.hpp"
+
+namespace osm2rdf::osm {
+
+// Bump whenever the on-disk layout changes.
+const static uint32_t PERSISTENT_LOCATION_INDEX_VERSION = 1;
+
+// Dense node location index stored in a memory mapped file which is kept
+// after the run. The file header records the fingerprint of the input and the
+// node id range. If a complete index for the same input exists, it is mapped
+// read-only and no locations have to be stored again. Updates open an
+// existing complete index writable and advance it, see UpdateState.
+class PersistentLocationIndex final
+    : public osmium::index::map::Map<osmium::unsigned_object_id_type,
+                                     osmium::Location> {
+ public:
+  PersistentLocationIndex(const std::filesystem::path& path,
+                          uint64_t fingerprint, size_t minNodeId,
+                          size_t maxNodeId);
+  // Opens the existing complete index at path writable, throws if there is
+  // none.
+  explicit PersistentLocationIndex(const std::filesystem::path& path);
+  ~PersistentLocationIndex();
+
+  // True if an existing complete index was opened.
+  [[nodiscard]] bool reused() const noexcept { return _reused; }
+  // Marks the index as complete, later runs can reuse it.
+  void markComplete();
+  // Fingerprint of the data the locations belong to.
+  [[nodiscard]] uint64_t fingerprint() const noexcept;
+  // Persists all locations and replaces the fingerprint, only runs over data
+  // with the new fingerprint reuse the index afterwards.
+  void setFingerprint(uint64_t fingerprint);
+  // Grows the index to hold locations up to maxNodeId.
+  void reserve(size_t maxNodeId);
+
+  size_t size() const noexcept final { return _size; }
+  size_t used_memory() const noexcept final { return 0; }
+
+  void set(const osmium::unsigned_object_id_type id,
+           const osmium::Location value) final;
+  osmium::Location get_noexcept(
+      const osmium::unsigned_object_id_type id) const noexcept final;
+  osmium::Location get(const osmium::unsigned_object_id_type id) const final;
+
+  void clear() final;
+  void sort() final {}
+
+ protected:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t complete;
+    uint64_t fingerprint;
+    uint64_t minNodeId;
+    uint64_t maxNodeId;
+  };
+  // Locations start at a page boundary.
+  static const size_t kHeaderSize = 4096;
+
+  bool open(uint64_t fingerprint);
+  void create(uint64_t fingerprint);
+  void map(bool writable);
+
+  std::filesystem::path _path;
+  size_t _offset;
+  size_t _size;
+  int _fileDescriptor = -1;
+  void* _mapping = nullptr;
+  size_t _mappingSize = 0;
+  // Coordinates are stored xor'ed with the undefined coordinate, so unset
+  // (zero) entries of the sparse file read as invalid locations.
+  int32_t* _data = nullptr;
+  bool _reused = false;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_PERSISTENTLOCATIONINDEX_H
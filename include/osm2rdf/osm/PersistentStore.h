@@ -0,0 +1,77 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_PERSISTENTSTORE_H
+#define OSM2RDF_OSM_PERSISTENTSTORE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace osm2rdf::osm {
+
+// Maps ids to byte strings in two files kept after the run: a dense index of
+// record offsets, memory mapped and grown on demand, and an append-only data
+// file. Replacing a value appends a new record, the space of the old one is
+// not reclaimed. Appending to a value links a new record to the earlier ones
+// of the same id.
+class PersistentStore {
+ public:
+  // Opens the store at path, creates an empty one if create is true.
+  PersistentStore(const std::filesystem::path& path, bool create);
+  ~PersistentStore();
+  PersistentStore(const PersistentStore&) = delete;
+  PersistentStore& operator=(const PersistentStore&) = delete;
+
+  // Sets value to all records of id, newest first. Returns false if nothing
+  // is stored for id.
+  bool get(uint64_t id, std::string* value) const;
+  void put(uint64_t id, std::string_view value);
+  void append(uint64_t id, std::string_view value);
+  void erase(uint64_t id);
+  // Writes buffered records and the index to disk.
+  void sync();
+
+ protected:
+  struct RecordHeader {
+    // Offset of the previous record of the same id plus one, zero if none.
+    uint64_t previous;
+    uint64_t size;
+  };
+
+  void write(uint64_t id, std::string_view value, uint64_t previous);
+  void read(uint64_t offset, void* data, size_t size) const;
+  void reserve(uint64_t id);
+  void map(size_t size);
+  void flush();
+
+  std::filesystem::path _path;
+  int _indexFile = -1;
+  int _dataFile = -1;
+  // Record offset plus one for each id, zero if nothing is stored.
+  uint64_t* _index = nullptr;
+  size_t _indexSize = 0;
+  // Size of the data file, later records are still in _pending.
+  uint64_t _dataSize = 0;
+  std::string _pending;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_PERSISTENTSTORE_H
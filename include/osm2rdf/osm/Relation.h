@@ -19,6 +19,7 @@
 #ifndef OSM2RDF_OSM_RELATION_H_
 #define OSM2RDF_OSM_RELATION_H_
 
+#include <memory_resource>
 #include <vector>
 
 #include "RelationHandler.h"
@@ -35,22 +36,27 @@ class Relation {
  public:
   typedef uint32_t id_t;
   Relation();
-  explicit Relation(const osmium::Relation& relation);
+  explicit Relation(
+      const osmium::Relation& relation,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
   [[nodiscard]] id_t id() const noexcept;
   [[nodiscard]] std::time_t timestamp() const noexcept;
-  [[nodiscard]] const std::vector<osm2rdf::osm::RelationMember>& members()
-      const noexcept;
+  [[nodiscard]] const std::pmr::vector<osm2rdf::osm::RelationMember>&
+  members() const noexcept;
   [[nodiscard]] const osm2rdf::osm::TagList& tags() const noexcept;
   [[nodiscard]] bool hasCompleteGeometry() const noexcept;
   [[nodiscard]] bool isArea() const noexcept;
   [[nodiscard]] bool hasGeometry() const noexcept;
   [[nodiscard]] const ::util::geo::DBox& envelope() const noexcept;
   [[nodiscard]] const ::util::geo::DCollection& geom() const noexcept;
+  // Length of geom(), computed with the centroid in buildGeometry.
+  [[nodiscard]] double length() const noexcept;
   [[nodiscard]] const ::util::geo::DPolygon& convexHull() const noexcept;
   [[nodiscard]] const ::util::geo::DPolygon& orientedBoundingBox()
       const noexcept;
   [[nodiscard]] const ::util::geo::DPoint centroid() const noexcept;
-  void buildGeometry(osm2rdf::osm::RelationHandler& relationHandler);
+  template <typename L>
+  void buildGeometry(osm2rdf::osm::RelationHandler<L>& relationHandler);
 
   bool operator==(const osm2rdf::osm::Relation& other) const noexcept;
   bool operator!=(const osm2rdf::osm::Relation& other) const noexcept;
@@ -58,10 +64,12 @@ class Relation {
  protected:
   id_t _id;
   std::time_t _timestamp;
-  std::vector<osm2rdf::osm::RelationMember> _members;
+  std::pmr::vector<osm2rdf::osm::RelationMember> _members;
   osm2rdf::osm::TagList _tags;
   ::util::geo::DBox _envelope;
   ::util::geo::DCollection _geom;
+  double _length = 0;
+  ::util::geo::DPoint _centroid;
   ::util::geo::DPolygon _convexHull;
   ::util::geo::DPolygon _obb;
   bool _hasCompleteGeometry;
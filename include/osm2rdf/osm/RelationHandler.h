@@ -19,31 +19,100 @@
 #ifndef OSM2RDF_OSM_RELATIONHANDLER_H
 #define OSM2RDF_OSM_RELATIONHANDLER_H
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "osm2rdf/config/Config.h"
 #include "osm2rdf/osm/LocationHandler.h"
+#include "osm2rdf/osm/RelationMember.h"
+#include "osm2rdf/util/DirectedGraph.h"
+#include "util/geo/Geo.h"
 
 namespace osm2rdf::osm {
 
+// L is the type of the used location handler. Using one of the final
+// LocationHandlerImpl types avoids virtual calls for each node lookup.
+template <typename L = osm2rdf::osm::LocationHandler>
 class RelationHandler : public osmium::handler::Handler {
  public:
   explicit RelationHandler(const osm2rdf::config::Config& config);
   void relation(const osmium::Relation& relation);
   void way(const osmium::Way& way);
   void prepare_for_lookup();
-  void setLocationHandler(osm2rdf::osm::LocationHandler* locationHandler);
+  void setLocationHandler(L* locationHandler);
   bool hasLocationHandler() const;
-  osmium::Location get_node_location(const uint64_t nodeId) const;
-  std::vector<uint64_t> get_noderefs_of_way(const uint64_t wayId);
+  osmium::Location get_node_location(const uint64_t nodeId) const {
+    return _locationHandler->get_node_location(nodeId);
+  }
+  // Looks up the locations of all nodeIds, (*locations)[i] is the location of
+  // nodeIds[i]. Each distinct id is looked up once and in ascending order,
+  // improving the locality of accesses to the location index.
+  void get_node_locations(const std::vector<uint64_t>& nodeIds,
+                          std::vector<osmium::Location>* locations) const;
+  std::vector<uint64_t> get_noderefs_of_way(const uint64_t wayId) const;
+  // Builds the geometry of the given members, see packMember, into geom.
+  // Returns false if the geometry of any member is missing or incomplete.
+  // Relation members use the geometries built by buildNestedGeometries, for
+  // area relations these are the lines of their member ways.
+  bool buildMemberGeometry(const std::vector<uint64_t>& members,
+                           ::util::geo::DCollection* geom) const;
+  // Builds and stores the geometries of all relations which are members of
+  // other relations, children before their parents. Called for the first
+  // relation of the second pass, all ways and nodes are known at this point.
+  // Reading pauses meanwhile, the relations of each level are built in
+  // parallel tasks.
+  void buildNestedGeometries();
+
+  // Compact representation of a relation member: id and member type.
+  static uint64_t packMember(osm2rdf::osm::RelationMemberType type,
+                             uint64_t id) {
+    return (id << 2) | static_cast<uint8_t>(type);
+  }
 
  private:
-  std::vector<uint32_t> getCompressedIDs(const osmium::Way& way) const;
-  std::vector<uint64_t> getNodeRefs(const std::vector<uint32_t>& refs) const;
+  // Position of relationId in _relationIds, _relationIds.size() if the
+  // relation is not a member of another relation.
+  size_t relationIndex(const uint64_t relationId) const;
+  // Position of wayId in _wayIds, _wayIds.size() if the way is not needed.
+  size_t wayIndex(const uint64_t wayId) const;
+  // Returns space for size bytes in the arena.
+  uint8_t* allocate(size_t size);
 
  protected:
   osm2rdf::config::Config _config;
-  osm2rdf::osm::LocationHandler* _locationHandler = nullptr;
-  std::unordered_map<uint32_t, std::vector<uint32_t>> _ways32;
-  std::unordered_map<uint64_t, std::vector<uint32_t>> _ways64;
+  L* _locationHandler = nullptr;
+  // Ids of ways referenced by relations, sorted and unique after the first
+  // pass.
+  std::vector<uint64_t> _wayIds;
+  // Start of the encoded node refs for each way in _wayIds, nullptr for ways
+  // not seen yet. Each list is stored as its length followed by the zigzag
+  // encoded deltas between consecutive node ids, all as varints.
+  std::vector<const uint8_t*> _wayNodeRefs;
+  // Append-only arena holding the encoded node refs, chunks never move.
+  std::vector<std::unique_ptr<uint8_t[]>> _chunks;
+  size_t _chunkSize = 0;
+  // Ids of relations, after the first pass only those which are members of
+  // other relations, sorted.
+  std::vector<uint64_t> _relationIds;
+  // Packed members of each relation in _relationIds, the members of the i-th
+  // relation start at _relationMembersBegin[i]. Area relations only keep
+  // their way members.
+  std::vector<size_t> _relationMembersBegin;
+  std::vector<uint64_t> _relationMembers;
+  // Edges from non-area relations to their relation members.
+  osm2rdf::util::DirectedGraph<uint64_t> _relationGraph;
+  // Relations in _relationIds ordered by level, excluding relations on or
+  // depending on membership cycles.
+  std::vector<uint64_t> _nestedOrder;
+  // The relations of level i are _nestedOrder[_nestedLevelsBegin[i]] up to
+  // _nestedOrder[_nestedLevelsBegin[i + 1]], members are on lower levels.
+  std::vector<size_t> _nestedLevelsBegin;
+  // Geometry of each relation in _relationIds and if it is complete.
+  std::vector<::util::geo::DCollection> _nestedGeoms;
+  std::vector<uint8_t> _nestedComplete;
+  bool _nestedGeometriesBuilt = false;
+  size_t _chunkUsed = 0;
   bool _firstPassDone = false;
 };
 }
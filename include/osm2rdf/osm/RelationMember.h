@@ -19,7 +19,7 @@
 #ifndef OSM2RDF_OSM_RELATIONMEMBER_H_
 #define OSM2RDF_OSM_RELATIONMEMBER_H_
 
-#include <string>
+#include <string_view>
 
 #include "osmium/osm/relation.hpp"
 
@@ -33,7 +33,8 @@ class RelationMember {
   RelationMember();
   explicit RelationMember(const osmium::RelationMember& relationMember);
   [[nodiscard]] id_t id() const noexcept;
-  [[nodiscard]] std::string role() const noexcept;
+  // Points into the osmium buffer the member was read from.
+  [[nodiscard]] std::string_view role() const noexcept;
   [[nodiscard]] osm2rdf::osm::RelationMemberType type() const noexcept;
 
   bool operator==(const osm2rdf::osm::RelationMember& other) const noexcept;
@@ -41,7 +42,7 @@ class RelationMember {
 
  protected:
   id_t _id;
-  std::string _role;
+  std::string_view _role;
   osm2rdf::osm::RelationMemberType _type;
 };
 
@@ -0,0 +1,64 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_REQUIREDLOCATIONINDEX_H
+#define OSM2RDF_OSM_REQUIREDLOCATIONINDEX_H
+
+#include <vector>
+
+#include "osm2rdf/util/RankBitVector.h"
+#include "osmium/index/index.hpp"
+#include "osmium/index/map.hpp"
+#include "osmium/osm/location.hpp"
+#include "osmium/osm/types.hpp"
+
+namespace osm2rdf::osm {
+
+// In-memory node location index only storing the locations of nodes
+// referenced by ways or relations. The referenced ids are collected in the
+// first pass into a bit vector, a location is stored at the rank of its id.
+// Locations of all other nodes are dropped.
+class RequiredLocationIndex final
+    : public osmium::index::map::Map<osmium::unsigned_object_id_type,
+                                     osmium::Location> {
+ public:
+  RequiredLocationIndex() = default;
+
+  // Replaces the set of stored ids, drops all stored locations.
+  void setRequiredNodes(osm2rdf::util::RankBitVector&& requiredNodes);
+
+  size_t size() const noexcept final { return _locations.size(); }
+  size_t used_memory() const noexcept final;
+
+  void set(const osmium::unsigned_object_id_type id,
+           const osmium::Location value) final;
+  osmium::Location get_noexcept(
+      const osmium::unsigned_object_id_type id) const noexcept final;
+  osmium::Location get(const osmium::unsigned_object_id_type id) const final;
+
+  void clear() final;
+  void sort() final {}
+
+ protected:
+  osm2rdf::util::RankBitVector _requiredNodes;
+  std::vector<osmium::Location> _locations;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_REQUIREDLOCATIONINDEX_H
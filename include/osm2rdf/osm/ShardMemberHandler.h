@@ -0,0 +1,69 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_SHARDMEMBERHANDLER_H
+#define OSM2RDF_OSM_SHARDMEMBERHANDLER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "osm2rdf/config/Config.h"
+#include "osm2rdf/util/DirectedGraph.h"
+#include "osmium/handler.hpp"
+#include "osmium/osm/relation.hpp"
+
+namespace osm2rdf::osm {
+
+// Collects the members of the relations converted by a shard worker before
+// its first pass. Besides the relations in its shard, a worker needs the
+// members of relations outside its shard which are, possibly indirectly,
+// members of these. Such relations are only known after all relations were
+// seen, their member ways are collected in a second pass over the relations.
+class ShardMemberHandler : public osmium::handler::Handler {
+ public:
+  explicit ShardMemberHandler(const osm2rdf::config::Config& config);
+  void relation(const osmium::Relation& relation);
+  // Ends a pass over all relations.
+  void prepare_for_lookup();
+  // Returns true if no further pass over the relations is needed.
+  [[nodiscard]] bool done() const;
+
+  // Relations outside the shard which are members of relations in the shard
+  // or of other such relations, sorted.
+  std::vector<uint64_t>& relationIds() { return _relationIds; }
+  // Ways which are members of relations in the shard or in relationIds,
+  // sorted and unique once done.
+  std::vector<uint64_t>& wayIds() { return _wayIds; }
+
+ protected:
+  void addWays(const osmium::Relation& relation);
+
+  osm2rdf::config::Config _config;
+  size_t _passes = 0;
+  bool _done = false;
+  // Relations in the shard with relation members.
+  std::vector<uint64_t> _parentIds;
+  // Edges from all relations to their relation members.
+  osm2rdf::util::DirectedGraph<uint64_t> _relationGraph;
+  std::vector<uint64_t> _relationIds;
+  std::vector<uint64_t> _wayIds;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_SHARDMEMBERHANDLER_H
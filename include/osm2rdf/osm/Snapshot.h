@@ -0,0 +1,80 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_SNAPSHOT_H
+#define OSM2RDF_OSM_SNAPSHOT_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "osm2rdf/config/Config.h"
+#include "osm2rdf/osm/CountHandler.h"
+#include "osmium/handler.hpp"
+#include "osmium/io/writer.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/relation.hpp"
+
+namespace osm2rdf::osm {
+
+// Bump whenever the on-disk layout or the meaning of the stored data changes.
+const static uint32_t SNAPSHOT_VERSION = 2;
+
+// Persists the results of the first OSM pass (object counts, node id range,
+// required nodes and all relations) in the cache directory. Later runs over
+// the same input with a compatible config restore the counts and replay the
+// stored relations into the RelationHandler and MultipolygonManager instead
+// of decoding the whole input again.
+class Snapshot : public osmium::handler::Handler {
+ public:
+  explicit Snapshot(const osm2rdf::config::Config& config);
+  ~Snapshot();
+
+  // Restores the counts into countHandler. Returns false if no matching
+  // snapshot exists.
+  bool load(osm2rdf::osm::CountHandler* countHandler) const;
+  // Starts recording relations for a new snapshot.
+  void startRecording();
+  // Collects relations while recording.
+  void relation(const osmium::Relation& relation);
+  // Writes the header with the counts of countHandler and publishes the
+  // snapshot.
+  void store(osm2rdf::osm::CountHandler& countHandler);
+
+  // Identifies input file and relevant config options.
+  [[nodiscard]] uint64_t key() const noexcept;
+  [[nodiscard]] std::filesystem::path headerPath() const;
+  [[nodiscard]] std::filesystem::path relationsPath() const;
+
+  // Cheap fingerprint of a file: size, modification time and the content of
+  // the first and last block.
+  static uint64_t fingerprint(const std::filesystem::path& path);
+
+ protected:
+  void flushBuffer();
+
+  osm2rdf::config::Config _config;
+  uint64_t _key;
+  bool _recording = false;
+  osmium::memory::Buffer _buffer;
+  std::unique_ptr<osmium::io::Writer> _writer;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_SNAPSHOT_H
@@ -19,12 +19,14 @@
 #ifndef OSM2RDF_OSM_TAG_H_
 #define OSM2RDF_OSM_TAG_H_
 
-#include <string>
+#include <string_view>
 #include <utility>
 
 namespace osm2rdf::osm {
 
-typedef std::pair<std::string, std::string> Tag;
+// Key and value of a tag, both point into the osmium buffer the tag was read
+// from.
+typedef std::pair<std::string_view, std::string_view> Tag;
 
 }  // namespace osm2rdf::osm
 
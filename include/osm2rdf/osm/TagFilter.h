@@ -0,0 +1,60 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_TAGFILTER_H_
+#define OSM2RDF_OSM_TAGFILTER_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "osmium/tags/taglist.hpp"
+
+namespace osm2rdf::osm {
+
+// Compiled tag filter expression evaluated directly on osmium tag lists.
+// An expression is a list of terms separated by ",", matching if any term
+// matches. A term is a list of conditions separated by "&", matching if all
+// conditions match. A condition is "key" or "key=*" for any value or
+// "key=a|b" for one of the given values, a leading "!" negates it.
+// Example: "highway=*,boundary=administrative&admin_level=2|4"
+class TagFilter {
+ public:
+  // Parses expression, an empty expression matches everything. Throws
+  // std::invalid_argument for malformed expressions.
+  explicit TagFilter(std::string_view expression);
+
+  [[nodiscard]] bool matches(const osmium::TagList& tags) const noexcept;
+  [[nodiscard]] bool empty() const noexcept { return _terms.empty(); }
+
+ protected:
+  struct Condition {
+    std::string key;
+    // Empty for any value.
+    std::vector<std::string> values;
+    bool negated = false;
+  };
+  [[nodiscard]] static bool matches(const Condition& condition,
+                                    const osmium::TagList& tags) noexcept;
+
+  std::vector<std::vector<Condition>> _terms;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_TAGFILTER_H_
@@ -19,17 +19,22 @@
 #ifndef OSM2RDF_OSM_TAGLIST_H_
 #define OSM2RDF_OSM_TAGLIST_H_
 
-#include <string>
-#include <map>
+#include <memory_resource>
+#include <vector>
 
+#include "osm2rdf/osm/Tag.h"
 #include "osmium/tags/taglist.hpp"
 
 namespace osm2rdf::osm {
 
-typedef std::vector<std::pair<std::string, std::string>> TagList;
+typedef std::pmr::vector<osm2rdf::osm::Tag> TagList;
 
-// Convert an osmium::TagList into a osm2rdf::osm::TagList
-osm2rdf::osm::TagList convertTagList(const osmium::TagList& tagList);
+// Convert an osmium::TagList into a osm2rdf::osm::TagList allocated from the
+// given resource. The result points into the buffer holding tagList and is
+// only valid as long as it is alive.
+osm2rdf::osm::TagList convertTagList(
+    const osmium::TagList& tagList,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 }  // namespace osm2rdf::osm
 
@@ -0,0 +1,119 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_UPDATEHANDLER_H_
+#define OSM2RDF_OSM_UPDATEHANDLER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "osm2rdf/config/Config.h"
+#include "osm2rdf/osm/FactHandler.h"
+#include "osm2rdf/osm/LocationHandler.h"
+#include "osm2rdf/osm/TagFilter.h"
+#include "osm2rdf/osm/UpdateState.h"
+#include "osm2rdf/ttl/Writer.h"
+#include "osm2rdf/util/Output.h"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/object.hpp"
+
+namespace osm2rdf::osm {
+
+// Writes the changes of the output caused by an OSM change file as a SPARQL
+// Update. The UpdateState written by the full run and advanced by earlier
+// updates provides way node lists, relation members and node locations of
+// unchanged objects whose geometry changes through their members. All facts
+// of changed, deleted and affected objects are deleted, then the facts of
+// their current version are inserted and the state is advanced. Geometric
+// relations are not updated, the target has to be written without them.
+template <typename W>
+class UpdateHandler {
+ public:
+  UpdateHandler(const osm2rdf::config::Config& config,
+                osm2rdf::osm::FactHandler<W>* factHandler,
+                osm2rdf::ttl::Writer<W>* writer,
+                osm2rdf::util::Output* output);
+  void handle();
+
+  [[nodiscard]] size_t numChanged() const noexcept;
+  [[nodiscard]] size_t numAffected() const noexcept;
+
+ protected:
+  // Reads the change file, later versions of an object replace earlier ones.
+  void readChanges();
+  // Copies the unchanged ways and relations whose geometry depends on
+  // changed objects from the state.
+  void readAffected();
+  // Copies the unchanged relations and ways needed to build the geometries
+  // of all updated relations from the state.
+  void readMembers();
+  // Stores the locations of all nodes of the updated and member ways.
+  void readLocations(osm2rdf::osm::LocationHandlerRAMFlex* locationHandler);
+  void writeDeletes();
+  void writeInserts(osm2rdf::osm::LocationHandlerRAMFlex* locationHandler);
+  // Writes a statement deleting all facts of subject, including blank nodes
+  // and geometry objects only used by it.
+  void writeDelete(const std::string& subject);
+  // Applies all changes to the state.
+  void writeState();
+
+  // Returns true if the current version of the object is output.
+  [[nodiscard]] bool isOutput(const osmium::OSMObject& object) const noexcept;
+  // Returns the current version of a way or relation, nullptr if it was
+  // deleted or is unknown.
+  [[nodiscard]] const osmium::Way* way(uint64_t id) const;
+  [[nodiscard]] const osmium::Relation* relation(uint64_t id) const;
+  // Copies the stored version of an unchanged way or relation into
+  // _unchanged, returns false if the state does not know it.
+  bool readUnchanged(osmium::item_type type, uint64_t id);
+
+  osm2rdf::config::Config _config;
+  osm2rdf::osm::FactHandler<W>* _factHandler;
+  osm2rdf::ttl::Writer<W>* _writer;
+  osm2rdf::util::Output* _output;
+  osm2rdf::osm::TagFilter _tagFilter;
+  std::unique_ptr<osm2rdf::osm::UpdateState> _state;
+
+  // Latest version of each object in the change file, as offsets into
+  // _changes.
+  osmium::memory::Buffer _changes;
+  std::unordered_map<uint64_t, size_t> _changedNodes;
+  std::unordered_map<uint64_t, size_t> _changedWays;
+  std::unordered_map<uint64_t, size_t> _changedRelations;
+  // Unchanged objects of the state needed for the update, as offsets into
+  // _unchanged.
+  osmium::memory::Buffer _unchanged;
+  std::unordered_map<uint64_t, size_t> _unchangedWays;
+  std::unordered_map<uint64_t, size_t> _unchangedRelations;
+  // Unchanged ways and relations whose geometry changed.
+  std::unordered_set<uint64_t> _affectedWays;
+  std::unordered_set<uint64_t> _affectedRelations;
+  // Relations whose geometry is built: updated relations and all of their
+  // relation members, sorted.
+  std::vector<uint64_t> _relationIds;
+  // Ways needed for the geometries of updated ways and relations, sorted.
+  std::vector<uint64_t> _wayIds;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_UPDATEHANDLER_H_
@@ -0,0 +1,125 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_OSM_UPDATESTATE_H
+#define OSM2RDF_OSM_UPDATESTATE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "osm2rdf/config/Config.h"
+#include "osm2rdf/osm/PersistentLocationIndex.h"
+#include "osm2rdf/osm/PersistentStore.h"
+#include "osmium/handler.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/item_type.hpp"
+#include "osmium/osm/location.hpp"
+#include "osmium/osm/object.hpp"
+#include "osmium/osm/relation.hpp"
+#include "osmium/osm/way.hpp"
+
+namespace osm2rdf::osm {
+
+// Bump whenever the on-disk layout changes.
+const static uint32_t UPDATE_STATE_VERSION = 1;
+
+// State needed to apply OSM change files without reading the previous input,
+// kept in the cache directory: the persistent node location index, all ways
+// and relations, and for each node, way and relation the ways and relations
+// which may reference it. A full run with --update-state writes the state in
+// its second pass, each update reads it and advances it by the change file.
+class UpdateState : public osmium::handler::Handler {
+ public:
+  // Creates an empty state for config.input if create is true, otherwise
+  // opens the complete state of config.input and throws if there is none.
+  UpdateState(const osm2rdf::config::Config& config, bool create);
+
+  // Stores ways and relations of the full run.
+  void way(const osmium::Way& way);
+  void relation(const osmium::Relation& relation);
+  // Marks the state written by the full run as complete.
+  void finalize();
+
+  // Copies the stored way or relation into buffer, returns false if it is
+  // unknown.
+  bool read(osmium::item_type type, uint64_t id,
+            osmium::memory::Buffer* buffer) const;
+  // Adds the ways and relations which may reference the object, callers
+  // check their members. Relations can not reference areas.
+  void parents(osmium::item_type type, uint64_t id,
+               std::vector<uint64_t>* ways,
+               std::vector<uint64_t>* relations) const;
+  [[nodiscard]] osmium::Location location(uint64_t id) const;
+
+  // Replaces the stored version of a changed object by object.
+  void apply(const osmium::OSMObject& object);
+  // Marks the state advanced by all applied objects as complete.
+  void commit();
+
+  // Number of change files applied since the full run.
+  [[nodiscard]] uint64_t sequence() const noexcept;
+
+ protected:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t complete;
+    uint64_t inputFingerprint;
+    uint64_t locationsFingerprint;
+    uint64_t sequence;
+  };
+
+  // Reads the header of a complete state of config.input, throws if there is
+  // none.
+  static Header readHeader(const osm2rdf::config::Config& config,
+                           const std::filesystem::path& path);
+  // Writes the header of an empty, incomplete state.
+  static Header createHeader(const osm2rdf::config::Config& config,
+                             const std::filesystem::path& path);
+  static void writeHeader(const std::filesystem::path& path,
+                          const Header& header);
+  // Marks the state incomplete before the first change is applied.
+  void advance();
+  void store(const osmium::OSMObject& object);
+  void flushParents();
+
+  osm2rdf::config::Config _config;
+  std::filesystem::path _headerPath;
+  Header _header{};
+  // Only opened by updates, the full run writes the index through its
+  // LocationHandler.
+  std::unique_ptr<osm2rdf::osm::PersistentLocationIndex> _locations;
+  osm2rdf::osm::PersistentStore _ways;
+  osm2rdf::osm::PersistentStore _relations;
+  // Parents of node buckets, of way ids and of relation ids, see
+  // UpdateState.cpp.
+  osm2rdf::osm::PersistentStore _nodeParents;
+  osm2rdf::osm::PersistentStore _memberParents;
+  // Pairs of key and parent, merged into the parent stores in batches.
+  std::vector<std::pair<uint64_t, uint64_t>> _pendingNodeParents;
+  std::vector<std::pair<uint64_t, uint64_t>> _pendingMemberParents;
+  bool _advancing = false;
+};
+
+}  // namespace osm2rdf::osm
+
+#endif  // OSM2RDF_OSM_UPDATESTATE_H
@@ -19,11 +19,12 @@
 #ifndef OSM2RDF_OSM_WAY_H_
 #define OSM2RDF_OSM_WAY_H_
 
+#include <memory_resource>
 #include <vector>
 
 #include "osm2rdf/osm/Box.h"
-#include "osm2rdf/osm/Node.h"
 #include "osm2rdf/osm/TagList.h"
+#include "osmium/osm/node_ref_list.hpp"
 #include "osmium/osm/way.hpp"
 #include "util/geo/Geo.h"
 
@@ -34,18 +35,26 @@ class Way {
   typedef uint32_t id_t;
   Way();
   void finalize();
-  explicit Way(const osmium::Way& way);
+  explicit Way(
+      const osmium::Way& way,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
   [[nodiscard]] id_t id() const noexcept;
   [[nodiscard]] std::time_t timestamp() const noexcept;
   [[nodiscard]] bool closed() const noexcept;
   [[nodiscard]] bool isArea() const noexcept;
   [[nodiscard]] const ::util::geo::DBox& envelope() const noexcept;
+  // Converted from the fixed-point geometry on first use, not thread-safe.
   [[nodiscard]] const ::util::geo::DLine& geom() const noexcept;
+  [[nodiscard]] const ::util::geo::I32Line& fixedGeom() const noexcept;
+  // Length of geom(), measured while converting it.
+  [[nodiscard]] double length() const noexcept;
   [[nodiscard]] const ::util::geo::DPolygon& convexHull() const noexcept;
   [[nodiscard]] const ::util::geo::DPolygon& orientedBoundingBox()
       const noexcept;
   [[nodiscard]] const ::util::geo::DPoint centroid() const noexcept;
-  [[nodiscard]] const std::vector<osm2rdf::osm::Node>& nodes() const noexcept;
+  // Points into the osmium buffer the way was read from, empty for default
+  // constructed ways.
+  [[nodiscard]] const osmium::WayNodeList& nodes() const noexcept;
   [[nodiscard]] const osm2rdf::osm::TagList& tags() const noexcept;
 
   bool operator==(const osm2rdf::osm::Way& other) const noexcept;
@@ -54,8 +63,10 @@ class Way {
  protected:
   id_t _id;
   std::time_t _timestamp;
-  std::vector<osm2rdf::osm::Node> _nodes;
-  ::util::geo::DLine _geom;
+  const osmium::WayNodeList* _nodes;
+  ::util::geo::I32Line _fixedGeom;
+  mutable ::util::geo::DLine _geom;
+  mutable double _length = 0;
   ::util::geo::DBox _envelope;
   ::util::geo::DPolygon _convexHull;
   ::util::geo::DPolygon _obb;
@@ -110,15 +110,15 @@ class Writer {
                    const std::string& o, size_t part);
 
   void writeIRILiteralTriple(const std::string& s, const std::string& p,
-                             const std::string& v, const std::string& o);
+                             std::string_view v, std::string_view o);
   void writeIRILiteralTriple(const std::string& s, const std::string& p,
-                             const std::string& v, const std::string& o,
+                             std::string_view v, std::string_view o,
                              size_t part);
 
   void writeUnsafeIRILiteralTriple(const std::string& s, const std::string& p,
-                                   const std::string& v, const std::string& o);
+                                   std::string_view v, std::string_view o);
   void writeUnsafeIRILiteralTriple(const std::string& s, const std::string& p,
-                                   const std::string& v, const std::string& o,
+                                   std::string_view v, std::string_view o,
                                    size_t part);
 
   // Write a single RDF line with a literal. The contents of s, p, a and b are
@@ -148,6 +148,9 @@ class Writer {
   std::string generateIRI(std::string_view p, uint64_t v);
   // generateIRI creates a IRI from given prefix p and string value v.
   std::string generateIRI(std::string_view p, std::string_view v);
+  // Same as generateIRI(p, v), but replaces the content of out. Lets callers
+  // reuse the capacity of out instead of allocating a string for each IRI.
+  void generateIRI(std::string_view p, uint64_t v, std::string* out);
 
   // Writes an IRI from given prefix p and string value v.
   // Assumes that both p and v are "safe", that is, they can be used
@@ -164,6 +167,8 @@ class Writer {
   // generateLangTag creates a Literal from the given string value v.
   std::string generateLiteral(std::string_view v, std::string_view s);
   std::string generateLiteral(std::string_view v);
+  // Same as generateLiteral(v), but replaces the content of out.
+  void generateLiteral(std::string_view v, std::string* out);
 
   // Assumes that both p and v are "safe", that is, they can be used
   // directly in the TTL
@@ -178,12 +183,15 @@ class Writer {
   // -------------------------------------------------------------------------
   std::string formatIRI(std::string_view p, std::string_view v);
   std::string formatIRIUnsafe(std::string_view p, std::string_view v);
+  void formatIRIUnsafe(std::string_view p, std::string_view v,
+                       std::string* out);
 
   void writeFormattedIRI(std::string_view p, std::string_view v, size_t part);
   void writeFormattedIRIUnsafe(std::string_view p, std::string_view v,
                                size_t part);
 
   std::string STRING_LITERAL_QUOTE(std::string_view s);
+  void STRING_LITERAL_QUOTE(std::string_view s, std::string* out);
   FRIEND_TEST(WriterGrammarNT, RULE_9_STRING_LITERAL_QUOTE);
   FRIEND_TEST(WriterGrammarTTL, RULE_22_STRING_LITERAL_QUOTE);
 
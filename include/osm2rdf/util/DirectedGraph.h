@@ -57,6 +57,10 @@ class DirectedGraph {
   [[nodiscard]] std::vector<T> getVertices() const;
   // getEdges returns the stored edges for the given vertex.
   [[nodiscard]] std::vector<T> getEdges(T src) const;
+  // sortTopologicallyBottomUp returns the vertices ordered such that each
+  // vertex comes after all of its successors. Vertices on a cycle or with a
+  // path to a cycle are not part of the result.
+  [[nodiscard]] std::vector<T> sortTopologicallyBottomUp() const;
 
  protected:
   void findSuccessorsHelper(T src, std::vector<T>* tmp) const;
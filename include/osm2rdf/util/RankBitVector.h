@@ -0,0 +1,66 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_UTIL_RANKBITVECTOR_H_
+#define OSM2RDF_UTIL_RANKBITVECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osm2rdf::util {
+
+// Growable bit vector with constant time rank after buildRank was called.
+// Ranks are stored for blocks of 512 bits, the remaining bits are counted
+// with popcount.
+class RankBitVector {
+ public:
+  RankBitVector() = default;
+  // Creates a bit vector from previously stored words, see words().
+  explicit RankBitVector(std::vector<uint64_t> words);
+
+  // Sets the bit at pos, growing the vector if needed. Invalidates the rank
+  // index.
+  void set(uint64_t pos);
+  // Sets all bits set in other. Invalidates the rank index.
+  void merge(const RankBitVector& other);
+  [[nodiscard]] bool get(uint64_t pos) const noexcept;
+  // Builds the rank index. Has to be called after the last set and before
+  // rank, select or count.
+  void buildRank();
+  // Number of set bits before pos.
+  [[nodiscard]] uint64_t rank(uint64_t pos) const noexcept;
+  // Position of the set bit with the given rank, k has to be less than
+  // count().
+  [[nodiscard]] uint64_t select(uint64_t k) const noexcept;
+  // Number of set bits.
+  [[nodiscard]] uint64_t count() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] const std::vector<uint64_t>& words() const noexcept;
+  [[nodiscard]] size_t used_memory() const noexcept;
+
+ protected:
+  std::vector<uint64_t> _words;
+  // Number of set bits before each block of WORDS_PER_BLOCK words, followed by
+  // the total number of set bits.
+  std::vector<uint64_t> _ranks;
+};
+
+}  // namespace osm2rdf::util
+
+#endif  // OSM2RDF_UTIL_RANKBITVECTOR_H_
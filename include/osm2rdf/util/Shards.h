@@ -0,0 +1,50 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_UTIL_SHARDS_H_
+#define OSM2RDF_UTIL_SHARDS_H_
+
+#include <cstdint>
+#include <filesystem>
+
+#include "osm2rdf/config/Config.h"
+
+namespace osm2rdf::util {
+
+// Returns the shard converting objects with the given id. Ids are split into
+// blocks of consecutive ids assigned round-robin, keeping the locality of
+// dense ids within a worker while balancing the shards.
+[[nodiscard]] size_t shardOf(uint64_t id, size_t shards);
+
+// Returns the shard converting all ids from first to last, or shards if they
+// belong to different shards.
+[[nodiscard]] size_t shardOfRange(uint64_t first, uint64_t last,
+                                  size_t shards);
+
+// Returns the output file written by the worker process of shard.
+[[nodiscard]] std::filesystem::path shardOutput(
+    const std::filesystem::path& output, size_t shard);
+
+// Starts one worker process per shard, each running the given command line
+// with --shard appended, waits for all workers and concatenates their output
+// files in shard order into the output. Returns the exit code.
+int runShards(const osm2rdf::config::Config& config, int argc, char** argv);
+
+}  // namespace osm2rdf::util
+
+#endif  // OSM2RDF_UTIL_SHARDS_H_
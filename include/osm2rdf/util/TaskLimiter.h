@@ -0,0 +1,67 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_UTIL_TASKLIMITER_H_
+#define OSM2RDF_UTIL_TASKLIMITER_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace osm2rdf::util {
+
+// Tracks the number and estimated size of objects read by a single producer
+// and not yet finished by the tasks processing them. The producer calls add
+// for each object, workers call done once they finished objects. Once add
+// returns true, the producer waits until drained returns true, i.e. until the
+// objects in flight dropped to the low watermark. This bounds the memory held
+// by queued tasks without draining the task queue completely.
+class TaskLimiter {
+ public:
+  // A value of 0 disables the corresponding limit. The low watermarks are
+  // half of the limits.
+  TaskLimiter(std::size_t maxObjects, std::size_t maxBytes);
+  TaskLimiter() = default;
+  // Registers a read object. Returns true if a limit is reached. Only called
+  // by the producer.
+  bool add(std::size_t bytes);
+  // Marks objects as finished, called by any thread.
+  void done(std::size_t objects, std::size_t bytes) noexcept;
+  // Returns true if objects and bytes in flight are below the low watermarks.
+  [[nodiscard]] bool drained() const noexcept;
+
+  // Objects and bytes in flight.
+  [[nodiscard]] std::size_t objects() const noexcept;
+  [[nodiscard]] std::size_t bytes() const noexcept;
+  // Number of times a limit was reached.
+  [[nodiscard]] std::size_t numWaits() const;
+
+ protected:
+  std::size_t _maxObjects = 0;
+  std::size_t _maxBytes = 0;
+  // Only modified by the producer.
+  std::size_t _objects = 0;
+  std::size_t _bytes = 0;
+  std::size_t _numWaits = 0;
+  // Modified by all workers.
+  std::atomic<std::size_t> _doneObjects{0};
+  std::atomic<std::size_t> _doneBytes{0};
+};
+
+}  // namespace osm2rdf::util
+
+#endif  // OSM2RDF_UTIL_TASKLIMITER_H_
@@ -0,0 +1,60 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM2RDF_UTIL_THREADCOUNTERS_H_
+#define OSM2RDF_UTIL_THREADCOUNTERS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace osm2rdf::util {
+
+static const std::size_t kCacheLineSize = 64;
+
+// Set of counters with one copy per thread. Each copy lives on its own cache
+// lines, so incrementing never requires a lock and never causes false
+// sharing. Reading sums up the copies of all threads and can be done
+// concurrently to increments, e.g. from a reporting thread.
+class ThreadCounters {
+ public:
+  ThreadCounters(std::size_t numThreads, std::size_t numCounters);
+  // Adds value to counter for the calling OpenMP thread.
+  void add(std::size_t counter, std::size_t value) noexcept;
+  // Returns the sum of counter over all threads.
+  [[nodiscard]] std::size_t get(std::size_t counter) const noexcept;
+
+ protected:
+  static const std::size_t kCountersPerLine =
+      kCacheLineSize / sizeof(std::atomic<std::size_t>);
+  struct alignas(kCacheLineSize) CacheLine {
+    std::atomic<std::size_t> values[kCountersPerLine];
+  };
+
+  std::atomic<std::size_t>& at(std::size_t thread, std::size_t counter);
+  const std::atomic<std::size_t>& at(std::size_t thread,
+                                     std::size_t counter) const;
+
+  std::size_t _numThreads;
+  std::size_t _linesPerThread;
+  std::vector<CacheLine> _lines;
+};
+
+}  // namespace osm2rdf::util
+
+#endif  // OSM2RDF_UTIL_THREADCOUNTERS_H_
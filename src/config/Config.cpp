@@ -17,6 +17,7 @@
 // You should have received a copy of the GNU General Public License
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <string>
@@ -28,6 +29,7 @@
 #endif
 #include "osm2rdf/config/Constants.h"
 #include "osm2rdf/config/ExitCode.h"
+#include "osm2rdf/util/Shards.h"
 #include "popl.hpp"
 
 // ____________________________________________________________________________
@@ -103,6 +105,11 @@ std::string osm2rdf::config::Config::getInfo(std::string_view prefix) const {
       oss << "\n"
           << prefix << osm2rdf::config::constants::NO_UNTAGGED_AREAS_INFO;
     }
+    if (!tagFilter.empty()) {
+      oss << "\n"
+          << prefix << osm2rdf::config::constants::TAG_FILTER_INFO << " "
+          << tagFilter;
+    }
     if (simplifyWKT > 0) {
       oss << "\n" << prefix << osm2rdf::config::constants::SIMPLIFY_WKT_INFO;
       oss << "\n"
@@ -162,12 +169,65 @@ std::string osm2rdf::config::Config::getInfo(std::string_view prefix) const {
   }
   oss << "\n" << prefix << osm2rdf::config::constants::SECTION_MISCELLANEOUS;
   oss << "\n" << prefix << "Num Threads: " << numThreads;
+  oss << "\n"
+      << prefix << osm2rdf::config::constants::BATCH_SIZE_INFO << " "
+      << batchSize;
+  if (maxInFlightObjects > 0) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::MAX_IN_FLIGHT_OBJECTS_INFO
+        << " " << maxInFlightObjects;
+  }
+  if (maxInFlightBytes > 0) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::MAX_IN_FLIGHT_BYTES_INFO << " "
+        << maxInFlightBytes;
+  }
+  if (shards > 1) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::SHARDS_INFO << " " << shards;
+  }
+  if (shardWorker) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::SHARD_INFO << " " << shard;
+  }
 
   if (!storeLocations.empty()) {
     oss << "\n"
         << prefix << osm2rdf::config::constants::STORE_LOCATIONS_INFO << " "
         << storeLocations;
   }
+  if (parallelLocations) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::PARALLEL_LOCATIONS_INFO;
+  }
+  if (parallelAreas) {
+    oss << "\n" << prefix << osm2rdf::config::constants::PARALLEL_AREAS_INFO;
+  }
+  if (blobIndex) {
+    oss << "\n" << prefix << osm2rdf::config::constants::BLOB_INDEX_INFO;
+  }
+  if (!clipBbox.empty()) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::CLIP_BBOX_INFO << " "
+        << clipBbox;
+  }
+  if (!clipPolygon.empty()) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::CLIP_POLYGON_INFO << " "
+        << clipPolygon.string();
+  }
+  if (!updateChanges.empty()) {
+    oss << "\n"
+        << prefix << osm2rdf::config::constants::UPDATE_INFO << " "
+        << updateChanges.string();
+  }
+
+  if (snapshot) {
+    oss << "\n" << prefix << osm2rdf::config::constants::SNAPSHOT_INFO;
+  }
+  if (updateState) {
+    oss << "\n" << prefix << osm2rdf::config::constants::UPDATE_STATE_INFO;
+  }
 
   if (writeRDFStatistics) {
     oss << "\n"
@@ -198,6 +258,34 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
           osm2rdf::config::constants::STORE_LOCATIONS_SHORT,
           osm2rdf::config::constants::STORE_LOCATIONS_LONG,
           osm2rdf::config::constants::STORE_LOCATIONS_HELP, "mem-flex");
+  auto parallelLocationsOp =
+      parser.add<popl::Switch, popl::Attribute::advanced>(
+          osm2rdf::config::constants::PARALLEL_LOCATIONS_OPTION_SHORT,
+          osm2rdf::config::constants::PARALLEL_LOCATIONS_OPTION_LONG,
+          osm2rdf::config::constants::PARALLEL_LOCATIONS_OPTION_HELP);
+  auto parallelAreasOp = parser.add<popl::Switch, popl::Attribute::advanced>(
+      osm2rdf::config::constants::PARALLEL_AREAS_OPTION_SHORT,
+      osm2rdf::config::constants::PARALLEL_AREAS_OPTION_LONG,
+      osm2rdf::config::constants::PARALLEL_AREAS_OPTION_HELP);
+  auto blobIndexOp = parser.add<popl::Switch, popl::Attribute::advanced>(
+      osm2rdf::config::constants::BLOB_INDEX_OPTION_SHORT,
+      osm2rdf::config::constants::BLOB_INDEX_OPTION_LONG,
+      osm2rdf::config::constants::BLOB_INDEX_OPTION_HELP);
+  auto clipBboxOp =
+      parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+          osm2rdf::config::constants::CLIP_BBOX_OPTION_SHORT,
+          osm2rdf::config::constants::CLIP_BBOX_OPTION_LONG,
+          osm2rdf::config::constants::CLIP_BBOX_OPTION_HELP);
+  auto clipPolygonOp =
+      parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+          osm2rdf::config::constants::CLIP_POLYGON_OPTION_SHORT,
+          osm2rdf::config::constants::CLIP_POLYGON_OPTION_LONG,
+          osm2rdf::config::constants::CLIP_POLYGON_OPTION_HELP);
+  auto updateOp =
+      parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+          osm2rdf::config::constants::UPDATE_OPTION_SHORT,
+          osm2rdf::config::constants::UPDATE_OPTION_LONG,
+          osm2rdf::config::constants::UPDATE_OPTION_HELP);
 
   auto noAreasOp = parser.add<popl::Switch, popl::Attribute::advanced>(
       osm2rdf::config::constants::NO_AREA_OPTION_SHORT,
@@ -303,6 +391,11 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
           osm2rdf::config::constants::NO_UNTAGGED_AREAS_OPTION_SHORT,
           osm2rdf::config::constants::NO_UNTAGGED_AREAS_OPTION_LONG,
           osm2rdf::config::constants::NO_UNTAGGED_AREAS_OPTION_HELP);
+  auto tagFilterOp =
+      parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
+          osm2rdf::config::constants::TAG_FILTER_OPTION_SHORT,
+          osm2rdf::config::constants::TAG_FILTER_OPTION_LONG,
+          osm2rdf::config::constants::TAG_FILTER_OPTION_HELP);
 
   auto addWayMetadataOp = parser.add<popl::Switch>(
       osm2rdf::config::constants::ADD_WAY_METADATA_OPTION_SHORT,
@@ -331,6 +424,30 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
       osm2rdf::config::constants::NUM_THREADS_OPTION_SHORT,
       osm2rdf::config::constants::NUM_THREADS_OPTION_LONG,
       osm2rdf::config::constants::NUM_THREADS_OPTION_HELP, numThreads);
+  auto maxInFlightObjectsOp =
+      parser.add<popl::Value<size_t>, popl::Attribute::expert>(
+          osm2rdf::config::constants::MAX_IN_FLIGHT_OBJECTS_OPTION_SHORT,
+          osm2rdf::config::constants::MAX_IN_FLIGHT_OBJECTS_OPTION_LONG,
+          osm2rdf::config::constants::MAX_IN_FLIGHT_OBJECTS_OPTION_HELP,
+          maxInFlightObjects);
+  auto maxInFlightBytesOp =
+      parser.add<popl::Value<size_t>, popl::Attribute::expert>(
+          osm2rdf::config::constants::MAX_IN_FLIGHT_BYTES_OPTION_SHORT,
+          osm2rdf::config::constants::MAX_IN_FLIGHT_BYTES_OPTION_LONG,
+          osm2rdf::config::constants::MAX_IN_FLIGHT_BYTES_OPTION_HELP,
+          maxInFlightBytes);
+  auto batchSizeOp = parser.add<popl::Value<size_t>, popl::Attribute::expert>(
+      osm2rdf::config::constants::BATCH_SIZE_OPTION_SHORT,
+      osm2rdf::config::constants::BATCH_SIZE_OPTION_LONG,
+      osm2rdf::config::constants::BATCH_SIZE_OPTION_HELP, batchSize);
+  auto shardsOp = parser.add<popl::Value<size_t>, popl::Attribute::advanced>(
+      osm2rdf::config::constants::SHARDS_OPTION_SHORT,
+      osm2rdf::config::constants::SHARDS_OPTION_LONG,
+      osm2rdf::config::constants::SHARDS_OPTION_HELP, shards);
+  auto shardOp = parser.add<popl::Value<size_t>, popl::Attribute::expert>(
+      osm2rdf::config::constants::SHARD_OPTION_SHORT,
+      osm2rdf::config::constants::SHARD_OPTION_LONG,
+      osm2rdf::config::constants::SHARD_OPTION_HELP);
 
   auto semicolonTagKeysOp =
       parser.add<popl::Value<std::string>, popl::Attribute::advanced>(
@@ -390,6 +507,14 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
       osm2rdf::config::constants::CACHE_OPTION_SHORT,
       osm2rdf::config::constants::CACHE_OPTION_LONG,
       osm2rdf::config::constants::CACHE_OPTION_HELP, cache);
+  auto snapshotOp = parser.add<popl::Switch, popl::Attribute::advanced>(
+      osm2rdf::config::constants::SNAPSHOT_OPTION_SHORT,
+      osm2rdf::config::constants::SNAPSHOT_OPTION_LONG,
+      osm2rdf::config::constants::SNAPSHOT_OPTION_HELP);
+  auto updateStateOp = parser.add<popl::Switch, popl::Attribute::advanced>(
+      osm2rdf::config::constants::UPDATE_STATE_OPTION_SHORT,
+      osm2rdf::config::constants::UPDATE_STATE_OPTION_LONG,
+      osm2rdf::config::constants::UPDATE_STATE_OPTION_HELP);
 
   try {
     parser.parse(argc, argv);
@@ -420,6 +545,37 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
     if (storeLocationsOp->is_set()) {
       storeLocations = storeLocationsOp->value();
     }
+    if (updateStateOp->is_set()) {
+      // Updates read and advance the node locations of the full run.
+      storeLocations = "disk-persistent";
+    }
+    parallelLocations = parallelLocationsOp->is_set();
+    parallelAreas = parallelAreasOp->is_set();
+    blobIndex = blobIndexOp->is_set();
+    if (clipBboxOp->is_set() && clipPolygonOp->is_set()) {
+      throw popl::invalid_option(
+          clipPolygonOp.get(), popl::invalid_option::Error::too_many_arguments,
+          popl::OptionName::long_name, clipPolygonOp->value(), "");
+    }
+    if (clipBboxOp->is_set()) {
+      clipBbox = clipBboxOp->value();
+    }
+    if (clipPolygonOp->is_set()) {
+      clipPolygon = std::filesystem::absolute(clipPolygonOp->value());
+      if (!std::filesystem::exists(clipPolygon)) {
+        std::cerr << "Clip polygon does not exist: " << clipPolygon << "\n"
+                  << parser.help() << "\n";
+        exit(osm2rdf::config::ExitCode::CLIP_POLYGON_NOT_EXISTS);
+      }
+    }
+    if (updateOp->is_set()) {
+      updateChanges = std::filesystem::absolute(updateOp->value());
+      if (!std::filesystem::exists(updateChanges)) {
+        std::cerr << "Change file does not exist: " << updateChanges << "\n"
+                  << parser.help() << "\n";
+        exit(osm2rdf::config::ExitCode::UPDATE_CHANGES_NOT_EXISTS);
+      }
+    }
 
     // Select types to dump
     noAreaFacts = noAreaFactsOp->is_set();
@@ -446,6 +602,15 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
     }
 
     noGeometricRelations = ogcGeoTriplesMode == none;
+    if (!updateChanges.empty() && !noGeometricRelations) {
+      // Updates only rewrite the triples of changed objects, geometric
+      // relations of unchanged objects would point to stale geometries.
+      std::cerr << "Updates require a target written with --"
+                << osm2rdf::config::constants::OGC_GEO_TRIPLES_OPTION_LONG
+                << " none\n"
+                << parser.help() << "\n";
+      exit(osm2rdf::config::ExitCode::UPDATE_REQUIRES_NO_GEOMETRIC_RELATIONS);
+    }
 
     noAreaFacts |= noAreasOp->is_set();
     noAreaGeometricRelations |= noAreasOp->is_set();
@@ -486,6 +651,9 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
     addUntaggedWays = !noUntaggedWaysOp->is_set();
     addUntaggedRelations = !noUntaggedRelationsOp->is_set();
     addUntaggedAreas = !noUntaggedAreasOp->is_set();
+    if (tagFilterOp->is_set()) {
+      tagFilter = tagFilterOp->value();
+    }
 
     addWayNodeOrder |= addWayNodeSpatialMetadata;
 
@@ -501,12 +669,19 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
     }
 
     if (numThreadsOp->is_set()) numThreads = numThreadsOp->value();
+    maxInFlightObjects = maxInFlightObjectsOp->value();
+    maxInFlightBytes = maxInFlightBytesOp->value();
+    batchSize = std::max<size_t>(batchSizeOp->value(), 1);
 
     writeRDFStatistics = writeRDFStatisticsOp->is_set();
 
     // Output
     output = outputOp->value();
     outputFormat = outputFormatOp->value();
+    if (!updateChanges.empty()) {
+      // Updates only support full IRIs.
+      outputFormat = "nt";
+    }
     if (outputCompressOp->value() == "none") {
       outputCompress = NONE;
     } else if (outputCompressOp->value() == "gz") {
@@ -542,8 +717,37 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
       output += osm2rdf::config::constants::GZ_EXTENSION;
     }
 
+    // Worker processes can not share stdout, the update state is written by
+    // a single process.
+    shards = output.empty() || updateStateOp->is_set()
+                 ? 1
+                 : std::max<size_t>(shardsOp->value(), 1);
+    if (shards > 1) {
+      // Geometric relations need the geometries of all shards.
+      noGeometricRelations = true;
+    }
+    if (shards > 1 && shardOp->is_set()) {
+      if (shardOp->value() >= shards) {
+        throw popl::invalid_option(
+            shardOp.get(), popl::invalid_option::Error::invalid_argument,
+            popl::OptionName::long_name, std::to_string(shardOp->value()), "");
+      }
+      shardWorker = true;
+      shard = shardOp->value();
+      if (!storeLocationsOp->is_set()) {
+        // Workers only store the locations of nodes of their own objects.
+        storeLocations = "mem-required";
+      }
+      output = osm2rdf::util::shardOutput(output, shard);
+      rdfStatisticsPath = std::filesystem::path(output);
+      rdfStatisticsPath += osm2rdf::config::constants::STATS_EXTENSION;
+      rdfStatisticsPath += osm2rdf::config::constants::JSON_EXTENSION;
+    }
+
     // osmium location cache
     cache = std::filesystem::absolute(cacheOp->value()).string();
+    snapshot = snapshotOp->is_set();
+    updateState = updateStateOp->is_set();
 
     // Check cache location
     if (!std::filesystem::exists(cache)) {
@@ -556,6 +760,14 @@ void osm2rdf::config::Config::fromArgs(int argc, char** argv) {
                 << parser.help() << "\n";
       exit(osm2rdf::config::ExitCode::CACHE_NOT_DIRECTORY);
     }
+    if (shardWorker) {
+      // Location stores and snapshots use fixed file names, each worker keeps
+      // them in its own directory, which later runs with the same shard reuse.
+      cache /= "shard_" + std::to_string(shard);
+      std::filesystem::create_directories(cache);
+      // All workers share the threads given by --num-threads.
+      numThreads = std::max(numThreads / static_cast<int>(shards), 1);
+    }
 
     // Handle input
     if (parser.non_option_args().size() != 1) {
@@ -608,3 +820,8 @@ std::filesystem::path osm2rdf::config::Config::getTempPath(
   resultPath /= path + "-" + suffix;
   return std::filesystem::absolute(resultPath);
 }
+
+// ____________________________________________________________________________
+bool osm2rdf::config::Config::isInShard(uint64_t id) const {
+  return !shardWorker || osm2rdf::util::shardOf(id, shards) == shard;
+}
@@ -19,10 +19,13 @@
 
 #include <iostream>
 #include <limits>
+#include <utility>
 
 #include "osm2rdf/osm/Area.h"
 #include "osm2rdf/osm/Constants.h"
+#include "osm2rdf/osm/FixedGeom.h"
 #include "osm2rdf/osm/Node.h"
+#include "osm2rdf/osm/OrientedBoundingBox.h"
 #include "osmium/osm/area.hpp"
 #include "util/geo/Geo.h"
 
@@ -34,10 +37,13 @@ osm2rdf::osm::Area::Area() {
 
 // ____________________________________________________________________________
 void osm2rdf::osm::Area::finalize() noexcept {
-  _geomArea = ::util::geo::area(_geom);
+  _geomArea = ::util::geo::area(geom());
   _envelopeArea = ::util::geo::area(_envelope);
-  _convexHull = ::util::geo::convexHull(_geom);
-  _obb = ::util::geo::convexHull(::util::geo::getOrientedEnvelope(_geom));
+  _convexHull = ::util::geo::convexHull(geom());
+  _obb = osm2rdf::osm::orientedBoundingBox(_convexHull);
+  if (_obb.getOuter().empty()) {
+    _obb = ::util::geo::convexHull(::util::geo::getOrientedEnvelope(geom()));
+  }
 }
 
 // ____________________________________________________________________________
@@ -51,10 +57,10 @@ osm2rdf::osm::Area::Area(const osmium::Area& area) : Area() {
   double latMax = -std::numeric_limits<double>::infinity();
 
   const auto& outerRings = area.outer_rings();
-  _geom.resize(outerRings.size());
+  _fixedGeom.resize(outerRings.size());
   int oCount = 0;
   for (const auto& oring : outerRings) {
-    _geom[oCount].getOuter().reserve(oring.size());
+    _fixedGeom[oCount].getOuter().reserve(oring.size());
     for (const auto& nodeRef : oring) {
       if (nodeRef.lon() < lonMin) {
         lonMin = nodeRef.lon();
@@ -72,17 +78,17 @@ osm2rdf::osm::Area::Area(const osmium::Area& area) : Area() {
         latMax = nodeRef.lat();
       }
 
-      _geom[oCount].getOuter().push_back({nodeRef.lon(), nodeRef.lat()});
+      _fixedGeom[oCount].getOuter().push_back(osm2rdf::osm::toFixed(nodeRef));
     }
 
     const auto& innerRings = area.inner_rings(oring);
-    _geom[oCount].getInners().resize(innerRings.size());
+    _fixedGeom[oCount].getInners().resize(innerRings.size());
     int iCount = 0;
     for (const auto& iring : innerRings) {
-      _geom[oCount].getInners()[iCount].reserve(iring.size());
+      _fixedGeom[oCount].getInners()[iCount].reserve(iring.size());
       for (const auto& nodeRef : iring) {
-        _geom[oCount].getInners()[iCount].push_back(
-            {nodeRef.lon(), nodeRef.lat()});
+        _fixedGeom[oCount].getInners()[iCount].push_back(
+            osm2rdf::osm::toFixed(nodeRef));
       }
       iCount++;
     }
@@ -102,9 +108,43 @@ osm2rdf::osm::Area::id_t osm2rdf::osm::Area::objId() const noexcept {
 
 // ____________________________________________________________________________
 const ::util::geo::DMultiPolygon& osm2rdf::osm::Area::geom() const noexcept {
+  if (_geom.size() != _fixedGeom.size()) {
+    // Convert and measure in a single pass. Like ::util::geo::len, only the
+    // outer rings count towards the perimeter.
+    ::util::geo::DMultiPolygon geom(_fixedGeom.size());
+    _length = 0;
+    for (size_t i = 0; i < _fixedGeom.size(); i++) {
+      auto& outer = geom[i].getOuter();
+      outer.reserve(_fixedGeom[i].getOuter().size());
+      for (const auto& point : _fixedGeom[i].getOuter()) {
+        const ::util::geo::DPoint p = osm2rdf::osm::toDouble(point);
+        if (!outer.empty()) {
+          _length += ::util::geo::dist(outer.back(), p);
+        }
+        outer.push_back(p);
+      }
+      geom[i].getInners().reserve(_fixedGeom[i].getInners().size());
+      for (const auto& inner : _fixedGeom[i].getInners()) {
+        geom[i].getInners().push_back(osm2rdf::osm::toDouble(inner));
+      }
+    }
+    _geom = std::move(geom);
+  }
   return _geom;
 }
 
+// ____________________________________________________________________________
+double osm2rdf::osm::Area::length() const noexcept {
+  geom();
+  return _length;
+}
+
+// ____________________________________________________________________________
+const ::util::geo::I32MultiPolygon& osm2rdf::osm::Area::fixedGeom()
+    const noexcept {
+  return _fixedGeom;
+}
+
 // ____________________________________________________________________________
 const ::util::geo::DBox& osm2rdf::osm::Area::envelope() const noexcept {
   return _envelope;
@@ -131,7 +171,11 @@ const ::util::geo::DPolygon& osm2rdf::osm::Area::orientedBoundingBox()
 
 // ____________________________________________________________________________
 const ::util::geo::DPoint osm2rdf::osm::Area::centroid() const noexcept {
-  return ::util::geo::centroid(_geom);
+  if (!_hasCentroid) {
+    _centroid = ::util::geo::centroid(geom());
+    _hasCentroid = true;
+  }
+  return _centroid;
 }
 
 // ____________________________________________________________________________
@@ -140,7 +184,7 @@ bool osm2rdf::osm::Area::operator==(
   return _id == other._id && _objId == other._objId &&
          _geomArea == other._geomArea &&
          _envelopeArea == other._envelopeArea && _envelope == other._envelope &&
-         _geom == other._geom;
+         _fixedGeom == other._fixedGeom;
 }
 
 // ____________________________________________________________________________
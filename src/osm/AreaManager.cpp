@@ -0,0 +1,209 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/AreaManager.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "osmium/memory/item.hpp"
+#include "osmium/osm/location.hpp"
+
+// ____________________________________________________________________________
+osm2rdf::osm::AreaManager::AreaManager(
+    const osmium::area::Assembler::config_type& assemblerConfig,
+    std::size_t numThreads)
+    : _assemblerConfig(assemblerConfig) {
+  for (std::size_t i = 0; i < numThreads; ++i) {
+    _threads.emplace_back([this]() { work(); });
+  }
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::AreaManager::~AreaManager() {
+  {
+    std::lock_guard<std::mutex> lock(_queueMutex);
+    _stopping = true;
+  }
+  _queueChanged.notify_all();
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::AreaManager::new_relation(
+    const osmium::Relation& relation) const noexcept {
+  const char* type = relation.tags().get_value_by_key("type");
+  return type != nullptr && (std::strcmp(type, "multipolygon") == 0 ||
+                             std::strcmp(type, "boundary") == 0);
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::AreaManager::new_member(
+    const osmium::Relation& /*relation*/, const osmium::RelationMember& member,
+    std::size_t /*n*/) const noexcept {
+  return member.type() == osmium::item_type::way;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::AreaManager::assemble(
+    const osmium::Relation& relation,
+    const std::vector<const osmium::Way*>& ways,
+    osmium::memory::Buffer* buffer) {
+  try {
+    osmium::area::Assembler assembler{_assemblerConfig};
+    assembler(relation, ways, *buffer);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats += assembler.stats();
+  } catch (const osmium::invalid_location&) {
+    // Areas with missing locations are skipped, like MultipolygonManager.
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::AreaManager::complete_relation(
+    const osmium::Relation& relation) {
+  if (_threads.empty()) {
+    std::vector<const osmium::Way*> ways;
+    ways.reserve(relation.members().size());
+    for (const auto& member : relation.members()) {
+      if (member.ref() != 0) {
+        ways.push_back(this->get_member_way(member.ref()));
+      }
+    }
+    assemble(relation, ways, &this->buffer());
+    return;
+  }
+
+  // The member ways are released once this call returns, the pool works on
+  // copies of the relation and its ways in member order.
+  std::vector<const osmium::Way*> members;
+  members.reserve(relation.members().size());
+  size_t size = osmium::memory::padded_length(relation.byte_size());
+  for (const auto& member : relation.members()) {
+    if (member.ref() != 0) {
+      members.push_back(this->get_member_way(member.ref()));
+      size += osmium::memory::padded_length(members.back()->byte_size());
+    }
+  }
+  auto input = std::make_unique<osmium::memory::Buffer>(
+      size, osmium::memory::Buffer::auto_grow::yes);
+  input->add_item(relation);
+  input->commit();
+  for (const auto* way : members) {
+    input->add_item(*way);
+    input->commit();
+  }
+  _pending++;
+  {
+    std::lock_guard<std::mutex> lock(_queueMutex);
+    _queue.push_back(std::move(input));
+  }
+  _queueChanged.notify_all();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::AreaManager::work() {
+  while (true) {
+    std::unique_ptr<osmium::memory::Buffer> input;
+    {
+      std::unique_lock<std::mutex> lock(_queueMutex);
+      _queueChanged.wait(lock, [&]() { return _stopping || !_queue.empty(); });
+      if (_queue.empty()) {
+        return;
+      }
+      input = std::move(_queue.front());
+      _queue.pop_front();
+    }
+    std::vector<const osmium::Way*> ways;
+    for (const auto& way : input->select<osmium::Way>()) {
+      ways.push_back(&way);
+    }
+    // The assembled area holds roughly the locations and tags of its ways.
+    osmium::memory::Buffer output{input->committed(),
+                                  osmium::memory::Buffer::auto_grow::yes};
+    assemble(input->get<osmium::Relation>(0), ways, &output);
+    if (output.committed() > 0) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _assembled.push_back(std::move(output));
+    }
+    {
+      std::lock_guard<std::mutex> lock(_queueMutex);
+      _pending--;
+    }
+    _queueChanged.notify_all();
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::AreaManager::after_way(const osmium::Way& way) {
+  // At least four nodes are needed for a closed ring.
+  if (way.nodes().size() <= 3) {
+    return;
+  }
+  try {
+    if (!way.nodes().front().location() || !way.nodes().back().location()) {
+      throw osmium::invalid_location{"invalid location"};
+    }
+    if (!way.ends_have_same_location() || way.tags().empty() ||
+        way.tags().has_tag("area", "no")) {
+      return;
+    }
+    osmium::area::Assembler assembler{_assemblerConfig};
+    assembler(way, this->buffer());
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stats += assembler.stats();
+    }
+    this->possibly_flush();
+  } catch (const osmium::invalid_location&) {
+    // Ways with missing locations are skipped, like MultipolygonManager.
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::AreaManager::drain(
+    const std::function<void(osmium::memory::Buffer&&)>& callback) {
+  std::vector<osmium::memory::Buffer> assembled;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    assembled.swap(_assembled);
+  }
+  for (auto& buffer : assembled) {
+    callback(std::move(buffer));
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::AreaManager::wait() {
+  std::unique_lock<std::mutex> lock(_queueMutex);
+  _queueChanged.wait(lock, [&]() { return _pending == 0; });
+}
+
+// ____________________________________________________________________________
+size_t osm2rdf::osm::AreaManager::pending() const noexcept {
+  return _pending;
+}
+
+// ____________________________________________________________________________
+osmium::area::area_stats osm2rdf::osm::AreaManager::stats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
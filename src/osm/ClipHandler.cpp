@@ -0,0 +1,224 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/ClipHandler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "osmium/osm/area.hpp"
+#include "osmium/osm/item_type.hpp"
+
+// ____________________________________________________________________________
+osm2rdf::osm::ClipHandler::ClipHandler(osm2rdf::osm::ClipRegion region)
+    : _region(std::move(region)) {}
+
+// ____________________________________________________________________________
+std::unique_ptr<osm2rdf::osm::ClipHandler> osm2rdf::osm::ClipHandler::create(
+    const osm2rdf::config::Config& config) {
+  if (!config.clipPolygon.empty()) {
+    return std::make_unique<ClipHandler>(
+        osm2rdf::osm::ClipRegion::fromPolyFile(config.clipPolygon));
+  }
+  if (!config.clipBbox.empty()) {
+    return std::make_unique<ClipHandler>(
+        osm2rdf::osm::ClipRegion::fromBbox(config.clipBbox));
+  }
+  return nullptr;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipHandler::keepNode(uint64_t id) {
+  _nodes.set(id);
+  _minNodeId = std::min(_minNodeId, id);
+  _maxNodeId = std::max(_maxNodeId, id);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipHandler::node(const osmium::Node& node) {
+  if (_region.contains(node.location())) {
+    _insideNodes.set(node.positive_id());
+    keepNode(node.positive_id());
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipHandler::way(const osmium::Way& way) {
+  const auto& nodes = way.nodes();
+  if (std::none_of(nodes.begin(), nodes.end(), [&](const auto& nodeRef) {
+        return _insideNodes.get(nodeRef.positive_ref());
+      })) {
+    return;
+  }
+  _ways.set(way.positive_id());
+  // Keep ways complete.
+  for (const auto& nodeRef : nodes) {
+    keepNode(nodeRef.positive_ref());
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipHandler::relation(const osmium::Relation& relation) {
+  bool kept = false;
+  bool pending = false;
+  for (const auto& member : relation.members()) {
+    switch (member.type()) {
+      case osmium::item_type::node:
+        kept = kept || _insideNodes.get(member.positive_ref());
+        break;
+      case osmium::item_type::way:
+        kept = kept || _ways.get(member.positive_ref());
+        break;
+      case osmium::item_type::relation:
+        if (_relations.get(member.positive_ref())) {
+          kept = true;
+        } else {
+          _relationMembers.emplace_back(member.positive_ref(),
+                                        relation.positive_id());
+          pending = true;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  if (!kept && !pending) {
+    return;
+  }
+  if (kept) {
+    _relations.set(relation.positive_id());
+  }
+  // Members outside the region do not make other relations kept, the ways
+  // are only added to _ways in prepare_for_lookup.
+  for (const auto& member : relation.members()) {
+    if (member.type() == osmium::item_type::node) {
+      if (kept) {
+        keepNode(member.positive_ref());
+      } else {
+        _pendingNodes.emplace_back(relation.positive_id(),
+                                   member.positive_ref());
+      }
+    } else if (member.type() == osmium::item_type::way &&
+               !_ways.get(member.positive_ref())) {
+      if (kept) {
+        _incompleteWays.push_back(member.positive_ref());
+      } else {
+        _pendingWays.emplace_back(relation.positive_id(),
+                                  member.positive_ref());
+      }
+    }
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipHandler::prepare_for_lookup() {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const auto& [member, relation] : _relationMembers) {
+      if (_relations.get(member) && !_relations.get(relation)) {
+        _relations.set(relation);
+        changed = true;
+      }
+    }
+  }
+  for (const auto& [relation, node] : _pendingNodes) {
+    if (_relations.get(relation)) {
+      keepNode(node);
+    }
+  }
+  for (const auto& [relation, way] : _pendingWays) {
+    if (_relations.get(relation)) {
+      _incompleteWays.push_back(way);
+    }
+  }
+  std::sort(_incompleteWays.begin(), _incompleteWays.end());
+  _incompleteWays.erase(
+      std::unique(_incompleteWays.begin(), _incompleteWays.end()),
+      _incompleteWays.end());
+  for (const auto way : _incompleteWays) {
+    _ways.set(way);
+  }
+  _relationMembers.clear();
+  _relationMembers.shrink_to_fit();
+  _pendingNodes.clear();
+  _pendingNodes.shrink_to_fit();
+  _pendingWays.clear();
+  _pendingWays.shrink_to_fit();
+  _insideNodes = osm2rdf::util::RankBitVector{};
+  _nodes.buildRank();
+  _ways.buildRank();
+  _relations.buildRank();
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::ClipHandler::hasIncompleteWays() const noexcept {
+  return !_incompleteWays.empty();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipHandler::completeWay(const osmium::Way& way) {
+  if (!std::binary_search(_incompleteWays.begin(), _incompleteWays.end(),
+                          way.positive_id())) {
+    return;
+  }
+  for (const auto& nodeRef : way.nodes()) {
+    keepNode(nodeRef.positive_ref());
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipHandler::finalize() {
+  _incompleteWays.clear();
+  _incompleteWays.shrink_to_fit();
+  _nodes.buildRank();
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::ClipHandler::keep(
+    const osmium::OSMObject& object) const noexcept {
+  switch (object.type()) {
+    case osmium::item_type::node:
+      return _nodes.get(object.positive_id());
+    case osmium::item_type::way:
+      return _ways.get(object.positive_id());
+    case osmium::item_type::relation:
+      return _relations.get(object.positive_id());
+    case osmium::item_type::area: {
+      const auto& area = static_cast<const osmium::Area&>(object);
+      const auto id = static_cast<uint64_t>(area.orig_id());
+      return area.from_way() ? _ways.get(id) : _relations.get(id);
+    }
+    default:
+      return true;
+  }
+}
+
+// ____________________________________________________________________________
+osmium::memory::Buffer osm2rdf::osm::ClipHandler::filter(
+    const osmium::memory::Buffer& buffer) const {
+  osmium::memory::Buffer result{buffer.committed(),
+                                osmium::memory::Buffer::auto_grow::yes};
+  for (const auto& object : buffer.select<osmium::OSMObject>()) {
+    if (keep(object)) {
+      result.add_item(object);
+      result.commit();
+    }
+  }
+  return result;
+}
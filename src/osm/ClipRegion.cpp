@@ -0,0 +1,169 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/ClipRegion.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Upper bound for the number of bands used to look up edges.
+static const size_t MAX_BANDS = 4096;
+
+// ____________________________________________________________________________
+osm2rdf::osm::ClipRegion osm2rdf::osm::ClipRegion::fromBbox(
+    std::string_view bbox) {
+  std::string text{bbox};
+  std::replace(text.begin(), text.end(), ',', ' ');
+  std::istringstream iss{text};
+  double minLon;
+  double minLat;
+  double maxLon;
+  double maxLat;
+  std::string rest;
+  if (!(iss >> minLon >> minLat >> maxLon >> maxLat) || (iss >> rest)) {
+    throw std::invalid_argument("Invalid bounding box: " + std::string(bbox));
+  }
+  if (minLon < -180 || maxLon > 180 || minLat < -90 || maxLat > 90 ||
+      minLon > maxLon || minLat > maxLat) {
+    throw std::invalid_argument("Invalid bounding box: " + std::string(bbox));
+  }
+  ClipRegion region;
+  region._envelope = osmium::Box{minLon, minLat, maxLon, maxLat};
+  return region;
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::ClipRegion osm2rdf::osm::ClipRegion::fromPolyFile(
+    const std::filesystem::path& path) {
+  std::ifstream ifs{path};
+  if (!ifs) {
+    throw std::runtime_error("Can't open polygon file " + path.string());
+  }
+  ClipRegion region;
+  std::vector<osmium::Location> ring;
+  std::string line;
+  // The first line holds the name of the polygon.
+  std::getline(ifs, line);
+  bool inSection = false;
+  bool done = false;
+  while (!done && std::getline(ifs, line)) {
+    std::istringstream iss{line};
+    std::string first;
+    if (!(iss >> first)) {
+      continue;
+    }
+    if (first == "END") {
+      if (inSection) {
+        region.addRing(ring);
+        ring.clear();
+        inSection = false;
+      } else {
+        done = true;
+      }
+    } else if (!inSection) {
+      // Section name, holes are handled by the even-odd rule.
+      inSection = true;
+    } else {
+      std::istringstream coordinates{line};
+      double lon;
+      double lat;
+      if (!(coordinates >> lon >> lat) || lon < -180 || lon > 180 ||
+          lat < -90 || lat > 90) {
+        throw std::runtime_error("Invalid coordinate in polygon file " +
+                                 path.string() + ": " + line);
+      }
+      ring.emplace_back(lon, lat);
+    }
+  }
+  if (!done || region._edges.empty()) {
+    throw std::runtime_error("Invalid polygon file " + path.string());
+  }
+  region.buildBands();
+  return region;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipRegion::addRing(
+    const std::vector<osmium::Location>& ring) {
+  for (size_t i = 0; i < ring.size(); ++i) {
+    const auto& a = ring[i];
+    const auto& b = ring[(i + 1) % ring.size()];
+    _envelope.extend(a);
+    if (a.y() == b.y()) {
+      // Horizontal edges never cross a horizontal ray.
+      continue;
+    }
+    if (a.y() < b.y()) {
+      _edges.push_back(Edge{a.x(), a.y(), b.x(), b.y()});
+    } else {
+      _edges.push_back(Edge{b.x(), b.y(), a.x(), a.y()});
+    }
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ClipRegion::buildBands() {
+  const int64_t minY = _envelope.bottom_left().y();
+  const int64_t height =
+      static_cast<int64_t>(_envelope.top_right().y()) - minY + 1;
+  const auto numBands =
+      static_cast<int64_t>(std::clamp<size_t>(_edges.size(), 1, MAX_BANDS));
+  _bandHeight = (height + numBands - 1) / numBands;
+  _bands.assign(numBands, {});
+  for (const auto& edge : _edges) {
+    const int64_t first = (edge.y1 - minY) / _bandHeight;
+    const int64_t last = (edge.y2 - minY) / _bandHeight;
+    for (int64_t band = first; band <= last; ++band) {
+      _bands[band].push_back(edge);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::ClipRegion::contains(
+    const osmium::Location& location) const noexcept {
+  if (!location.valid() || !_envelope.contains(location)) {
+    return false;
+  }
+  if (_bands.empty()) {
+    return true;
+  }
+  // Count crossings of a ray from location to the east, only edges in the
+  // band of the location can cross it.
+  const int64_t x = location.x();
+  const int64_t y = location.y();
+  const auto& band = _bands[(y - _envelope.bottom_left().y()) / _bandHeight];
+  bool inside = false;
+  for (const auto& edge : band) {
+    if (y < edge.y1 || y >= edge.y2) {
+      continue;
+    }
+    // Position of the location relative to the upward edge, positive if it
+    // is left of the edge and therefore west of the crossing.
+    const int64_t cross =
+        (static_cast<int64_t>(edge.x2) - edge.x1) * (y - edge.y1) -
+        (x - edge.x1) * (static_cast<int64_t>(edge.y2) - edge.y1);
+    if (cross > 0) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
@@ -0,0 +1,219 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/CompressedLocationIndex.h"
+
+#include <atomic>
+#include <cstring>
+
+static const size_t BLOCK_CACHE_SIZE = 8;
+static const size_t BLOCK_SIZE =
+    osm2rdf::osm::CompressedLocationIndex::kBlockSize;
+static const size_t BITMAP_BYTES = BLOCK_SIZE / 8;
+// Bitmap and two varints of at most 5 bytes for each entry.
+static const size_t MAX_ENCODED_BLOCK_SIZE = BITMAP_BYTES + BLOCK_SIZE * 10;
+
+static std::atomic<uint64_t> nextInstance{0};
+
+// Decoded blocks of the last lookups of this thread.
+struct CachedBlock {
+  uint64_t instance = ~0ULL;
+  uint64_t generation = 0;
+  size_t blockIndex = 0;
+  std::array<osmium::Location, BLOCK_SIZE> locations;
+};
+static thread_local std::array<CachedBlock, BLOCK_CACHE_SIZE> blockCache;
+
+// ____________________________________________________________________________
+static uint8_t* writeVarint(uint8_t* out, int32_t value) {
+  // zigzag encoding keeps small negative deltas short.
+  auto zigzag = (static_cast<uint32_t>(value) << 1) ^
+                static_cast<uint32_t>(value >> 31);
+  while (zigzag >= 0x80) {
+    *out++ = static_cast<uint8_t>(zigzag | 0x80);
+    zigzag >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(zigzag);
+  return out;
+}
+
+// ____________________________________________________________________________
+static const uint8_t* readVarint(const uint8_t* in, int32_t* value) {
+  uint32_t zigzag = 0;
+  for (int shift = 0;; shift += 7) {
+    const uint8_t byte = *in++;
+    zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+  *value = static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+  return in;
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::CompressedLocationIndex::CompressedLocationIndex(
+    size_t minNodeId, size_t maxNodeId)
+    : _offset(minNodeId),
+      // No nodes were counted if minNodeId > maxNodeId.
+      _size(minNodeId <= maxNodeId ? maxNodeId - minNodeId + 1 : 0),
+      _instance(nextInstance++),
+      _blockOffsets((_size + kBlockSize - 1) / kBlockSize, kNoBlock) {}
+
+// ____________________________________________________________________________
+size_t osm2rdf::osm::CompressedLocationIndex::used_memory() const noexcept {
+  return sizeof(CompressedLocationIndex) +
+         _blockOffsets.size() * sizeof(uint64_t) + _chunks.size() * kChunkSize;
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::osm::CompressedLocationIndex::store(const Block& block) {
+  uint8_t buffer[MAX_ENCODED_BLOCK_SIZE] = {};
+  uint8_t* out = buffer + BITMAP_BYTES;
+  int32_t lastX = 0;
+  int32_t lastY = 0;
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    if (!block[i].is_defined()) {
+      continue;
+    }
+    buffer[i / 8] |= 1 << (i % 8);
+    // Deltas wrap around for extreme values, decoding wraps back.
+    out = writeVarint(out, static_cast<int32_t>(
+                               static_cast<uint32_t>(block[i].x()) -
+                               static_cast<uint32_t>(lastX)));
+    out = writeVarint(out, static_cast<int32_t>(
+                               static_cast<uint32_t>(block[i].y()) -
+                               static_cast<uint32_t>(lastY)));
+    lastX = block[i].x();
+    lastY = block[i].y();
+  }
+  const size_t length = out - buffer;
+  if (_chunkUsed + length > kChunkSize) {
+    // Blocks never span chunks.
+    _chunks.emplace_back(new uint8_t[kChunkSize]);
+    _chunkUsed = 0;
+  }
+  const uint64_t offset = (_chunks.size() - 1) * kChunkSize + _chunkUsed;
+  std::memcpy(_chunks.back().get() + _chunkUsed, buffer, length);
+  _chunkUsed += length;
+  return offset;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CompressedLocationIndex::load(size_t blockIndex,
+                                                 Block* block) const {
+  block->fill(osmium::Location{});
+  if (blockIndex == _openBlockIndex) {
+    *block = _openBlock;
+    return;
+  }
+  const uint64_t offset = _blockOffsets[blockIndex];
+  if (offset == kNoBlock) {
+    return;
+  }
+  const uint8_t* bitmap =
+      _chunks[offset / kChunkSize].get() + offset % kChunkSize;
+  const uint8_t* in = bitmap + BITMAP_BYTES;
+  int32_t x = 0;
+  int32_t y = 0;
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    if ((bitmap[i / 8] & (1 << (i % 8))) == 0) {
+      continue;
+    }
+    int32_t dx;
+    int32_t dy;
+    in = readVarint(in, &dx);
+    in = readVarint(in, &dy);
+    x = static_cast<int32_t>(static_cast<uint32_t>(x) +
+                             static_cast<uint32_t>(dx));
+    y = static_cast<int32_t>(static_cast<uint32_t>(y) +
+                             static_cast<uint32_t>(dy));
+    (*block)[i] = osmium::Location{x, y};
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CompressedLocationIndex::closeBlock() {
+  if (_openBlockIndex == kNoBlock) {
+    return;
+  }
+  _blockOffsets[_openBlockIndex] = store(_openBlock);
+  _openBlockIndex = kNoBlock;
+  // Cached copies of this block may be outdated.
+  _generation++;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CompressedLocationIndex::set(
+    const osmium::unsigned_object_id_type id, const osmium::Location value) {
+  if (id < _offset || id - _offset >= _size) {
+    return;
+  }
+  const size_t pos = id - _offset;
+  const size_t blockIndex = pos >> kBlockBits;
+  if (blockIndex != _openBlockIndex) {
+    closeBlock();
+    // Reopen a stored block for unsorted input, the old encoding is dropped.
+    load(blockIndex, &_openBlock);
+    _blockOffsets[blockIndex] = kNoBlock;
+    _openBlockIndex = blockIndex;
+  }
+  _openBlock[pos & (kBlockSize - 1)] = value;
+}
+
+// ____________________________________________________________________________
+osmium::Location osm2rdf::osm::CompressedLocationIndex::get_noexcept(
+    const osmium::unsigned_object_id_type id) const noexcept {
+  if (id < _offset || id - _offset >= _size) {
+    return osmium::Location{};
+  }
+  const size_t pos = id - _offset;
+  const size_t blockIndex = pos >> kBlockBits;
+  if (blockIndex == _openBlockIndex) {
+    return _openBlock[pos & (kBlockSize - 1)];
+  }
+  auto& cached = blockCache[blockIndex % BLOCK_CACHE_SIZE];
+  if (cached.instance != _instance || cached.generation != _generation ||
+      cached.blockIndex != blockIndex) {
+    load(blockIndex, &cached.locations);
+    cached.instance = _instance;
+    cached.generation = _generation;
+    cached.blockIndex = blockIndex;
+  }
+  return cached.locations[pos & (kBlockSize - 1)];
+}
+
+// ____________________________________________________________________________
+osmium::Location osm2rdf::osm::CompressedLocationIndex::get(
+    const osmium::unsigned_object_id_type id) const {
+  const auto value = get_noexcept(id);
+  if (value == osmium::index::empty_value<osmium::Location>()) {
+    throw osmium::not_found{id};
+  }
+  return value;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CompressedLocationIndex::clear() {
+  _blockOffsets.clear();
+  _blockOffsets.shrink_to_fit();
+  _chunks.clear();
+  _chunkUsed = kChunkSize;
+  _openBlockIndex = kNoBlock;
+  _generation++;
+}
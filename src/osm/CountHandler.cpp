@@ -16,18 +16,107 @@
 // You should have received a copy of the GNU General Public License
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 #include "osm2rdf/osm/CountHandler.h"
 
 // ____________________________________________________________________________
 void osm2rdf::osm::CountHandler::prepare_for_lookup() { _firstPassDone = true; }
 
+// ____________________________________________________________________________
+void osm2rdf::osm::CountHandler::countNodes(size_t numNodes,
+                                            size_t numTaggedNodes,
+                                            size_t minNodeId,
+                                            size_t maxNodeId) {
+  if (minNodeId > maxNodeId) {
+    return;
+  }
+  _minId = std::min(_minId, minNodeId);
+  _maxId = std::max(_maxId, maxNodeId);
+  if (_firstPassDone) {
+    return;
+  }
+  _numNodes += _config.addUntaggedNodes ? numNodes : numTaggedNodes;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CountHandler::merge(const CountHandler& other) {
+  _numNodes += other._numNodes;
+  _numRelations += other._numRelations;
+  _numWays += other._numWays;
+  _minId = std::min(_minId, other._minId);
+  _maxId = std::max(_maxId, other._maxId);
+  _requiredNodes.merge(other._requiredNodes);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CountHandler::bufferRequiredNodes() {
+  _bufferRequiredNodes = true;
+}
+
+// ____________________________________________________________________________
+size_t osm2rdf::osm::CountHandler::numBufferedRequiredNodes() const {
+  return _requiredNodeIds.size();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CountHandler::flushRequiredNodes(
+    osm2rdf::util::RankBitVector* target) {
+  // Sorted ids touch each word of target only once.
+  std::sort(_requiredNodeIds.begin(), _requiredNodeIds.end());
+  for (const auto id : _requiredNodeIds) {
+    target->set(id);
+  }
+  _requiredNodeIds.clear();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CountHandler::addRequiredNode(uint64_t id) {
+  if (_bufferRequiredNodes) {
+    _requiredNodeIds.push_back(id);
+  } else {
+    _requiredNodes.set(id);
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CountHandler::restrictToShard(
+    std::vector<uint64_t> relationIds, std::vector<uint64_t> wayIds) {
+  _shardRelationIds =
+      std::make_shared<const std::vector<uint64_t>>(std::move(relationIds));
+  _shardWayIds =
+      std::make_shared<const std::vector<uint64_t>>(std::move(wayIds));
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::CountHandler::requiresMembers(
+    uint64_t id, const std::vector<uint64_t>* ids) const {
+  return ids == nullptr || _config.isInShard(id) ||
+         std::binary_search(ids->begin(), ids->end(), id);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::CountHandler::restore(
+    size_t numNodes, size_t numRelations, size_t numWays, size_t minNodeId,
+    size_t maxNodeId, osm2rdf::util::RankBitVector requiredNodes) {
+  _numNodes = numNodes;
+  _numRelations = numRelations;
+  _numWays = numWays;
+  _minId = minNodeId;
+  _maxId = maxNodeId;
+  _requiredNodes = std::move(requiredNodes);
+  _firstPassDone = true;
+}
+
 // ____________________________________________________________________________
 void osm2rdf::osm::CountHandler::node(const osmium::Node& node) {
   if (node.positive_id() < _minId) _minId = node.positive_id();
   if (node.positive_id() > _maxId) _maxId = node.positive_id();
-  if (_firstPassDone || (!_config.addUntaggedNodes && node.tags().empty())) {
+  if (_firstPassDone || (!_config.addUntaggedNodes && node.tags().empty()) ||
+      !_tagFilter.matches(node.tags()) ||
+      !_config.isInShard(node.positive_id())) {
     return;
   }
   _numNodes++;
@@ -35,7 +124,17 @@ void osm2rdf::osm::CountHandler::node(const osmium::Node& node) {
 
 // ____________________________________________________________________________
 void osm2rdf::osm::CountHandler::relation(const osmium::Relation& rel) {
-  if (_firstPassDone || (!_config.addUntaggedRelations && rel.tags().empty())) {
+  if (_collectRequiredNodes && !_firstPassDone &&
+      requiresMembers(rel.positive_id(), _shardRelationIds.get())) {
+    for (const auto& member : rel.members()) {
+      if (member.type() == osmium::item_type::node) {
+        addRequiredNode(member.positive_ref());
+      }
+    }
+  }
+  if (_firstPassDone || (!_config.addUntaggedRelations && rel.tags().empty()) ||
+      !_tagFilter.matches(rel.tags()) ||
+      !_config.isInShard(rel.positive_id())) {
     return;
   }
   _numRelations++;
@@ -43,7 +142,15 @@ void osm2rdf::osm::CountHandler::relation(const osmium::Relation& rel) {
 
 // ____________________________________________________________________________
 void osm2rdf::osm::CountHandler::way(const osmium::Way& way) {
-  if (_firstPassDone || (!_config.addUntaggedWays && way.tags().empty())) {
+  if (_collectRequiredNodes && !_firstPassDone &&
+      requiresMembers(way.positive_id(), _shardWayIds.get())) {
+    for (const auto& nodeRef : way.nodes()) {
+      addRequiredNode(nodeRef.positive_ref());
+    }
+  }
+  if (_firstPassDone || (!_config.addUntaggedWays && way.tags().empty()) ||
+      !_tagFilter.matches(way.tags()) ||
+      !_config.isInShard(way.positive_id())) {
     return;
   }
   _numWays++;
@@ -80,19 +80,36 @@ using osm2rdf::ttl::constants::NODE_NAMESPACE;
 using osm2rdf::ttl::constants::RELATION_NAMESPACE;
 using osm2rdf::ttl::constants::WAY_NAMESPACE;
 
+// Reused for the IRIs and literals written for each object instead of
+// allocating new strings. Objects are handled by several threads at once.
+static thread_local std::string subjectBuffer;
+static thread_local std::string objectBuffer;
+static thread_local std::string literalBuffer;
+
 // ____________________________________________________________________________
 template <typename W>
 osm2rdf::osm::FactHandler<W>::FactHandler(const osm2rdf::config::Config& config,
                                           osm2rdf::ttl::Writer<W>* writer)
-    : _config(config), _writer(writer) {}
+    : _config(config),
+      _writer(writer),
+      _doubleSuffix("^^" + IRI__XSD_DOUBLE),
+      _decimalSuffix("^^" + IRI__XSD_DECIMAL),
+      _integerSuffix("^^" + IRI__XSD_INTEGER),
+      _wktSuffix("^^" + IRI__GEOSPARQL__WKT_LITERAL),
+      _areaIRI(writer->generateIRIUnsafe(NAMESPACE__OSM2RDF, "area")),
+      _completeGeometryIRI(
+          writer->generateIRIUnsafe(NAMESPACE__OSM2RDF, "completeGeometry")),
+      _memberIRI(
+          writer->generateIRIUnsafe(NAMESPACE__OSM_RELATION, "member")) {}
 
 // ____________________________________________________________________________
 template <typename W>
 void osm2rdf::osm::FactHandler<W>::area(const osm2rdf::osm::Area& area) {
-  const std::string& subj = _writer->generateIRI(
+  const std::string& subj = subjectBuffer;
+  _writer->generateIRI(
       area.fromWay() ? WAY_NAMESPACE[_config.sourceDataset]
                      : RELATION_NAMESPACE[_config.sourceDataset],
-      area.objId());
+      area.objId(), &subjectBuffer);
 
   const std::string& geomObj = _writer->generateIRIUnsafe(
       NAMESPACE__OSM2RDF_GEOM, DATASET_ID[_config.sourceDataset] + "_" +
@@ -102,9 +119,10 @@ void osm2rdf::osm::FactHandler<W>::area(const osm2rdf::osm::Area& area) {
   _writer->writeTriple(subj, IRI__GEOSPARQL__HAS_GEOMETRY, geomObj);
 
   if (area.geom().size() == 1) {
-    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, area.geom()[0]);
+    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, area.geom()[0],
+                  area.length());
   } else {
-    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, area.geom());
+    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, area.geom(), area.length());
   }
 
   if (_config.addCentroids) {
@@ -122,16 +140,16 @@ void osm2rdf::osm::FactHandler<W>::area(const osm2rdf::osm::Area& area) {
   // Increase default precision as areas in regbez freiburg have a 0 area
   // otherwise.
   _writer->writeLiteralTripleUnsafe(
-      subj, _writer->generateIRIUnsafe(NAMESPACE__OSM2RDF, "area"),
-      ::util::formatFloat(area.geomArea(), AREA_PRECISION),
-      "^^" + IRI__XSD_DOUBLE);
+      subj, _areaIRI, ::util::formatFloat(area.geomArea(), AREA_PRECISION),
+      _doubleSuffix);
 }
 
 // ____________________________________________________________________________
 template <typename W>
 void osm2rdf::osm::FactHandler<W>::node(const osm2rdf::osm::Node& node) {
-  const std::string& subj = _writer->generateIRI(
-      NODE_NAMESPACE[_config.sourceDataset], node.id());
+  const std::string& subj = subjectBuffer;
+  _writer->generateIRI(NODE_NAMESPACE[_config.sourceDataset], node.id(),
+                       &subjectBuffer);
 
   _writer->writeTriple(subj, IRI__RDF_TYPE, IRI__OSM_NODE);
 
@@ -158,18 +176,19 @@ void osm2rdf::osm::FactHandler<W>::node(const osm2rdf::osm::Node& node) {
   const auto& hullWKT = ::util::geo::getWKT(::util::geo::DPolygon{{node.geom()},{}}, _config.wktPrecision);
 
   _writer->writeLiteralTripleUnsafe(subj, IRI__OSM2RDF_GEOM__CONVEX_HULL, hullWKT,
-      "^^" + IRI__GEOSPARQL__WKT_LITERAL);
+      _wktSuffix);
   writeBox(subj, IRI__OSM2RDF_GEOM__ENVELOPE, ::util::geo::DBox{node.geom(), node.geom()});
   _writer->writeLiteralTripleUnsafe(subj, IRI__OSM2RDF_GEOM__OBB, hullWKT,
-      "^^" + IRI__GEOSPARQL__WKT_LITERAL);
+      _wktSuffix);
 }
 
 // ____________________________________________________________________________
 template <typename W>
 void osm2rdf::osm::FactHandler<W>::relation(
     const osm2rdf::osm::Relation& relation) {
-  const std::string& subj = _writer->generateIRI(
-      RELATION_NAMESPACE[_config.sourceDataset], relation.id());
+  const std::string& subj = subjectBuffer;
+  _writer->generateIRI(RELATION_NAMESPACE[_config.sourceDataset], relation.id(),
+                       &subjectBuffer);
 
   _writer->writeTriple(subj, IRI__RDF_TYPE, IRI__OSM_RELATION);
 
@@ -193,19 +212,17 @@ void osm2rdf::osm::FactHandler<W>::relation(
         continue;
     }
 
-    const std::string& role = member.role();
+    const std::string_view role = member.role();
     const std::string& blankNode = _writer->generateBlankNode();
-    _writer->writeTriple(
-        subj, _writer->generateIRIUnsafe(NAMESPACE__OSM_RELATION, "member"),
-        blankNode);
+    _writer->writeTriple(subj, _memberIRI, blankNode);
 
-    _writer->writeTriple(blankNode, IRI__OSM2RDF_MEMBER__ID,
-                         _writer->generateIRI(type, member.id()));
-    _writer->writeTriple(blankNode, IRI__OSM2RDF_MEMBER__ROLE,
-                         _writer->generateLiteral(role));
+    _writer->generateIRI(type, member.id(), &objectBuffer);
+    _writer->writeTriple(blankNode, IRI__OSM2RDF_MEMBER__ID, objectBuffer);
+    _writer->generateLiteral(role, &literalBuffer);
+    _writer->writeTriple(blankNode, IRI__OSM2RDF_MEMBER__ROLE, literalBuffer);
     _writer->writeLiteralTripleUnsafe(blankNode, IRI__OSM2RDF_MEMBER__POS,
                                       std::to_string(inRelPos++),
-                                      "^^" + IRI__XSD_INTEGER);
+                                      _integerSuffix);
   }
 
   if (relation.hasGeometry()) {
@@ -215,7 +232,8 @@ void osm2rdf::osm::FactHandler<W>::relation(
                                      std::to_string(relation.id()));
 
     _writer->writeTriple(subj, IRI__GEOSPARQL__HAS_GEOMETRY, geomObj);
-    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, relation.geom());
+    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, relation.geom(),
+                  relation.length());
 
     if (_config.addCentroids) {
       const std::string& centroidObj = _writer->generateIRIUnsafe(
@@ -231,8 +249,7 @@ void osm2rdf::osm::FactHandler<W>::relation(
     writeGeometry(subj, IRI__OSM2RDF_GEOM__OBB, relation.orientedBoundingBox());
 
     _writer->writeTriple(
-        subj,
-        _writer->generateIRIUnsafe(NAMESPACE__OSM2RDF, "completeGeometry"),
+        subj, _completeGeometryIRI,
         relation.hasCompleteGeometry() ? osm2rdf::ttl::constants::LITERAL__YES
                                        : osm2rdf::ttl::constants::LITERAL__NO);
   }
@@ -241,8 +258,9 @@ void osm2rdf::osm::FactHandler<W>::relation(
 // ____________________________________________________________________________
 template <typename W>
 void osm2rdf::osm::FactHandler<W>::way(const osm2rdf::osm::Way& way) {
-  const std::string& subj =
-      _writer->generateIRI(WAY_NAMESPACE[_config.sourceDataset], way.id());
+  const std::string& subj = subjectBuffer;
+  _writer->generateIRI(WAY_NAMESPACE[_config.sourceDataset], way.id(),
+                       &subjectBuffer);
 
   _writer->writeTriple(subj, IRI__RDF_TYPE, IRI__OSM_WAY);
 
@@ -252,57 +270,55 @@ void osm2rdf::osm::FactHandler<W>::way(const osm2rdf::osm::Way& way) {
   if (_config.addWayNodeOrder && way.nodes().size()) {
     size_t wayOrder = 0;
     std::string lastBlankNode;
-    auto lastNode = way.nodes().front();
+    osmium::NodeRef lastNode = way.nodes().front();
     for (const auto& node : way.nodes()) {
       const std::string& blankNode = _writer->generateBlankNode();
       _writer->writeTriple(subj, IRI__OSMWAY_NODE, blankNode);
 
-      _writer->writeTriple(
-          blankNode, osm2rdf::ttl::constants::IRI__OSMWAY_NODE,
-          _writer->generateIRI(NODE_NAMESPACE[_config.sourceDataset],
-                               node.id()));
+      _writer->generateIRI(NODE_NAMESPACE[_config.sourceDataset],
+                           node.positive_ref(), &objectBuffer);
+      _writer->writeTriple(blankNode, osm2rdf::ttl::constants::IRI__OSMWAY_NODE,
+                           objectBuffer);
 
       _writer->writeLiteralTripleUnsafe(blankNode, IRI__OSM2RDF_MEMBER__POS,
                                         std::to_string(wayOrder++),
-                                        "^^" + IRI__XSD_INTEGER);
+                                        _integerSuffix);
 
       if (_config.addWayNodeSpatialMetadata && !lastBlankNode.empty()) {
-        _writer->writeTriple(
-            lastBlankNode, IRI__OSMWAY_NEXT_NODE,
-            _writer->generateIRI(NODE_NAMESPACE[_config.sourceDataset],
-                                 node.id()));
+        _writer->writeTriple(lastBlankNode, IRI__OSMWAY_NEXT_NODE,
+                             objectBuffer);
         // Haversine distance
         const double distanceLat =
-            (node.geom().getY() - lastNode.geom().getY()) *
+            (node.lat() - lastNode.lat()) *
             osm2rdf::osm::constants::DEGREE;
         const double distanceLon =
-            (node.geom().getX() - lastNode.geom().getX()) *
+            (node.lon() - lastNode.lon()) *
             osm2rdf::osm::constants::DEGREE;
         const double haversine =
             (sin(distanceLat / 2) * sin(distanceLat / 2)) +
             (sin(distanceLon / 2) * sin(distanceLon / 2) *
-             cos(lastNode.geom().getY() * osm2rdf::osm::constants::DEGREE) *
-             cos(node.geom().getY() * osm2rdf::osm::constants::DEGREE));
+             cos(lastNode.lat() * osm2rdf::osm::constants::DEGREE) *
+             cos(node.lat() * osm2rdf::osm::constants::DEGREE));
         const double distance = osm2rdf::osm::constants::EARTH_RADIUS_KM *
                                 osm2rdf::osm::constants::METERS_IN_KM * 2 *
                                 asin(sqrt(haversine));
         _writer->writeLiteralTripleUnsafe(
             lastBlankNode, IRI__OSMWAY_NEXT_NODE_DISTANCE,
-            std::to_string(distance), "^^" + IRI__XSD_DECIMAL);
+            std::to_string(distance), _decimalSuffix);
       }
       lastBlankNode = blankNode;
       lastNode = node;
     }
   }
 
-  size_t numUniquePoints = way.geom().size();
+  size_t numUniquePoints = way.fixedGeom().size();
 
   if (_config.addAreaWayLinestrings || !way.isArea()) {
     const std::string& geomObj = _writer->generateIRIUnsafe(
         NAMESPACE__OSM2RDF, "way_" + std::to_string(way.id()));
 
     _writer->writeTriple(subj, IRI__GEOSPARQL__HAS_GEOMETRY, geomObj);
-    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, way.geom());
+    writeGeometry(geomObj, IRI__GEOSPARQL__AS_WKT, way.geom(), way.length());
   }
 
   if (!way.isArea()) {
@@ -326,15 +342,15 @@ void osm2rdf::osm::FactHandler<W>::way(const osm2rdf::osm::Way& way) {
                          way.closed() ? LITERAL__YES : LITERAL__NO);
     _writer->writeLiteralTripleUnsafe(subj, IRI__OSMWAY_NODE_COUNT,
                                       std::to_string(way.nodes().size()),
-                                      "^^" + IRI__XSD_INTEGER);
+                                      _integerSuffix);
     _writer->writeLiteralTripleUnsafe(subj, IRI__OSMWAY_UNIQUE_NODE_COUNT,
                                       std::to_string(numUniquePoints),
-                                      "^^" + IRI__XSD_INTEGER);
+                                      _integerSuffix);
   }
 
-  _writer->writeLiteralTripleUnsafe(
-      subj, IRI__OSM2RDF__LENGTH, std::to_string(::util::geo::len(way.geom())),
-      "^^" + osm2rdf::ttl::constants::IRI__XSD_DOUBLE);
+  _writer->writeLiteralTripleUnsafe(subj, IRI__OSM2RDF__LENGTH,
+                                    std::to_string(way.length()),
+                                    _doubleSuffix);
 }
 
 // ____________________________________________________________________________
@@ -343,10 +359,22 @@ template <typename G>
 void osm2rdf::osm::FactHandler<W>::writeGeometry(const std::string& subj,
                                                  const std::string& pred,
                                                  const G& geom) {
+  // The length is only needed for simplification.
+  const bool simplify = _config.simplifyWKT > 0 &&
+                        ::util::geo::numPoints(geom) > _config.simplifyWKT;
+  writeGeometry(subj, pred, geom, simplify ? ::util::geo::len(geom) : 0);
+}
+
+// ____________________________________________________________________________
+template <typename W>
+template <typename G>
+void osm2rdf::osm::FactHandler<W>::writeGeometry(const std::string& subj,
+                                                 const std::string& pred,
+                                                 const G& geom, double length) {
   if (_config.simplifyWKT > 0 &&
       ::util::geo::numPoints(geom) > _config.simplifyWKT) {
     G simplifiedGeom;
-    auto perimeter_or_length = ::util::geo::len(geom);
+    auto perimeter_or_length = length;
     do {
       simplifiedGeom = ::util::geo::simplify(geom, BASE_SIMPLIFICATION_FACTOR *
                                                        perimeter_or_length *
@@ -356,11 +384,11 @@ void osm2rdf::osm::FactHandler<W>::writeGeometry(const std::string& subj,
              perimeter_or_length >= BASE_SIMPLIFICATION_FACTOR);
     _writer->writeLiteralTripleUnsafe(
         subj, pred, ::util::geo::getWKT(simplifiedGeom, _config.wktPrecision),
-        "^^" + IRI__GEOSPARQL__WKT_LITERAL);
+        _wktSuffix);
   } else {
     _writer->writeLiteralTripleUnsafe(
         subj, pred, ::util::geo::getWKT(geom, _config.wktPrecision),
-        "^^" + IRI__GEOSPARQL__WKT_LITERAL);
+        _wktSuffix);
   }
 }
 
@@ -371,23 +399,20 @@ void osm2rdf::osm::FactHandler<W>::writeBox(
     const ::util::geo::Box<double>& box) {
   // Box can not be simplified -> output directly.
   _writer->writeLiteralTripleUnsafe(
-      subj, pred, ::util::geo::getWKT(box, _config.wktPrecision),
-      "^^" + IRI__GEOSPARQL__WKT_LITERAL);
+      subj, pred, ::util::geo::getWKT(box, _config.wktPrecision), _wktSuffix);
 }
 
 // ____________________________________________________________________________
 template <typename W>
 void osm2rdf::osm::FactHandler<W>::writeTag(const std::string& subj,
                                             const osm2rdf::osm::Tag& tag) {
-  const std::string& key = tag.first;
-  const std::string& value = tag.second;
+  const std::string_view key = tag.first;
+  const std::string_view value = tag.second;
   if (key == "admin_level") {
-    std::string rTrimmed;
-
     // right trim, left trim is done by strtoll
     auto end = std::find_if(value.rbegin(), value.rend(),
                             [](int c) { return std::isspace(c) == 0; });
-    rTrimmed = value.substr(0, end.base() - value.begin());
+    const std::string rTrimmed{value.substr(0, end.base() - value.begin())};
 
     char* firstNonMatched;
     int64_t lvl = strtoll(rTrimmed.c_str(), &firstNonMatched,
@@ -397,8 +422,7 @@ void osm2rdf::osm::FactHandler<W>::writeTag(const std::string& subj,
     if (firstNonMatched != rTrimmed.c_str() && (*firstNonMatched) == 0) {
       _writer->writeTriple(
           subj, _writer->generateIRIUnsafe(NAMESPACE__OSM_TAG, key),
-          _writer->generateLiteralUnsafe(std::to_string(lvl),
-                                         "^^" + IRI__XSD_INTEGER));
+          _writer->generateLiteralUnsafe(std::to_string(lvl), _integerSuffix));
     } else {
       _writer->writeUnsafeIRILiteralTriple(subj, NAMESPACE__OSM_TAG, key, value);
     }
@@ -427,25 +451,33 @@ template <typename W>
 void osm2rdf::osm::FactHandler<W>::writeTagList(
     const std::string& subj, const osm2rdf::osm::TagList& tags) {
   size_t tagTripleCount = 0;
+  std::string normalizedKey;
   for (const auto& tag : tags) {
-    const std::string& key = tag.first;
-    const std::string& value = tag.second;
+    std::string_view key = tag.first;
+    const std::string_view value = tag.second;
+    // Tags point into the osmium buffer, only keys containing spaces are
+    // copied.
+    if (key.find(' ') != std::string_view::npos) {
+      normalizedKey = key;
+      std::replace(normalizedKey.begin(), normalizedKey.end(), ' ', '_');
+      key = normalizedKey;
+    }
     // Special handling for ref tag splitting. Maybe generalize this...
-    if (_config.semicolonTagKeys.find(key) != _config.semicolonTagKeys.end() &&
-        value.find(';') != std::string::npos) {
+    if (value.find(';') != std::string_view::npos &&
+        _config.semicolonTagKeys.find(std::string{key}) !=
+            _config.semicolonTagKeys.end()) {
       size_t end;
       size_t start = 0;
-      while ((end = value.find(';', start)) != std::string::npos) {
-        const std::string& partialValue = value.substr(start, (end - start));
-        writeTag(subj, osm2rdf::osm::Tag(key, partialValue));
+      while ((end = value.find(';', start)) != std::string_view::npos) {
+        writeTag(subj,
+                 osm2rdf::osm::Tag(key, value.substr(start, end - start)));
         tagTripleCount++;
         start = end + 1;
       };
-      const std::string& partialValue = value.substr(start, value.size());
-      writeTag(subj, osm2rdf::osm::Tag(key, partialValue));
+      writeTag(subj, osm2rdf::osm::Tag(key, value.substr(start)));
       tagTripleCount++;
     } else {
-      writeTag(subj, tag);
+      writeTag(subj, osm2rdf::osm::Tag(key, value));
       tagTripleCount++;
     }
 
@@ -453,7 +485,7 @@ void osm2rdf::osm::FactHandler<W>::writeTagList(
     if (!_config.skipWikiLinks &&
         (key == "wikidata" || hasSuffix(key, ":wikidata"))) {
       // Only take first wikidata entry if ; is found
-      std::string valueTmp = value;
+      std::string valueTmp{value};
       const auto end = valueTmp.find(';');
       if (end != std::string::npos) {
         valueTmp = valueTmp.erase(end);
@@ -472,9 +504,9 @@ void osm2rdf::osm::FactHandler<W>::writeTagList(
     if (!_config.skipWikiLinks &&
         (key == "wikipedia" || hasSuffix(key, ":wikipedia"))) {
       const auto pos = value.find(':');
-      if (pos != std::string::npos) {
-        const std::string& lang = value.substr(0, pos);
-        const std::string& entry = value.substr(pos + 1);
+      if (pos != std::string_view::npos) {
+        const std::string lang{value.substr(0, pos)};
+        const std::string_view entry = value.substr(pos + 1);
         _writer->writeTriple(
             subj, _writer->generateIRI(NAMESPACE__OSM2RDF_TAG, key),
             _writer->generateIRI("https://" + lang + ".wikipedia.org/wiki/",
@@ -519,7 +551,8 @@ void osm2rdf::osm::FactHandler<W>::writeTagList(
           last = next + 1;
           continue;
         }
-        auto val = std::atoi(value.substr(last, next - last).c_str());
+        auto val =
+            std::atoi(std::string{value.substr(last, next - last)}.c_str());
 
         // basic validity checks according to ISO 8601
         if (resultType == 1 && (val < 1 || val > 12)) {
@@ -554,7 +587,7 @@ void osm2rdf::osm::FactHandler<W>::writeTagList(
   _writer->writeTriple(
       subj, _writer->generateIRIUnsafe(NAMESPACE__OSM2RDF, "facts"),
       _writer->generateLiteralUnsafe(std::to_string(tagTripleCount),
-                                     "^^" + IRI__XSD_INTEGER));
+                                     _integerSuffix));
 }
 
 // ____________________________________________________________________________
@@ -572,15 +605,26 @@ void osm2rdf::osm::FactHandler<W>::writeSecondsAsISO(const std::string& subj,
 
 // ____________________________________________________________________________
 template <typename W>
-bool osm2rdf::osm::FactHandler<W>::hasSuffix(const std::string& subj,
-                                             const std::string& suffix) const {
+bool osm2rdf::osm::FactHandler<W>::hasSuffix(std::string_view subj,
+                                             std::string_view suffix) const {
   if (subj.size() < suffix.size()) {
     return false;
   }
-  return strcmp(subj.c_str() + subj.size() - suffix.size(), suffix.c_str()) ==
-         0;
+  return subj.substr(subj.size() - suffix.size()) == suffix;
 }
 
+// ____________________________________________________________________________
+// Ways pass their length, instantiate the plain variant for lines as well.
+template void
+osm2rdf::osm::FactHandler<osm2rdf::ttl::format::NT>::writeGeometry(
+    const std::string& s, const std::string& p, const ::util::geo::DLine& g);
+template void
+osm2rdf::osm::FactHandler<osm2rdf::ttl::format::TTL>::writeGeometry(
+    const std::string& s, const std::string& p, const ::util::geo::DLine& g);
+template void
+osm2rdf::osm::FactHandler<osm2rdf::ttl::format::QLEVER>::writeGeometry(
+    const std::string& s, const std::string& p, const ::util::geo::DLine& g);
+
 // ____________________________________________________________________________
 template class osm2rdf::osm::FactHandler<osm2rdf::ttl::format::NT>;
 template class osm2rdf::osm::FactHandler<osm2rdf::ttl::format::TTL>;
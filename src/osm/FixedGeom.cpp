@@ -0,0 +1,59 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/FixedGeom.h"
+
+#include "osmium/osm/location.hpp"
+#include "osmium/osm/node_ref.hpp"
+#include "util/geo/Geo.h"
+
+// ____________________________________________________________________________
+::util::geo::I32Point osm2rdf::osm::toFixed(const osmium::NodeRef& nodeRef) {
+  return {nodeRef.x(), nodeRef.y()};
+}
+
+// ____________________________________________________________________________
+::util::geo::DPoint osm2rdf::osm::toDouble(
+    const ::util::geo::I32Point& point) {
+  return {osmium::Location::fix_to_double(point.getX()),
+          osmium::Location::fix_to_double(point.getY())};
+}
+
+// ____________________________________________________________________________
+::util::geo::DLine osm2rdf::osm::toDouble(const ::util::geo::I32Line& line) {
+  ::util::geo::DLine result;
+  result.reserve(line.size());
+  for (const auto& point : line) {
+    result.push_back(toDouble(point));
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+::util::geo::DMultiPolygon osm2rdf::osm::toDouble(
+    const ::util::geo::I32MultiPolygon& multiPolygon) {
+  ::util::geo::DMultiPolygon result(multiPolygon.size());
+  for (size_t i = 0; i < multiPolygon.size(); i++) {
+    result[i].getOuter() = toDouble(multiPolygon[i].getOuter());
+    result[i].getInners().reserve(multiPolygon[i].getInners().size());
+    for (const auto& inner : multiPolygon[i].getInners()) {
+      result[i].getInners().push_back(toDouble(inner));
+    }
+  }
+  return result;
+}
@@ -17,13 +17,47 @@
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "osm2rdf/config/Config.h"
 #include "osm2rdf/osm/LocationHandler.h"
+#include "osm2rdf/osm/Snapshot.h"
 #include "osmium/handler/node_locations_for_ways.hpp"
 #include "osmium/index/map/dense_file_array.hpp"
 #include "osmium/index/map/flex_mem.hpp"
 #include "osmium/index/map/sparse_file_array.hpp"
+#include "osmium/memory/buffer.hpp"
+
+static const size_t WAYS_PER_TASK = 256;
+
+// ____________________________________________________________________________
+template <typename H>
+static void setBufferLocations(H* handler, osmium::memory::Buffer& buffer) {
+  // Nodes have to be stored before any way can be resolved. Storing is not
+  // thread-safe for all indices.
+  std::vector<osmium::Way*> ways;
+  for (auto& item : buffer) {
+    if (item.type() == osmium::item_type::node) {
+      handler->node(static_cast<const osmium::Node&>(item));
+    } else if (item.type() == osmium::item_type::way) {
+      ways.push_back(&static_cast<osmium::Way&>(item));
+    }
+  }
+  if (ways.empty()) {
+    return;
+  }
+  // NodeLocationsForWays sorts sparse indices for unsorted input in the first
+  // call of way() after new nodes, which has to happen before any lookup.
+  handler->way(*ways.front());
+  // Lookups only read the index and each task modifies distinct ways.
+#pragma omp taskloop grainsize(WAYS_PER_TASK) shared(handler, ways)
+  for (size_t i = 1; i < ways.size(); ++i) {
+    for (auto& nodeRef : ways[i]->nodes()) {
+      nodeRef.set_location(handler->get_node_location(nodeRef.ref()));
+    }
+  }
+}
 
 // ____________________________________________________________________________
 osm2rdf::osm::LocationHandler* osm2rdf::osm::LocationHandler::create(
@@ -38,6 +72,26 @@ osm2rdf::osm::LocationHandler* osm2rdf::osm::LocationHandler::create(
                                                     nodeIdMax);
   }
 
+  if (config.storeLocations == "disk-persistent") {
+    return new osm2rdf::osm::LocationHandlerFSPersistent(config, nodeIdMin,
+                                                         nodeIdMax);
+  }
+
+  if (config.storeLocations == "mem-compressed") {
+    return new osm2rdf::osm::LocationHandlerRAMCompressed(config, nodeIdMin,
+                                                          nodeIdMax);
+  }
+
+  if (config.storeLocations == "mem-required") {
+    return new osm2rdf::osm::LocationHandlerRAMRequired(config, nodeIdMin,
+                                                        nodeIdMax);
+  }
+
+  if (config.storeLocations == "mem-dense-paged") {
+    return new osm2rdf::osm::LocationHandlerRAMDensePaged(config, nodeIdMin,
+                                                          nodeIdMax);
+  }
+
   if (config.storeLocations == "mem-dense") {
     return new osm2rdf::osm::LocationHandlerRAMDense(config, nodeIdMin,
                                                      nodeIdMax);
@@ -48,21 +102,9 @@ osm2rdf::osm::LocationHandler* osm2rdf::osm::LocationHandler::create(
 
 // ____________________________________________________________________________
 template <typename T>
-osmium::Location osm2rdf::osm::LocationHandlerImpl<T>::get_node_location(
-    const osmium::object_id_type nodeId) const {
-  return _handler.get_node_location(nodeId);
-}
-
-// ____________________________________________________________________________
-template <typename T>
-void osm2rdf::osm::LocationHandlerImpl<T>::node(const osmium::Node& node) {
-  _handler.node(node);
-}
-
-// ____________________________________________________________________________
-template <typename T>
-void osm2rdf::osm::LocationHandlerImpl<T>::way(osmium::Way& way) {
-  _handler.way(way);
+void osm2rdf::osm::LocationHandlerImpl<T>::setLocations(
+    osmium::memory::Buffer& buffer) {
+  setBufferLocations(&_handler, buffer);
 }
 
 // ____________________________________________________________________________
@@ -83,25 +125,11 @@ osm2rdf::osm::LocationHandlerImpl<osmium::index::map::SparseFileArray<
   _handler.ignore_errors();
 }
 
-// ____________________________________________________________________________
-osmium::Location
-osm2rdf::osm::LocationHandlerImpl<osmium::index::map::SparseFileArray<
-    osmium::unsigned_object_id_type, osmium::Location>>::
-    get_node_location(const osmium::object_id_type nodeId) const {
-  return _handler.get_node_location(nodeId);
-}
-
 // ____________________________________________________________________________
 void osm2rdf::osm::LocationHandlerImpl<osmium::index::map::SparseFileArray<
     osmium::unsigned_object_id_type,
-    osmium::Location>>::node(const osmium::Node& node) {
-  _handler.node(node);
-}
-
-// ____________________________________________________________________________
-void osm2rdf::osm::LocationHandlerImpl<osmium::index::map::SparseFileArray<
-    osmium::unsigned_object_id_type, osmium::Location>>::way(osmium::Way& way) {
-  _handler.way(way);
+    osmium::Location>>::setLocations(osmium::memory::Buffer& buffer) {
+  setBufferLocations(&_handler, buffer);
 }
 
 // ____________________________________________________________________________
@@ -117,26 +145,28 @@ osm2rdf::osm::LocationHandlerImpl<osmium::index::map::DenseFileArray<
 // ____________________________________________________________________________
 void osm2rdf::osm::LocationHandlerImpl<osmium::index::map::DenseFileArray<
     osmium::unsigned_object_id_type,
-    osmium::Location>>::node(const osmium::Node& node) {
-  _handler.node(node);
+    osmium::Location>>::setLocations(osmium::memory::Buffer& buffer) {
+  setBufferLocations(&_handler, buffer);
 }
 
 // ____________________________________________________________________________
-void osm2rdf::osm::LocationHandlerImpl<osmium::index::map::DenseFileArray<
-    osmium::unsigned_object_id_type, osmium::Location>>::way(osmium::Way& way) {
-  _handler.way(way);
+osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
+    osmium::unsigned_object_id_type, osmium::Location>>::
+    LocationHandlerImpl(const osm2rdf::config::Config&, size_t nodeIdMin,
+                        size_t nodeIdMax)
+    : _index(nodeIdMin, nodeIdMax), _handler(_index) {
+  _handler.ignore_errors();
 }
 
 // ____________________________________________________________________________
-osmium::Location
-osm2rdf::osm::LocationHandlerImpl<osmium::index::map::DenseFileArray<
-    osmium::unsigned_object_id_type, osmium::Location>>::
-    get_node_location(const osmium::object_id_type nodeId) const {
-  return _handler.get_node_location(nodeId);
+void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
+    osmium::unsigned_object_id_type,
+    osmium::Location>>::setLocations(osmium::memory::Buffer& buffer) {
+  setBufferLocations(&_handler, buffer);
 }
 
 // ____________________________________________________________________________
-osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
+osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::PagedDenseMemIndex<
     osmium::unsigned_object_id_type, osmium::Location>>::
     LocationHandlerImpl(const osm2rdf::config::Config&, size_t nodeIdMin,
                         size_t nodeIdMax)
@@ -145,21 +175,79 @@ osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
 }
 
 // ____________________________________________________________________________
-void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
+void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::PagedDenseMemIndex<
     osmium::unsigned_object_id_type,
-    osmium::Location>>::node(const osmium::Node& node) {
-  _handler.node(node);
+    osmium::Location>>::setLocations(osmium::memory::Buffer& buffer) {
+  setBufferLocations(&_handler, buffer);
 }
 
 // ____________________________________________________________________________
-void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
-    osmium::unsigned_object_id_type, osmium::Location>>::way(osmium::Way& way) {
-  _handler.way(way);
+osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::CompressedLocationIndex>::
+    LocationHandlerImpl(const osm2rdf::config::Config&, size_t nodeIdMin,
+                        size_t nodeIdMax)
+    : _index(nodeIdMin, nodeIdMax), _handler(_index) {
+  _handler.ignore_errors();
 }
 
 // ____________________________________________________________________________
-osmium::Location osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::DenseMemIndex<
-    osmium::unsigned_object_id_type, osmium::Location>>::
-    get_node_location(const osmium::object_id_type nodeId) const {
-  return _handler.get_node_location(nodeId);
+void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::CompressedLocationIndex>::
+    setLocations(osmium::memory::Buffer& buffer) {
+  setBufferLocations(&_handler, buffer);
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::RequiredLocationIndex>::
+    LocationHandlerImpl(const osm2rdf::config::Config&, size_t, size_t)
+    : _handler(_index) {
+  _handler.ignore_errors();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::RequiredLocationIndex>::
+    setLocations(osmium::memory::Buffer& buffer) {
+  setBufferLocations(&_handler, buffer);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::RequiredLocationIndex>::
+    setRequiredNodes(osm2rdf::util::RankBitVector&& requiredNodes) {
+  _index.setRequiredNodes(std::move(requiredNodes));
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::PersistentLocationIndex>::
+    LocationHandlerImpl(const osm2rdf::config::Config& config,
+                        size_t nodeIdMin, size_t nodeIdMax)
+    // Changes may add nodes with any id, the update state covers all ids.
+    : _index(config.getTempPath("osmium", "n2l.persistent.cache"),
+             osm2rdf::osm::Snapshot::fingerprint(config.input),
+             config.updateState ? 0 : nodeIdMin, nodeIdMax),
+      _handler(_index),
+      _clipped(!config.clipBbox.empty() || !config.clipPolygon.empty()) {
+  _handler.ignore_errors();
+  if (_index.reused()) {
+    std::cerr << "Reusing node locations from "
+              << config.getTempPath("osmium", "n2l.persistent.cache")
+              << std::endl;
+  }
 }
+
+// ____________________________________________________________________________
+void osm2rdf::osm::LocationHandlerImpl<osm2rdf::osm::PersistentLocationIndex>::
+    setLocations(osmium::memory::Buffer& buffer) {
+  // Use this handler to skip storing nodes for a reused index.
+  setBufferLocations(this, buffer);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::LocationHandlerImpl<
+    osm2rdf::osm::PersistentLocationIndex>::finalize() {
+  // An index missing the nodes outside the clip region must not be reused.
+  if (!_clipped) {
+    _index.markComplete();
+  }
+}
+
+// ____________________________________________________________________________
+template class osm2rdf::osm::LocationHandlerImpl<osmium::index::map::FlexMem<
+    osmium::unsigned_object_id_type, osmium::Location>>;
@@ -29,12 +29,13 @@ osm2rdf::osm::Node::Node() {
 }
 
 // ____________________________________________________________________________
-osm2rdf::osm::Node::Node(const osmium::Node& node) {
+osm2rdf::osm::Node::Node(const osmium::Node& node,
+                         std::pmr::memory_resource* resource)
+    : _tags(osm2rdf::osm::convertTagList(node.tags(), resource)) {
   _id = node.positive_id();
   _timestamp = node.timestamp().seconds_since_epoch();
   const auto& loc = node.location();
   _geom = ::util::geo::DPoint{loc.lon(), loc.lat()};
-  _tags = std::move(osm2rdf::osm::convertTagList(node.tags()));
 }
 
 // ____________________________________________________________________________
@@ -0,0 +1,144 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/OrientedBoundingBox.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "util/geo/Geo.h"
+
+// ____________________________________________________________________________
+::util::geo::DPolygon osm2rdf::osm::orientedBoundingBox(
+    const ::util::geo::DPolygon& hull) {
+  // Distinct hull vertices in counter-clockwise order.
+  std::vector<::util::geo::DPoint> pts;
+  pts.reserve(hull.getOuter().size());
+  for (const auto& p : hull.getOuter()) {
+    if (pts.empty() || !(p == pts.back())) {
+      pts.push_back(p);
+    }
+  }
+  while (pts.size() > 1 && pts.front() == pts.back()) {
+    pts.pop_back();
+  }
+  if (pts.size() < 3) {
+    return {};
+  }
+  const size_t n = pts.size();
+
+  double signedArea = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const auto& a = pts[i];
+    const auto& b = pts[(i + 1) % n];
+    signedArea += a.getX() * b.getY() - b.getX() * a.getY();
+  }
+  if (signedArea == 0) {
+    return {};
+  }
+  if (signedArea < 0) {
+    std::reverse(pts.begin(), pts.end());
+  }
+
+  double bestArea = std::numeric_limits<double>::infinity();
+  ::util::geo::DLine best;
+
+  // Indices of the vertices with maximal and minimal projection on the
+  // current edge and maximal distance from it. They only advance while the
+  // calipers rotate around the hull.
+  size_t right = 0;
+  size_t top = 0;
+  size_t left = 0;
+  bool first = true;
+  for (size_t i = 0; i < n; ++i) {
+    const auto& a = pts[i];
+    const auto& b = pts[(i + 1) % n];
+    const double ex = b.getX() - a.getX();
+    const double ey = b.getY() - a.getY();
+    const double edgeLength = std::hypot(ex, ey);
+    const double ux = ex / edgeLength;
+    const double uy = ey / edgeLength;
+
+    // Projections relative to a on the edge direction u and its inwards
+    // pointing normal v = (-uy, ux).
+    auto onU = [&](size_t k) {
+      const auto& p = pts[k % n];
+      return (p.getX() - a.getX()) * ux + (p.getY() - a.getY()) * uy;
+    };
+    auto onV = [&](size_t k) {
+      const auto& p = pts[k % n];
+      return (p.getY() - a.getY()) * ux - (p.getX() - a.getX()) * uy;
+    };
+
+    if (first) {
+      right = i + 1;
+    }
+    for (size_t steps = 0; steps < n && onU(right + 1) > onU(right); ++steps) {
+      right++;
+    }
+    if (first) {
+      top = right;
+    }
+    for (size_t steps = 0; steps < n && onV(top + 1) > onV(top); ++steps) {
+      top++;
+    }
+    if (first) {
+      left = top;
+      first = false;
+    }
+    for (size_t steps = 0; steps < n && onU(left + 1) < onU(left); ++steps) {
+      left++;
+    }
+
+    const double minU = onU(left);
+    const double maxU = onU(right);
+    const double maxV = onV(top);
+    const double area = (maxU - minU) * maxV;
+    if (area >= bestArea) {
+      continue;
+    }
+    bestArea = area;
+    if (ex == 0 || ey == 0) {
+      // Axis-aligned, use the exact coordinates.
+      double minX = std::numeric_limits<double>::infinity();
+      double minY = std::numeric_limits<double>::infinity();
+      double maxX = -std::numeric_limits<double>::infinity();
+      double maxY = -std::numeric_limits<double>::infinity();
+      for (const auto& p : pts) {
+        minX = std::min(minX, p.getX());
+        minY = std::min(minY, p.getY());
+        maxX = std::max(maxX, p.getX());
+        maxY = std::max(maxY, p.getY());
+      }
+      best = {{minX, minY}, {maxX, minY}, {maxX, maxY}, {minX, maxY}};
+    } else {
+      const double x0 = a.getX() + ux * minU;
+      const double y0 = a.getY() + uy * minU;
+      const double x1 = a.getX() + ux * maxU;
+      const double y1 = a.getY() + uy * maxU;
+      best = {{x0, y0},
+              {x1, y1},
+              {x1 - uy * maxV, y1 + ux * maxV},
+              {x0 - uy * maxV, y0 + ux * maxV}};
+    }
+  }
+
+  return ::util::geo::convexHull(best);
+}
@@ -17,16 +17,28 @@
 // You should have received a copy of the GNU General Public License
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "osm2rdf/osm/ClipHandler.h"
 #include "osm2rdf/osm/CountHandler.h"
 #include "osm2rdf/osm/FactHandler.h"
 #include "osm2rdf/osm/GeometryHandler.h"
 #include "osm2rdf/osm/LocationHandler.h"
 #include "osm2rdf/osm/OsmiumHandler.h"
+#include "osm2rdf/osm/PbfBlobIndex.h"
 #include "osm2rdf/osm/RelationHandler.h"
+#include "osm2rdf/osm/ShardMemberHandler.h"
+#include "osm2rdf/osm/Snapshot.h"
+#include "osm2rdf/osm/UpdateState.h"
 #include "osm2rdf/util/ProgressBar.h"
+#include "osm2rdf/util/Shards.h"
 #include "osm2rdf/util/Time.h"
 #include "osmium/area/assembler.hpp"
-#include "osmium/area/multipolygon_manager.hpp"
 #include "osmium/io/any_input.hpp"
 #include "osmium/io/reader_with_progress_bar.hpp"
 
@@ -34,44 +46,144 @@
 #include "omp.h"
 #endif
 
+// Required node ids collected by a thread of the blob-indexed first pass
+// before they are set in the shared bit vector.
+static const size_t REQUIRED_NODES_PER_FLUSH = 1 << 20;
+
 // ____________________________________________________________________________
-template <typename W>
-osm2rdf::osm::OsmiumHandler<W>::OsmiumHandler(
+template <typename W, typename L>
+osm2rdf::osm::OsmiumHandler<W, L>::OsmiumHandler(
     const osm2rdf::config::Config& config,
     osm2rdf::osm::FactHandler<W>* factHandler,
     osm2rdf::osm::GeometryHandler<W>* geomHandler)
     : _config(config),
       _factHandler(factHandler),
       _geometryHandler(geomHandler),
-      _relationHandler(osm2rdf::osm::RelationHandler(config)) {}
+      _relationHandler(config),
+      _tagFilter(config.tagFilter),
+      _taskLimiter(config.maxInFlightObjects, config.maxInFlightBytes),
+      _counters(config.numThreads, NUM_COUNTERS) {}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+osm2rdf::osm::OsmiumHandler<W, L>::~OsmiumHandler() {
+  // Stop the reporter if handle() was left by an exception.
+  _reporterRunning = false;
+  if (_reporter.joinable()) {
+    _reporter.join();
+  }
+}
 
 // ____________________________________________________________________________
-template <typename W>
-void osm2rdf::osm::OsmiumHandler<W>::handle() {
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::handle() {
   {
     osmium::io::File input_file{_config.input};
 
     // Do not create empty areas
     osmium::area::Assembler::config_type assembler_config;
     assembler_config.create_empty_areas = false;
-    osmium::area::MultipolygonManager<osmium::area::Assembler> mp_manager{
-        assembler_config};
+    osm2rdf::osm::AreaManager mp_manager{
+        assembler_config,
+        _config.parallelAreas
+            ? static_cast<size_t>(std::max(_config.numThreads, 1))
+            : 0};
     osm2rdf::osm::CountHandler countHandler(_config);
+    osm2rdf::osm::Snapshot snapshot(_config);
+    // Clipping needs all objects of the first pass, which are not part of a
+    // snapshot.
+    auto clipHandler = osm2rdf::osm::ClipHandler::create(_config);
+    const bool useSnapshot = _config.snapshot && !clipHandler;
 
     // read relations for areas
-    {
+    if (useSnapshot && snapshot.load(&countHandler)) {
+      std::cerr << std::endl;
+      std::cerr << osm2rdf::util::currentTimeFormatted()
+                << "OSM Pass 1 ... (Restoring snapshot "
+                << snapshot.headerPath() << ")" << std::endl;
+      // The snapshot only contains relations, replay them into all handlers
+      // which collect relations in the first pass.
+      osmium::io::Reader reader{
+          osmium::io::File{snapshot.relationsPath().string(), "pbf"},
+          osmium::osm_entity_bits::relation};
+      while (auto buf = reader.read()) {
+        osmium::apply(buf, mp_manager, _relationHandler);
+      }
+      reader.close();
+      mp_manager.prepare_for_lookup();
+      _relationHandler.prepare_for_lookup();
+      std::cerr << osm2rdf::util::currentTimeFormatted() << "... done"
+                << std::endl;
+    } else {
       std::cerr << std::endl;
       std::cerr << osm2rdf::util::currentTimeFormatted()
                 << "OSM Pass 1 ... (Count objects, Relations for areas"
                 << ", Relation members)" << std::endl;
-      osmium::io::ReaderWithProgressBar reader{true, input_file,
-                                               osmium::osm_entity_bits::object};
-      {
+      if (useSnapshot) {
+        snapshot.startRecording();
+      }
+      if (clipHandler) {
+        // The kept objects are only known after the whole input was seen,
+        // the other handlers only see them in a separate read.
+        osmium::io::ReaderWithProgressBar reader{
+            true, input_file, osmium::osm_entity_bits::object};
         while (auto buf = reader.read()) {
-          osmium::apply(buf, mp_manager, _relationHandler, countHandler);
+          osmium::apply(buf, *clipHandler);
+        }
+        reader.close();
+        clipHandler->prepare_for_lookup();
+        if (clipHandler->hasIncompleteWays()) {
+          // Member ways of kept relations outside the region.
+          osmium::io::ReaderWithProgressBar wayReader{
+              true, input_file, osmium::osm_entity_bits::way};
+          while (auto buf = wayReader.read()) {
+            for (const auto& way : buf.select<osmium::Way>()) {
+              clipHandler->completeWay(way);
+            }
+          }
+          wayReader.close();
         }
+        clipHandler->finalize();
+        std::cerr << osm2rdf::util::currentTimeFormatted() << "clipped to "
+                  << clipHandler->numNodes() << " nodes, "
+                  << clipHandler->numWays() << " ways, "
+                  << clipHandler->numRelations() << " relations"
+                  << std::endl;
       }
-      reader.close();
+      if (_config.shardWorker && _config.storeLocations == "mem-required") {
+        // Only the nodes of objects converted by this worker are required.
+        // Ways precede relations, the members of relations are read first.
+        osm2rdf::osm::ShardMemberHandler shardMembers{_config};
+        while (!shardMembers.done()) {
+          osmium::io::ReaderWithProgressBar reader{
+              true, input_file, osmium::osm_entity_bits::relation};
+          while (auto buf = reader.read()) {
+            osmium::apply(buf, shardMembers);
+          }
+          reader.close();
+          shardMembers.prepare_for_lookup();
+        }
+        countHandler.restrictToShard(std::move(shardMembers.relationIds()),
+                                     std::move(shardMembers.wayIds()));
+      }
+      if (_config.blobIndex && !clipHandler &&
+          input_file.format() == osmium::io::file_format::pbf) {
+        countBlobs(&countHandler, &mp_manager, &snapshot);
+      } else {
+        osmium::io::ReaderWithProgressBar reader{
+            true, input_file, osmium::osm_entity_bits::object};
+        {
+          while (auto buf = reader.read()) {
+            if (clipHandler) {
+              buf = clipHandler->filter(buf);
+            }
+            osmium::apply(buf, mp_manager, _relationHandler, countHandler,
+                          snapshot);
+          }
+        }
+        reader.close();
+      }
+      snapshot.store(countHandler);
       mp_manager.prepare_for_lookup();
       _relationHandler.prepare_for_lookup();
       std::cerr << osm2rdf::util::currentTimeFormatted() << "... done"
@@ -92,10 +204,23 @@ void osm2rdf::osm::OsmiumHandler<W>::handle() {
 
       osmium::io::Reader reader{input_file, osmium::osm_entity_bits::object,
                                 pool};
-      osm2rdf::osm::LocationHandler* locationHandler =
-          osm2rdf::osm::LocationHandler::create(
-              _config, countHandler.minNodeId(), countHandler.maxNodeId());
+      L* locationHandler = nullptr;
+      if constexpr (std::is_same_v<L, osm2rdf::osm::LocationHandler>) {
+        locationHandler = osm2rdf::osm::LocationHandler::create(
+            _config, countHandler.minNodeId(), countHandler.maxNodeId());
+      } else {
+        locationHandler = new L(_config, countHandler.minNodeId(),
+                                countHandler.maxNodeId());
+      }
+      locationHandler->setRequiredNodes(
+          std::move(countHandler.requiredNodes()));
       _relationHandler.setLocationHandler(locationHandler);
+      // A clipped input lacks the objects changes may move into the region.
+      std::unique_ptr<osm2rdf::osm::UpdateState> updateState;
+      if (_config.updateState && !clipHandler) {
+        updateState =
+            std::make_unique<osm2rdf::osm::UpdateState>(_config, true);
+      }
 
       size_t numTasks = 0;
       if (!_config.noFacts && !_config.noNodeFacts) {
@@ -119,283 +244,624 @@ void osm2rdf::osm::OsmiumHandler<W>::handle() {
       }
 
       _progressBar = osm2rdf::util::ProgressBar{numTasks, true};
-      _progressBar.update(_numTasksDone);
+      startProgressReporter();
 
 #pragma omp parallel
       {
 #pragma omp single
         {
-          while (auto buf = reader.read()) {
-            osmium::apply(
-                buf, *locationHandler, _relationHandler,
-                mp_manager.handler([&](osmium::memory::Buffer&& buffer) {
-                  osmium::apply(buffer, *this);
-                }),
-                *this);
+          while (auto input = reader.read()) {
+            if (clipHandler) {
+              input = clipHandler->filter(input);
+            }
+            if (updateState) {
+              // Before locations are added to the way nodes.
+              osmium::apply(input, *updateState);
+            }
+            auto buf =
+                std::make_shared<osmium::memory::Buffer>(std::move(input));
+            _pinnedBuffers.push_back(buf);
+            if (_config.parallelLocations) {
+              locationHandler->setLocations(*buf);
+              osmium::apply(
+                  *buf, _relationHandler,
+                  mp_manager.handler([&](osmium::memory::Buffer&& buffer) {
+                    handleBuffer(std::move(buffer));
+                  }),
+                  *this);
+            } else {
+              osmium::apply(
+                  *buf, *locationHandler, _relationHandler,
+                  mp_manager.handler([&](osmium::memory::Buffer&& buffer) {
+                    handleBuffer(std::move(buffer));
+                  }),
+                  *this);
+            }
+            _pinnedBuffers.pop_back();
+            // Areas assembled by the pool, see AreaManager.
+            mp_manager.drain([&](osmium::memory::Buffer&& buffer) {
+              handleBuffer(std::move(buffer));
+            });
+          }
+          if (_config.parallelAreas) {
+            mp_manager.wait();
+            mp_manager.drain([&](osmium::memory::Buffer&& buffer) {
+              handleBuffer(std::move(buffer));
+            });
           }
         }
       }
       reader.close();
+      locationHandler->finalize();
       delete locationHandler;
+      if (updateState) {
+        updateState->finalize();
+      }
+      stopProgressReporter();
       _progressBar.done();
 
       std::cerr << osm2rdf::util::currentTimeFormatted() << "... done"
                 << std::endl;
+      if (_taskLimiter.numWaits() > 0) {
+        std::cerr << osm2rdf::util::currentTimeFormatted() << "paused reading "
+                  << _taskLimiter.numWaits() << " times to bound in-flight "
+                  << "objects" << std::endl;
+      }
 
       std::cerr << osm2rdf::util::currentTimeFormatted()
-                << "areas seen:" << _areasSeen << " dumped: " << _areasDumped
-                << " geometry: " << _areaGeometriesHandled << "\n"
+                << "areas seen:" << _areasSeen << " dumped: " << areasDumped()
+                << " geometry: " << areaGeometriesHandled() << "\n"
                 << osm2rdf::util::formattedTimeSpacer
-                << "nodes seen:" << _nodesSeen << " dumped: " << _nodesDumped
-                << " geometry: " << _nodeGeometriesHandled << "\n"
+                << "nodes seen:" << _nodesSeen << " dumped: " << nodesDumped()
+                << " geometry: " << nodeGeometriesHandled() << "\n"
                 << osm2rdf::util::formattedTimeSpacer
                 << "relations seen:" << _relationsSeen
-                << " dumped: " << _relationsDumped
-                << " geometry: " << _relationGeometriesHandled << "\n"
+                << " dumped: " << relationsDumped()
+                << " geometry: " << relationGeometriesHandled() << "\n"
                 << osm2rdf::util::formattedTimeSpacer
-                << "ways seen:" << _waysSeen << " dumped: " << _waysDumped
-                << " geometry: " << _wayGeometriesHandled << std::endl;
+                << "ways seen:" << _waysSeen << " dumped: " << waysDumped()
+                << " geometry: " << wayGeometriesHandled() << std::endl;
+    }
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::countBlobs(
+    osm2rdf::osm::CountHandler* countHandler,
+    osm2rdf::osm::AreaManager* mpManager,
+    osm2rdf::osm::Snapshot* snapshot) {
+  osm2rdf::osm::PbfBlobIndex index{_config.input};
+  const size_t numThreads = std::max(_config.numThreads, 1);
+
+  // Counting only needs commutative state, each thread counts its own blobs.
+  // Required nodes are set in the bit vector of countHandler, which has the
+  // size of the whole id range, a copy for each thread would not fit.
+  std::vector<osm2rdf::osm::CountHandler> threadCounts(numThreads,
+                                                       *countHandler);
+  for (auto& threadCount : threadCounts) {
+    threadCount.bufferRequiredNodes();
+  }
+  osm2rdf::util::ProgressBar progressBar{index.numBlobs(), true};
+  size_t blobsDone = 0;
+  std::exception_ptr error = nullptr;
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads)
+  for (size_t i = 0; i < index.numBlobs(); ++i) {
+    size_t thread = 0;
+#if defined(_OPENMP)
+    thread = omp_get_thread_num();
+#endif
+    try {
+      // Nodes are only counted, which does not need a full decode.
+      osm2rdf::osm::PbfNodeSummary nodes;
+      // Tag filters need the tags of all nodes. Shards need the ids of all
+      // nodes, unless all nodes of the blob belong to the same shard.
+      size_t shard = _config.shard;
+      bool scanned = _tagFilter.empty() && index.scan(i, &nodes);
+      if (scanned && _config.shardWorker && nodes.numNodes > 0) {
+        shard = osm2rdf::util::shardOfRange(nodes.minId, nodes.maxId,
+                                            _config.shards);
+        scanned = shard < _config.shards;
+      }
+      if (!scanned) {
+        index.apply(i, osmium::osm_entity_bits::object, threadCounts[thread]);
+      } else {
+        // Nodes of other shards only extend the range of ids.
+        const bool inShard = shard == _config.shard;
+        threadCounts[thread].countNodes(inShard ? nodes.numNodes : 0,
+                                        inShard ? nodes.numTaggedNodes : 0,
+                                        nodes.minId, nodes.maxId);
+        const auto types = index.blob(i).entities &
+                           (osmium::osm_entity_bits::way |
+                            osmium::osm_entity_bits::relation);
+        if (types != osmium::osm_entity_bits::nothing) {
+          index.apply(i, types, threadCounts[thread]);
+        }
+      }
+      if (threadCounts[thread].numBufferedRequiredNodes() >=
+          REQUIRED_NODES_PER_FLUSH) {
+#pragma omp critical(requiredNodes)
+        threadCounts[thread].flushRequiredNodes(
+            &countHandler->requiredNodes());
+      }
+    } catch (...) {
+#pragma omp critical(blobError)
+      error = std::current_exception();
+    }
+#pragma omp critical(blobProgress)
+    progressBar.update(++blobsDone);
+  }
+  progressBar.done();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  for (auto& threadCount : threadCounts) {
+    threadCount.flushRequiredNodes(&countHandler->requiredNodes());
+    countHandler->merge(threadCount);
+  }
+
+  // Relation handling depends on the input order, replay relation blobs in
+  // order.
+  for (size_t i = 0; i < index.numBlobs(); ++i) {
+    if ((index.blob(i).entities & osmium::osm_entity_bits::relation) != 0) {
+      index.apply(i, osmium::osm_entity_bits::relation, *mpManager,
+                  _relationHandler, *snapshot);
     }
   }
 }
 
 // ____________________________________________________________________________
-template <typename W>
-void osm2rdf::osm::OsmiumHandler<W>::area(const osmium::Area& area) {
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::area(const osmium::Area& area) {
   _areasSeen++;
 
   if (!_config.addUntaggedAreas && area.tags().empty()) {
     return;
   }
+  if (!_tagFilter.matches(area.tags()) ||
+      !_config.isInShard(static_cast<uint64_t>(area.orig_id()))) {
+    return;
+  }
 
   try {
-    auto osmArea = osm2rdf::osm::Area(area);
-#pragma omp task
-    {
-      osmArea.finalize();
-      if (!_config.noFacts && !_config.noAreaFacts) {
-        _areasDumped++;
-        _factHandler->area(osmArea);
-      }
-      if (!_config.noGeometricRelations && !_config.noAreaGeometricRelations) {
-        _areaGeometriesHandled++;
-        _geometryHandler->area(osmArea);
-      }
-    }
+    _areaBatch.emplace_back(area);
   } catch (const osmium::invalid_location& e) {
     return;
   }
+  _areaBatchBytes += area.byte_size();
+  if (_areaBatch.size() >= _config.batchSize) {
+    flushAreas();
+  }
+  throttle(area.byte_size());
 }
 
 // ____________________________________________________________________________
-template <typename W>
-void osm2rdf::osm::OsmiumHandler<W>::node(const osmium::Node& node) {
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::node(const osmium::Node& node) {
   _nodesSeen++;
 
   if (!_config.addUntaggedNodes && node.tags().empty()) {
     return;
   }
+  if (!_tagFilter.matches(node.tags()) ||
+      !_config.isInShard(node.positive_id())) {
+    return;
+  }
 
+  if (!_nodeBatch) {
+    _nodeBatch = std::make_unique<Batch<osm2rdf::osm::Node>>(_config.batchSize);
+  }
   try {
-    const auto& osmNode = osm2rdf::osm::Node(node);
-#pragma omp task
-    {
-      if (!_config.noFacts && !_config.noNodeFacts) {
-        _factHandler->node(osmNode);
-#pragma omp critical(progress)
-        {
-          _nodesDumped++;
-          _progressBar.update(_numTasksDone++);
-        }
-      }
-      if (!_config.noGeometricRelations && !_config.noNodeGeometricRelations) {
-        _geometryHandler->node(osmNode);
-#pragma omp critical(progress)
-        {
-          _nodeGeometriesHandled++;
-          _progressBar.update(_numTasksDone++);
-        }
-      }
-    };
+    _nodeBatch->objects.emplace_back(node, &_nodeBatch->arena);
   } catch (const osmium::invalid_location& e) {
     if (!_config.noFacts && !_config.noNodeFacts) {
-      _progressBar.update(_numTasksDone++);
+      _counters.add(TASKS_DONE, 1);
     }
     if (!_config.noGeometricRelations && !_config.noNodeGeometricRelations) {
-      _progressBar.update(_numTasksDone++);
+      _counters.add(TASKS_DONE, 1);
     }
     return;
   }
+  _nodeBatch->bytes += node.byte_size();
+  if (_nodeBatch->objects.size() >= _config.batchSize) {
+    flushNodes();
+  }
+  throttle(node.byte_size());
 }
 
 // ____________________________________________________________________________
-template <typename W>
-void osm2rdf::osm::OsmiumHandler<W>::relation(
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::relation(
     const osmium::Relation& relation) {
   _relationsSeen++;
 
   if (!_config.addUntaggedRelations && relation.tags().empty()) {
     return;
   }
+  if (!_tagFilter.matches(relation.tags()) ||
+      !_config.isInShard(relation.positive_id())) {
+    return;
+  }
 
+  if (!_relationBatch) {
+    _relationBatch =
+        std::make_unique<Batch<osm2rdf::osm::Relation>>(_config.batchSize);
+  }
   try {
-    // only task this away if we actually build the relation geometries,
-    // otherwise this just adds multithreading overhead for nothing
-    auto osmRelation = osm2rdf::osm::Relation(relation);
-#pragma omp task
-    {
-      if (!osmRelation.isArea() && _relationHandler.hasLocationHandler()) {
-        osmRelation.buildGeometry(_relationHandler);
-      }
-
-      if (!_config.noFacts && !_config.noRelationFacts) {
-        _factHandler->relation(osmRelation);
-#pragma omp critical(progress)
-        {
-          _relationsDumped++;
-          _progressBar.update(_numTasksDone++);
-        }
-      }
-
-      if (!_config.noGeometricRelations &&
-          !_config.noRelationGeometricRelations) {
-        _geometryHandler->relation(osmRelation);
-#pragma omp critical(progress)
-        _progressBar.update(_numTasksDone++);
-      }
-    }
+    _relationBatch->objects.emplace_back(relation, &_relationBatch->arena);
   } catch (const osmium::invalid_location& e) {
     if (!_config.noFacts && !_config.noRelationFacts) {
-      _progressBar.update(_numTasksDone++);
+      _counters.add(TASKS_DONE, 1);
     }
 
     if (!_config.noGeometricRelations &&
         !_config.noRelationGeometricRelations) {
-      _progressBar.update(_numTasksDone++);
+      _counters.add(TASKS_DONE, 1);
     }
     return;
   }
+  _relationBatch->bytes += relation.byte_size();
+  if (_relationBatch->objects.size() >= _config.batchSize) {
+    flushRelations();
+  }
+  throttle(relation.byte_size());
 }
 
 // ____________________________________________________________________________
-template <typename W>
-void osm2rdf::osm::OsmiumHandler<W>::way(const osmium::Way& way) {
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::way(const osmium::Way& way) {
   _waysSeen++;
 
   if (!_config.addUntaggedWays && way.tags().empty()) {
     return;
   }
+  if (!_tagFilter.matches(way.tags()) ||
+      !_config.isInShard(way.positive_id())) {
+    return;
+  }
 
+  if (!_wayBatch) {
+    _wayBatch = std::make_unique<Batch<osm2rdf::osm::Way>>(_config.batchSize);
+  }
   try {
-    auto osmWay = osm2rdf::osm::Way(way);
+    _wayBatch->objects.emplace_back(way, &_wayBatch->arena);
+  } catch (const osmium::invalid_location& e) {
+    if (!_config.noFacts && !_config.noWayFacts) {
+      _counters.add(TASKS_DONE, 1);
+    }
+    if (!_config.noGeometricRelations && !_config.noWayGeometricRelations) {
+      _counters.add(TASKS_DONE, 1);
+    }
+    return;
+  }
+  _wayBatch->bytes += way.byte_size();
+  if (_wayBatch->objects.size() >= _config.batchSize) {
+    flushWays();
+  }
+  throttle(way.byte_size());
+}
 
-#pragma omp task
-    {
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::handleBuffer(
+    osmium::memory::Buffer&& buffer) {
+  _pinnedBuffers.push_back(
+      std::make_shared<osmium::memory::Buffer>(std::move(buffer)));
+  osmium::apply(*_pinnedBuffers.back(), *this);
+  _pinnedBuffers.pop_back();
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::flush() {
+  flushAreas();
+  flushNodes();
+  flushRelations();
+  flushWays();
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::flushAreas() {
+  if (_areaBatch.empty()) {
+    return;
+  }
+  auto* batch = new std::vector<osm2rdf::osm::Area>(std::move(_areaBatch));
+  _areaBatch.clear();
+  const size_t bytes = _areaBatchBytes;
+  _areaBatchBytes = 0;
+#pragma omp task firstprivate(batch, bytes)
+  {
+    size_t dumped = 0;
+    size_t geometries = 0;
+    for (auto& osmArea : *batch) {
+      osmArea.finalize();
+      if (!_config.noFacts && !_config.noAreaFacts) {
+        _factHandler->area(osmArea);
+        dumped++;
+      }
+      if (!_config.noGeometricRelations && !_config.noAreaGeometricRelations) {
+        _geometryHandler->area(osmArea);
+        geometries++;
+      }
+    }
+    _counters.add(AREAS_DUMPED, dumped);
+    _counters.add(AREA_GEOMETRIES_HANDLED, geometries);
+    _taskLimiter.done(batch->size(), bytes);
+    delete batch;
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::flushNodes() {
+  if (!_nodeBatch || _nodeBatch->objects.empty()) {
+    return;
+  }
+  auto* batch = _nodeBatch.release();
+  batch->pins = _pinnedBuffers;
+#pragma omp task firstprivate(batch)
+  {
+    size_t dumped = 0;
+    size_t geometries = 0;
+    for (const auto& osmNode : batch->objects) {
+      if (!_config.noFacts && !_config.noNodeFacts) {
+        _factHandler->node(osmNode);
+        dumped++;
+      }
+      if (!_config.noGeometricRelations && !_config.noNodeGeometricRelations) {
+        _geometryHandler->node(osmNode);
+        geometries++;
+      }
+    }
+    _counters.add(NODES_DUMPED, dumped);
+    _counters.add(NODE_GEOMETRIES_HANDLED, geometries);
+    _counters.add(TASKS_DONE, dumped + geometries);
+    _taskLimiter.done(batch->objects.size(), batch->bytes);
+    delete batch;
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::flushRelations() {
+  if (!_relationBatch || _relationBatch->objects.empty()) {
+    return;
+  }
+  auto* batch = _relationBatch.release();
+  batch->pins = _pinnedBuffers;
+#pragma omp task firstprivate(batch)
+  {
+    size_t dumped = 0;
+    size_t geometries = 0;
+    for (auto& osmRelation : batch->objects) {
+      if (!osmRelation.isArea() && _relationHandler.hasLocationHandler()) {
+        osmRelation.buildGeometry(_relationHandler);
+      }
+
+      if (!_config.noFacts && !_config.noRelationFacts) {
+        _factHandler->relation(osmRelation);
+        dumped++;
+      }
+
+      if (!_config.noGeometricRelations &&
+          !_config.noRelationGeometricRelations) {
+        _geometryHandler->relation(osmRelation);
+        geometries++;
+      }
+    }
+    _counters.add(RELATIONS_DUMPED, dumped);
+    _counters.add(TASKS_DONE, dumped + geometries);
+    _taskLimiter.done(batch->objects.size(), batch->bytes);
+    delete batch;
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::flushWays() {
+  if (!_wayBatch || _wayBatch->objects.empty()) {
+    return;
+  }
+  auto* batch = _wayBatch.release();
+  batch->pins = _pinnedBuffers;
+#pragma omp task firstprivate(batch)
+  {
+    size_t dumped = 0;
+    size_t geometries = 0;
+    for (auto& osmWay : batch->objects) {
       if (!_config.noFacts && !_config.noWayFacts) {
         if (!osmWay.isArea()) {  // avoid double calculation of OBB and hull
           osmWay.finalize();
         }
         _factHandler->way(osmWay);
-#pragma omp critical(progress)
-        {
-          _waysDumped++;
-          _progressBar.update(_numTasksDone++);
-        }
+        dumped++;
       }
 
       if (!_config.noGeometricRelations && !_config.noWayGeometricRelations) {
         _geometryHandler->way(osmWay);
-#pragma omp critical(progress)
-        {
-          _wayGeometriesHandled++;
-          _progressBar.update(_numTasksDone++);
-        }
+        geometries++;
       }
     }
-  } catch (const osmium::invalid_location& e) {
-    if (!_config.noFacts && !_config.noWayFacts) {
-      _progressBar.update(_numTasksDone++);
+    _counters.add(WAYS_DUMPED, dumped);
+    _counters.add(WAY_GEOMETRIES_HANDLED, geometries);
+    _counters.add(TASKS_DONE, dumped + geometries);
+    _taskLimiter.done(batch->objects.size(), batch->bytes);
+    delete batch;
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::startProgressReporter() {
+  _progressBar.update(_counters.get(TASKS_DONE));
+  _reporterRunning = true;
+  _reporter = std::thread([this]() {
+    while (_reporterRunning) {
+      std::this_thread::sleep_for(PROGRESS_REPORT_INTERVAL);
+      _progressBar.update(_counters.get(TASKS_DONE));
     }
-    if (!_config.noGeometricRelations && !_config.noWayGeometricRelations) {
-      _progressBar.update(_numTasksDone++);
+  });
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::stopProgressReporter() {
+  _reporterRunning = false;
+  if (_reporter.joinable()) {
+    _reporter.join();
+  }
+  _progressBar.update(_counters.get(TASKS_DONE));
+}
+
+// ____________________________________________________________________________
+template <typename W, typename L>
+void osm2rdf::osm::OsmiumHandler<W, L>::throttle(size_t bytes) {
+  if (!_taskLimiter.add(bytes)) {
+    return;
+  }
+  // Objects in unfinished batches are only done once their task is spawned.
+  flush();
+#if defined(_OPENMP)
+  if (omp_get_num_threads() > 1) {
+    // The other threads keep processing batches while reading is paused until
+    // the objects in flight dropped to the low watermark. Area assembly runs
+    // in the threads of the AreaManager and is neither waited for nor picked
+    // up here.
+    while (!_taskLimiter.drained()) {
+#pragma omp taskyield
     }
     return;
   }
+#endif
+  // Without other threads, queued tasks only run when waited for.
+#pragma omp taskwait
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::areasSeen() const {
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::areasSeen() const {
   return _areasSeen;
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::areasDumped() const {
-  return _areasDumped;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::areasDumped() const {
+  return _counters.get(AREAS_DUMPED);
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::areaGeometriesHandled() const {
-  return _areaGeometriesHandled;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::areaGeometriesHandled() const {
+  return _counters.get(AREA_GEOMETRIES_HANDLED);
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::nodesSeen() const {
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::nodesSeen() const {
   return _nodesSeen;
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::nodesDumped() const {
-  return _nodesDumped;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::nodesDumped() const {
+  return _counters.get(NODES_DUMPED);
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::nodeGeometriesHandled() const {
-  return _nodeGeometriesHandled;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::nodeGeometriesHandled() const {
+  return _counters.get(NODE_GEOMETRIES_HANDLED);
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::relationsSeen() const {
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::relationsSeen() const {
   return _relationsSeen;
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::relationsDumped() const {
-  return _relationsDumped;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::relationsDumped() const {
+  return _counters.get(RELATIONS_DUMPED);
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::relationGeometriesHandled() const {
-  return _relationGeometriesHandled;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::relationGeometriesHandled() const {
+  return _counters.get(RELATION_GEOMETRIES_HANDLED);
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::waysSeen() const {
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::waysSeen() const {
   return _waysSeen;
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::waysDumped() const {
-  return _waysDumped;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::waysDumped() const {
+  return _counters.get(WAYS_DUMPED);
 }
 
 // ____________________________________________________________________________
-template <typename W>
-size_t osm2rdf::osm::OsmiumHandler<W>::wayGeometriesHandled() const {
-  return _wayGeometriesHandled;
+template <typename W, typename L>
+size_t osm2rdf::osm::OsmiumHandler<W, L>::wayGeometriesHandled() const {
+  return _counters.get(WAY_GEOMETRIES_HANDLED);
 }
 
 // ____________________________________________________________________________
-template class osm2rdf::osm::OsmiumHandler<osm2rdf::ttl::format::NT>;
-template class osm2rdf::osm::OsmiumHandler<osm2rdf::ttl::format::TTL>;
-template class osm2rdf::osm::OsmiumHandler<osm2rdf::ttl::format::QLEVER>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandler>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandler>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandler>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerRAMDense>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerRAMDense>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerRAMDense>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerRAMDensePaged>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerRAMDensePaged>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerRAMDensePaged>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerRAMFlex>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerRAMFlex>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerRAMFlex>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerRAMCompressed>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerRAMCompressed>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerRAMCompressed>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerRAMRequired>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerRAMRequired>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerRAMRequired>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerFSSparse>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerFSSparse>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerFSSparse>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerFSDense>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerFSDense>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerFSDense>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::NT, osm2rdf::osm::LocationHandlerFSPersistent>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::TTL, osm2rdf::osm::LocationHandlerFSPersistent>;
+template class osm2rdf::osm::OsmiumHandler<
+    osm2rdf::ttl::format::QLEVER, osm2rdf::osm::LocationHandlerFSPersistent>;
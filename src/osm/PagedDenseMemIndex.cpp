@@ -0,0 +1,89 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PagedDenseMemIndex.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "osmium/osm/node.hpp"
+
+// ____________________________________________________________________________
+template <typename TId, typename TValue>
+osm2rdf::osm::PagedDenseMemIndex<TId, TValue>::PagedDenseMemIndex(
+    size_t minNodeId, size_t maxNodeId)
+    : _offset(minNodeId),
+      // No nodes were counted if minNodeId > maxNodeId.
+      _size(minNodeId <= maxNodeId ? maxNodeId - minNodeId + 1 : 0),
+      _pages((_size + kPageSize - 1) / kPageSize) {}
+
+// ____________________________________________________________________________
+template <typename TId, typename TValue>
+void osm2rdf::osm::PagedDenseMemIndex<TId, TValue>::set(const TId id,
+                                                        const TValue value) {
+  assert(id >= _offset);
+  assert(id < _size + _offset);
+  const size_t pos = id - _offset;
+  auto& page = _pages[pos >> kPageBits];
+  if (!page) {
+    page.reset(new TValue[kPageSize]);
+    std::fill(page.get(), page.get() + kPageSize,
+              osmium::index::empty_value<TValue>());
+    _numPages++;
+  }
+  page[pos & (kPageSize - 1)] = value;
+}
+
+// ____________________________________________________________________________
+template <typename TId, typename TValue>
+TValue osm2rdf::osm::PagedDenseMemIndex<TId, TValue>::get_noexcept(
+    const TId id) const noexcept {
+  // Ids below _offset wrap around and fail the range check as well.
+  const size_t pos = id - _offset;
+  if (pos >= _size) {
+    return osmium::index::empty_value<TValue>();
+  }
+  const auto& page = _pages[pos >> kPageBits];
+  if (!page) {
+    return osmium::index::empty_value<TValue>();
+  }
+  return page[pos & (kPageSize - 1)];
+}
+
+// ____________________________________________________________________________
+template <typename TId, typename TValue>
+TValue osm2rdf::osm::PagedDenseMemIndex<TId, TValue>::get(const TId id) const {
+  const auto value = get_noexcept(id);
+  if (value == osmium::index::empty_value<TValue>()) {
+    throw osmium::not_found{id};
+  }
+  return value;
+}
+
+// ____________________________________________________________________________
+template <typename TId, typename TValue>
+void osm2rdf::osm::PagedDenseMemIndex<TId, TValue>::clear() {
+  _pages.clear();
+  _pages.shrink_to_fit();
+  _numPages = 0;
+  _offset = 0;
+  _size = 0;
+}
+
+template class osm2rdf::osm::PagedDenseMemIndex<osmium::unsigned_object_id_type,
+                                                osmium::Location>;
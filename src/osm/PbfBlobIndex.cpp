@@ -0,0 +1,465 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PbfBlobIndex.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+// Limits from the PBF specification.
+static const uint32_t MAX_BLOB_HEADER_SIZE = 64 * 1024;
+static const uint32_t MAX_BLOB_SIZE = 32 * 1024 * 1024;
+static const uint32_t WIRE_TYPE_VARINT = 0;
+static const uint32_t WIRE_TYPE_64BIT = 1;
+static const uint32_t WIRE_TYPE_LENGTH = 2;
+static const uint32_t WIRE_TYPE_32BIT = 5;
+static const uint32_t BLOB_HEADER_TYPE = 1;
+static const uint32_t BLOB_HEADER_DATASIZE = 3;
+static const uint32_t BLOB_RAW = 1;
+static const uint32_t BLOB_RAW_SIZE = 2;
+static const uint32_t BLOB_ZLIB_DATA = 3;
+static const uint32_t PRIMITIVE_BLOCK_GROUP = 2;
+static const uint32_t PRIMITIVE_GROUP_NODES = 1;
+static const uint32_t PRIMITIVE_GROUP_DENSE = 2;
+static const uint32_t PRIMITIVE_GROUP_WAYS = 3;
+static const uint32_t PRIMITIVE_GROUP_RELATIONS = 4;
+static const uint32_t DENSE_NODES_ID = 1;
+static const uint32_t DENSE_NODES_KEYS_VALS = 10;
+static const uint32_t OBJECT_ID = 1;
+static const uint32_t OBJECT_KEYS = 2;
+
+// ____________________________________________________________________________
+static bool readVarint(const char** pos, const char* end, uint64_t* value) {
+  uint64_t result = 0;
+  for (size_t shift = 0; shift < 64 && *pos < end; shift += 7) {
+    const auto byte = static_cast<uint8_t>(*(*pos)++);
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+// A single field of a protobuf message. Length delimited fields point into
+// the message.
+struct ProtobufField {
+  uint64_t number = 0;
+  uint64_t wireType = 0;
+  uint64_t value = 0;
+  const char* data = nullptr;
+};
+
+// ____________________________________________________________________________
+// Reads the field starting at pos and advances pos behind it. Returns false if
+// the message is malformed.
+static bool nextField(const char** pos, const char* end,
+                      ProtobufField* field) {
+  uint64_t key;
+  if (!readVarint(pos, end, &key)) {
+    return false;
+  }
+  field->number = key >> 3;
+  field->wireType = key & 7;
+  field->value = 0;
+  field->data = nullptr;
+  switch (field->wireType) {
+    case WIRE_TYPE_VARINT:
+      return readVarint(pos, end, &field->value);
+    case WIRE_TYPE_LENGTH:
+      if (!readVarint(pos, end, &field->value) ||
+          field->value > static_cast<uint64_t>(end - *pos)) {
+        return false;
+      }
+      field->data = *pos;
+      *pos += field->value;
+      return true;
+    case WIRE_TYPE_64BIT:
+    case WIRE_TYPE_32BIT: {
+      const ptrdiff_t size = field->wireType == WIRE_TYPE_64BIT ? 8 : 4;
+      if (end - *pos < size) {
+        return false;
+      }
+      *pos += size;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// ____________________________________________________________________________
+static int64_t zigzagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// ____________________________________________________________________________
+// Extracts type and datasize from a BlobHeader message. Returns false if the
+// message is malformed.
+static bool parseBlobHeader(const std::string& header, std::string* type,
+                            uint64_t* dataSize) {
+  const char* pos = header.data();
+  const char* end = header.data() + header.size();
+  bool hasType = false;
+  bool hasDataSize = false;
+  ProtobufField field;
+  while (pos < end) {
+    if (!nextField(&pos, end, &field)) {
+      return false;
+    }
+    if (field.number == BLOB_HEADER_DATASIZE &&
+        field.wireType == WIRE_TYPE_VARINT) {
+      *dataSize = field.value;
+      hasDataSize = true;
+    } else if (field.number == BLOB_HEADER_TYPE &&
+               field.wireType == WIRE_TYPE_LENGTH) {
+      *type = std::string(field.data, field.value);
+      hasType = true;
+    }
+  }
+  return hasType && hasDataSize;
+}
+
+// ____________________________________________________________________________
+// Adds a node with the given id to the summary.
+static void addNode(int64_t id, bool tagged,
+                    osm2rdf::osm::PbfNodeSummary* nodes) {
+  const auto positiveId = static_cast<uint64_t>(id < 0 ? -id : id);
+  nodes->numNodes++;
+  nodes->numTaggedNodes += tagged ? 1 : 0;
+  nodes->minId = std::min(nodes->minId, positiveId);
+  nodes->maxId = std::max(nodes->maxId, positiveId);
+}
+
+// ____________________________________________________________________________
+// Summarizes a DenseNodes message: delta coded ids and the keys and values of
+// all nodes, each node terminated by a 0.
+static bool scanDenseNodes(const char* pos, const char* end,
+                           osm2rdf::osm::PbfNodeSummary* nodes) {
+  std::vector<int64_t> ids;
+  std::vector<bool> tagged;
+  ProtobufField field;
+  while (pos < end) {
+    if (!nextField(&pos, end, &field)) {
+      return false;
+    }
+    if (field.wireType != WIRE_TYPE_LENGTH) {
+      continue;
+    }
+    const char* packed = field.data;
+    const char* packedEnd = field.data + field.value;
+    uint64_t value;
+    if (field.number == DENSE_NODES_ID) {
+      int64_t id = 0;
+      while (packed < packedEnd) {
+        if (!readVarint(&packed, packedEnd, &value)) {
+          return false;
+        }
+        id += zigzagDecode(value);
+        ids.push_back(id);
+      }
+    } else if (field.number == DENSE_NODES_KEYS_VALS) {
+      bool hasTags = false;
+      while (packed < packedEnd) {
+        if (!readVarint(&packed, packedEnd, &value)) {
+          return false;
+        }
+        if (value == 0) {
+          tagged.push_back(hasTags);
+          hasTags = false;
+        } else if (!readVarint(&packed, packedEnd, &value)) {
+          return false;
+        } else {
+          hasTags = true;
+        }
+      }
+    }
+  }
+  // Without any tags in the block keys_vals is empty.
+  if (!tagged.empty() && tagged.size() != ids.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < ids.size(); ++i) {
+    addNode(ids[i], !tagged.empty() && tagged[i], nodes);
+  }
+  return true;
+}
+
+// ____________________________________________________________________________
+// Returns the id of a Node, Way or Relation message. Only nodes use zigzag
+// encoding.
+static bool scanObjectId(const char* pos, const char* end, bool zigzag,
+                         int64_t* id, bool* tagged) {
+  bool hasId = false;
+  *tagged = false;
+  ProtobufField field;
+  while (pos < end) {
+    if (!nextField(&pos, end, &field)) {
+      return false;
+    }
+    if (field.number == OBJECT_ID && field.wireType == WIRE_TYPE_VARINT) {
+      *id = zigzag ? zigzagDecode(field.value)
+                   : static_cast<int64_t>(field.value);
+      hasId = true;
+    } else if (field.number == OBJECT_KEYS) {
+      *tagged = *tagged || field.wireType == WIRE_TYPE_VARINT ||
+                field.value > 0;
+    }
+  }
+  return hasId;
+}
+
+// ____________________________________________________________________________
+// Summarizes a PrimitiveBlock message without building any objects.
+static bool scanPrimitiveBlock(const char* pos, const char* end,
+                               osm2rdf::osm::PbfBlob* blob,
+                               osm2rdf::osm::PbfNodeSummary* nodes) {
+  ProtobufField block;
+  while (pos < end) {
+    if (!nextField(&pos, end, &block)) {
+      return false;
+    }
+    if (block.number != PRIMITIVE_BLOCK_GROUP ||
+        block.wireType != WIRE_TYPE_LENGTH) {
+      continue;
+    }
+    const char* groupPos = block.data;
+    const char* groupEnd = block.data + block.value;
+    ProtobufField group;
+    while (groupPos < groupEnd) {
+      if (!nextField(&groupPos, groupEnd, &group)) {
+        return false;
+      }
+      if (group.wireType != WIRE_TYPE_LENGTH) {
+        continue;
+      }
+      const char* objectEnd = group.data + group.value;
+      osmium::osm_entity_bits::type type = osmium::osm_entity_bits::nothing;
+      int64_t id = 0;
+      bool tagged = false;
+      switch (group.number) {
+        case PRIMITIVE_GROUP_NODES:
+          if (!scanObjectId(group.data, objectEnd, true, &id, &tagged)) {
+            return false;
+          }
+          addNode(id, tagged, nodes);
+          type = osmium::osm_entity_bits::node;
+          break;
+        case PRIMITIVE_GROUP_DENSE: {
+          const auto before = nodes->numNodes;
+          if (!scanDenseNodes(group.data, objectEnd, nodes)) {
+            return false;
+          }
+          if (nodes->numNodes == before) {
+            continue;
+          }
+          type = osmium::osm_entity_bits::node;
+          break;
+        }
+        case PRIMITIVE_GROUP_WAYS:
+          if (!scanObjectId(group.data, objectEnd, false, &id, &tagged)) {
+            return false;
+          }
+          type = osmium::osm_entity_bits::way;
+          break;
+        case PRIMITIVE_GROUP_RELATIONS:
+          if (!scanObjectId(group.data, objectEnd, false, &id, &tagged)) {
+            return false;
+          }
+          type = osmium::osm_entity_bits::relation;
+          break;
+        default:
+          continue;
+      }
+      blob->entities |= type;
+      if (type != osmium::osm_entity_bits::node) {
+        const auto positiveId = static_cast<uint64_t>(id < 0 ? -id : id);
+        blob->minId = std::min(blob->minId, positiveId);
+        blob->maxId = std::max(blob->maxId, positiveId);
+      }
+    }
+  }
+  if (nodes->numNodes > 0) {
+    blob->minId = std::min(blob->minId, nodes->minId);
+    blob->maxId = std::max(blob->maxId, nodes->maxId);
+  }
+  return true;
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::PbfBlobIndex::PbfBlobIndex(const std::filesystem::path& path)
+    : _path(path) {
+  _fileDescriptor = ::open(_path.c_str(), O_RDONLY);
+  if (_fileDescriptor == -1) {
+    throw std::filesystem::filesystem_error(
+        "Can't open PBF file", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  const uint64_t fileSize = std::filesystem::file_size(_path);
+  uint64_t offset = 0;
+  while (offset < fileSize) {
+    unsigned char length[4];
+    readAt(offset, reinterpret_cast<char*>(length), sizeof(length));
+    // Length of the BlobHeader in network byte order.
+    const uint32_t headerSize = (static_cast<uint32_t>(length[0]) << 24) |
+                                (static_cast<uint32_t>(length[1]) << 16) |
+                                (static_cast<uint32_t>(length[2]) << 8) |
+                                static_cast<uint32_t>(length[3]);
+    if (headerSize > MAX_BLOB_HEADER_SIZE) {
+      throw std::runtime_error("Invalid PBF blob header size in " +
+                               _path.string());
+    }
+    std::string header(headerSize, '\0');
+    readAt(offset + sizeof(length), header.data(), headerSize);
+    std::string type;
+    uint64_t dataSize = 0;
+    if (!parseBlobHeader(header, &type, &dataSize) ||
+        dataSize > MAX_BLOB_SIZE) {
+      throw std::runtime_error("Invalid PBF blob header in " + _path.string());
+    }
+
+    const uint64_t size = sizeof(length) + headerSize + dataSize;
+    if (type == "OSMHeader" && _header.empty()) {
+      _header.resize(size);
+      readAt(offset, _header.data(), size);
+    } else if (type == "OSMData") {
+      PbfBlob blob;
+      blob.offset = offset;
+      blob.size = size;
+      _blobs.push_back(blob);
+    }
+    offset += size;
+  }
+  if (_header.empty()) {
+    throw std::runtime_error("Missing OSMHeader blob in " + _path.string());
+  }
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::PbfBlobIndex::~PbfBlobIndex() {
+  if (_fileDescriptor != -1) {
+    ::close(_fileDescriptor);
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PbfBlobIndex::readAt(uint64_t offset, char* data,
+                                        size_t size) const {
+  while (size > 0) {
+    const auto bytes = ::pread(_fileDescriptor, data, size, offset);
+    if (bytes <= 0) {
+      throw std::filesystem::filesystem_error(
+          "Can't read PBF file", _path,
+          std::error_code(bytes == 0 ? EIO : errno, std::generic_category()));
+    }
+    data += bytes;
+    size -= bytes;
+    offset += bytes;
+  }
+}
+
+// ____________________________________________________________________________
+std::string osm2rdf::osm::PbfBlobIndex::read(size_t index) const {
+  const auto& blob = _blobs.at(index);
+  std::string result;
+  result.resize(_header.size() + blob.size);
+  std::copy(_header.begin(), _header.end(), result.begin());
+  readAt(blob.offset, result.data() + _header.size(), blob.size);
+  return result;
+}
+
+// ____________________________________________________________________________
+std::string osm2rdf::osm::PbfBlobIndex::readBlob(size_t index) const {
+  const auto& blob = _blobs.at(index);
+  std::string data(blob.size, '\0');
+  readAt(blob.offset, data.data(), blob.size);
+  const auto* length = reinterpret_cast<const unsigned char*>(data.data());
+  const uint32_t headerSize = (static_cast<uint32_t>(length[0]) << 24) |
+                              (static_cast<uint32_t>(length[1]) << 16) |
+                              (static_cast<uint32_t>(length[2]) << 8) |
+                              static_cast<uint32_t>(length[3]);
+  data.erase(0, sizeof(headerSize) + headerSize);
+  return data;
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::PbfBlobIndex::scan(size_t index,
+                                      osm2rdf::osm::PbfNodeSummary* nodes) {
+  auto& blob = _blobs.at(index);
+  const std::string data = readBlob(index);
+  const char* pos = data.data();
+  const char* end = data.data() + data.size();
+
+  const char* raw = nullptr;
+  uint64_t rawLength = 0;
+  uint64_t rawSize = 0;
+  const char* compressed = nullptr;
+  uint64_t compressedSize = 0;
+  ProtobufField field;
+  while (pos < end) {
+    if (!nextField(&pos, end, &field)) {
+      throw std::runtime_error("Invalid PBF blob in " + _path.string());
+    }
+    if (field.number == BLOB_RAW && field.wireType == WIRE_TYPE_LENGTH) {
+      raw = field.data;
+      rawLength = field.value;
+    } else if (field.number == BLOB_RAW_SIZE &&
+               field.wireType == WIRE_TYPE_VARINT) {
+      rawSize = field.value;
+    } else if (field.number == BLOB_ZLIB_DATA &&
+               field.wireType == WIRE_TYPE_LENGTH) {
+      compressed = field.data;
+      compressedSize = field.value;
+    }
+  }
+
+  std::string uncompressed;
+  if (raw == nullptr) {
+    // Other compressions are left to the full decoder.
+    if (compressed == nullptr || rawSize > MAX_BLOB_SIZE) {
+      return false;
+    }
+    uncompressed.resize(rawSize);
+    auto size = static_cast<uLongf>(rawSize);
+    if (::uncompress(reinterpret_cast<Bytef*>(uncompressed.data()), &size,
+                     reinterpret_cast<const Bytef*>(compressed),
+                     static_cast<uLong>(compressedSize)) != Z_OK ||
+        size != rawSize) {
+      throw std::runtime_error("Invalid PBF blob data in " + _path.string());
+    }
+    raw = uncompressed.data();
+    rawLength = rawSize;
+  }
+
+  PbfBlob scanned = blob;
+  PbfNodeSummary summary;
+  if (!scanPrimitiveBlock(raw, raw + rawLength, &scanned, &summary)) {
+    throw std::runtime_error("Invalid PBF block in " + _path.string());
+  }
+  blob = scanned;
+  *nodes = summary;
+  return true;
+}
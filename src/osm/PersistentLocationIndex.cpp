@@ -0,0 +1,244 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PersistentLocationIndex.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <system_error>
+
+static const char MAGIC[8] = {'O', '2', 'R', 'L', 'O', 'C', 'I', 'X'};
+
+// ____________________________________________________________________________
+osm2rdf::osm::PersistentLocationIndex::PersistentLocationIndex(
+    const std::filesystem::path& path, uint64_t fingerprint, size_t minNodeId,
+    size_t maxNodeId)
+    : _path(std::filesystem::absolute(path)),
+      _offset(minNodeId),
+      // No nodes were counted if minNodeId > maxNodeId.
+      _size(minNodeId <= maxNodeId ? maxNodeId - minNodeId + 1 : 0),
+      _mappingSize(kHeaderSize + _size * 2 * sizeof(int32_t)) {
+  if (open(fingerprint)) {
+    _reused = true;
+    map(false);
+  } else {
+    create(fingerprint);
+    map(true);
+  }
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::PersistentLocationIndex::PersistentLocationIndex(
+    const std::filesystem::path& path)
+    : _path(std::filesystem::absolute(path)), _offset(0), _size(0) {
+  _fileDescriptor = ::open(_path.c_str(), O_RDWR);
+  if (_fileDescriptor == -1) {
+    throw std::filesystem::filesystem_error(
+        "Can't open PersistentLocationIndex", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  Header header{};
+  if (::pread(_fileDescriptor, &header, sizeof(header), 0) !=
+          sizeof(header) ||
+      std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != PERSISTENT_LOCATION_INDEX_VERSION ||
+      header.complete != 1) {
+    clear();
+    throw std::filesystem::filesystem_error(
+        "Incomplete PersistentLocationIndex", _path,
+        std::make_error_code(std::errc::invalid_argument));
+  }
+  _offset = header.minNodeId;
+  _size = header.minNodeId <= header.maxNodeId
+              ? header.maxNodeId - header.minNodeId + 1
+              : 0;
+  _mappingSize = kHeaderSize + _size * 2 * sizeof(int32_t);
+  map(true);
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::PersistentLocationIndex::~PersistentLocationIndex() { clear(); }
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::PersistentLocationIndex::open(uint64_t fingerprint) {
+  _fileDescriptor = ::open(_path.c_str(), O_RDONLY);
+  if (_fileDescriptor == -1) {
+    return false;
+  }
+  Header header{};
+  if (::pread(_fileDescriptor, &header, sizeof(header), 0) ==
+          sizeof(header) &&
+      std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+      header.version == PERSISTENT_LOCATION_INDEX_VERSION &&
+      header.complete == 1 && header.fingerprint == fingerprint &&
+      header.minNodeId == _offset &&
+      header.maxNodeId == _offset + _size - 1 &&
+      std::filesystem::file_size(_path) == _mappingSize) {
+    return true;
+  }
+  ::close(_fileDescriptor);
+  _fileDescriptor = -1;
+  return false;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentLocationIndex::create(uint64_t fingerprint) {
+  const int RWRWRW = 0666;
+  _fileDescriptor = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, RWRWRW);
+  if (_fileDescriptor == -1) {
+    throw std::filesystem::filesystem_error(
+        "Can't open PersistentLocationIndex", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  // Creates a sparse file, untouched pages do not use any disk space.
+  if (::ftruncate(_fileDescriptor, _mappingSize) != 0) {
+    throw std::filesystem::filesystem_error(
+        "Can't resize PersistentLocationIndex", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = PERSISTENT_LOCATION_INDEX_VERSION;
+  header.complete = 0;
+  header.fingerprint = fingerprint;
+  header.minNodeId = _offset;
+  header.maxNodeId = _offset + _size - 1;
+  if (::pwrite(_fileDescriptor, &header, sizeof(header), 0) !=
+      sizeof(header)) {
+    throw std::filesystem::filesystem_error(
+        "Can't write PersistentLocationIndex", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentLocationIndex::map(bool writable) {
+  _mapping = ::mmap(nullptr, _mappingSize,
+                    writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+                    _fileDescriptor, 0);
+  if (_mapping == MAP_FAILED) {
+    _mapping = nullptr;
+    throw std::filesystem::filesystem_error(
+        "Can't map PersistentLocationIndex", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  // Lookups are random, read-ahead only wastes page cache. The hints are
+  // optional, errors are ignored.
+  ::madvise(_mapping, _mappingSize, MADV_RANDOM);
+#if defined(MADV_HUGEPAGE)
+  ::madvise(_mapping, _mappingSize, MADV_HUGEPAGE);
+#endif
+  _data = reinterpret_cast<int32_t*>(static_cast<char*>(_mapping) +
+                                     kHeaderSize);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentLocationIndex::markComplete() {
+  if (_reused || _mapping == nullptr) {
+    return;
+  }
+  // Persist all locations before the header claims completeness.
+  ::msync(_mapping, _mappingSize, MS_SYNC);
+  auto* header = static_cast<Header*>(_mapping);
+  header->complete = 1;
+  ::msync(_mapping, kHeaderSize, MS_SYNC);
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::osm::PersistentLocationIndex::fingerprint() const noexcept {
+  return _mapping == nullptr ? 0 : static_cast<Header*>(_mapping)->fingerprint;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentLocationIndex::setFingerprint(
+    uint64_t fingerprint) {
+  ::msync(_mapping, _mappingSize, MS_SYNC);
+  static_cast<Header*>(_mapping)->fingerprint = fingerprint;
+  ::msync(_mapping, kHeaderSize, MS_SYNC);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentLocationIndex::reserve(size_t maxNodeId) {
+  if (maxNodeId < _offset + _size) {
+    return;
+  }
+  ::munmap(_mapping, _mappingSize);
+  _mapping = nullptr;
+  _data = nullptr;
+  // Changes add nodes with ascending ids, grow in steps to remap rarely.
+  const size_t step = 1 << 20;
+  _size = (maxNodeId / step + 1) * step - _offset;
+  _mappingSize = kHeaderSize + _size * 2 * sizeof(int32_t);
+  // New pages stay sparse like the rest of the file.
+  if (::ftruncate(_fileDescriptor, _mappingSize) != 0) {
+    throw std::filesystem::filesystem_error(
+        "Can't resize PersistentLocationIndex", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  map(true);
+  static_cast<Header*>(_mapping)->maxNodeId = _offset + _size - 1;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentLocationIndex::set(
+    const osmium::unsigned_object_id_type id, const osmium::Location value) {
+  if (id < _offset || id - _offset >= _size) {
+    return;
+  }
+  const size_t pos = 2 * (id - _offset);
+  _data[pos] = value.x() ^ osmium::Location::undefined_coordinate;
+  _data[pos + 1] = value.y() ^ osmium::Location::undefined_coordinate;
+}
+
+// ____________________________________________________________________________
+osmium::Location osm2rdf::osm::PersistentLocationIndex::get_noexcept(
+    const osmium::unsigned_object_id_type id) const noexcept {
+  if (id < _offset || id - _offset >= _size) {
+    return osmium::Location{};
+  }
+  const size_t pos = 2 * (id - _offset);
+  return osmium::Location{_data[pos] ^ osmium::Location::undefined_coordinate,
+                          _data[pos + 1] ^
+                              osmium::Location::undefined_coordinate};
+}
+
+// ____________________________________________________________________________
+osmium::Location osm2rdf::osm::PersistentLocationIndex::get(
+    const osmium::unsigned_object_id_type id) const {
+  const auto value = get_noexcept(id);
+  if (value == osmium::index::empty_value<osmium::Location>()) {
+    throw osmium::not_found{id};
+  }
+  return value;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentLocationIndex::clear() {
+  if (_mapping != nullptr) {
+    ::munmap(_mapping, _mappingSize);
+    _mapping = nullptr;
+    _data = nullptr;
+  }
+  if (_fileDescriptor >= 0) {
+    ::close(_fileDescriptor);
+    _fileDescriptor = -1;
+  }
+}
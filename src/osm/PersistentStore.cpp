@@ -0,0 +1,196 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PersistentStore.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+// Records are written in chunks of this size.
+static const size_t PENDING_SIZE = 4 * 1024 * 1024;
+static const size_t MIN_INDEX_SIZE = 1 << 16;
+
+// ____________________________________________________________________________
+static int openFile(const std::filesystem::path& path, bool create) {
+  const int RWRWRW = 0666;
+  const int fd = create ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC,
+                                 RWRWRW)
+                        : ::open(path.c_str(), O_RDWR);
+  if (fd == -1) {
+    throw std::filesystem::filesystem_error(
+        "Can't open PersistentStore", path,
+        std::error_code(errno, std::generic_category()));
+  }
+  return fd;
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::PersistentStore::PersistentStore(
+    const std::filesystem::path& path, bool create)
+    : _path(std::filesystem::absolute(path)) {
+  _indexFile = openFile(_path.string() + ".index", create);
+  _dataFile = openFile(_path.string() + ".data", create);
+  _dataSize = std::filesystem::file_size(_path.string() + ".data");
+  map(std::filesystem::file_size(_path.string() + ".index") /
+      sizeof(uint64_t));
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::PersistentStore::~PersistentStore() {
+  try {
+    flush();
+  } catch (const std::filesystem::filesystem_error&) {
+    // Callers persisting the store call sync() and see the error there.
+  }
+  if (_index != nullptr) {
+    ::munmap(_index, _indexSize * sizeof(uint64_t));
+  }
+  ::close(_indexFile);
+  ::close(_dataFile);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::map(size_t size) {
+  if (_index != nullptr) {
+    ::munmap(_index, _indexSize * sizeof(uint64_t));
+    _index = nullptr;
+  }
+  _indexSize = size;
+  if (_indexSize == 0) {
+    return;
+  }
+  void* mapping = ::mmap(nullptr, _indexSize * sizeof(uint64_t),
+                         PROT_READ | PROT_WRITE, MAP_SHARED, _indexFile, 0);
+  if (mapping == MAP_FAILED) {
+    _indexSize = 0;
+    throw std::filesystem::filesystem_error(
+        "Can't map PersistentStore", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  // Lookups are random, see PersistentLocationIndex.
+  ::madvise(mapping, _indexSize * sizeof(uint64_t), MADV_RANDOM);
+  _index = static_cast<uint64_t*>(mapping);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::reserve(uint64_t id) {
+  if (id < _indexSize) {
+    return;
+  }
+  const size_t size =
+      std::max<uint64_t>({id + 1, 2 * _indexSize, MIN_INDEX_SIZE});
+  // Creates a sparse file, untouched pages do not use any disk space.
+  if (::ftruncate(_indexFile, size * sizeof(uint64_t)) != 0) {
+    throw std::filesystem::filesystem_error(
+        "Can't resize PersistentStore", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  map(size);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::read(uint64_t offset, void* data,
+                                         size_t size) const {
+  if (offset >= _dataSize) {
+    std::memcpy(data, _pending.data() + (offset - _dataSize), size);
+    return;
+  }
+  if (::pread(_dataFile, data, size, offset) != static_cast<ssize_t>(size)) {
+    throw std::filesystem::filesystem_error(
+        "Can't read PersistentStore", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::PersistentStore::get(uint64_t id,
+                                        std::string* value) const {
+  value->clear();
+  if (id >= _indexSize || _index[id] == 0) {
+    return false;
+  }
+  for (uint64_t next = _index[id]; next != 0;) {
+    RecordHeader header{};
+    read(next - 1, &header, sizeof(header));
+    const size_t pos = value->size();
+    value->resize(pos + header.size);
+    read(next - 1 + sizeof(header), value->data() + pos, header.size);
+    next = header.previous;
+  }
+  return true;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::write(uint64_t id, std::string_view value,
+                                          uint64_t previous) {
+  reserve(id);
+  const RecordHeader header{previous, value.size()};
+  _index[id] = _dataSize + _pending.size() + 1;
+  _pending.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  _pending.append(value);
+  if (_pending.size() >= PENDING_SIZE) {
+    flush();
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::put(uint64_t id, std::string_view value) {
+  write(id, value, 0);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::append(uint64_t id,
+                                           std::string_view value) {
+  write(id, value, id < _indexSize ? _index[id] : 0);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::erase(uint64_t id) {
+  if (id < _indexSize) {
+    _index[id] = 0;
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::flush() {
+  if (_pending.empty()) {
+    return;
+  }
+  if (::pwrite(_dataFile, _pending.data(), _pending.size(), _dataSize) !=
+      static_cast<ssize_t>(_pending.size())) {
+    throw std::filesystem::filesystem_error(
+        "Can't write PersistentStore", _path,
+        std::error_code(errno, std::generic_category()));
+  }
+  _dataSize += _pending.size();
+  _pending.clear();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::PersistentStore::sync() {
+  flush();
+  ::fsync(_dataFile);
+  if (_index != nullptr) {
+    ::msync(_index, _indexSize * sizeof(uint64_t), MS_SYNC);
+  }
+}
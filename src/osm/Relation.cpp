@@ -19,6 +19,7 @@
 #include <iostream>
 #include <vector>
 
+#include "osm2rdf/osm/OrientedBoundingBox.h"
 #include "osm2rdf/osm/Relation.h"
 #include "osm2rdf/osm/RelationHandler.h"
 #include "osm2rdf/osm/RelationMember.h"
@@ -33,10 +34,12 @@ osm2rdf::osm::Relation::Relation() {
 }
 
 // ____________________________________________________________________________
-osm2rdf::osm::Relation::Relation(const osmium::Relation& relation) {
+osm2rdf::osm::Relation::Relation(const osmium::Relation& relation,
+                                 std::pmr::memory_resource* resource)
+    : _members(resource),
+      _tags(osm2rdf::osm::convertTagList(relation.tags(), resource)) {
   _id = relation.positive_id();
   _timestamp = relation.timestamp().seconds_since_epoch();
-  _tags = std::move(osm2rdf::osm::convertTagList(relation.tags()));
   _members.reserve(relation.cmembers().size());
   for (const auto& member : relation.cmembers()) {
     _members.emplace_back(member);
@@ -67,7 +70,7 @@ const osm2rdf::osm::TagList& osm2rdf::osm::Relation::tags() const noexcept {
 bool osm2rdf::osm::Relation::isArea() const noexcept { return _isArea; }
 
 // ____________________________________________________________________________
-const std::vector<osm2rdf::osm::RelationMember>&
+const std::pmr::vector<osm2rdf::osm::RelationMember>&
 osm2rdf::osm::Relation::members() const noexcept {
   return _members;
 }
@@ -82,6 +85,9 @@ const ::util::geo::DCollection& osm2rdf::osm::Relation::geom() const noexcept {
   return _geom;
 }
 
+// ____________________________________________________________________________
+double osm2rdf::osm::Relation::length() const noexcept { return _length; }
+
 // ____________________________________________________________________________
 const ::util::geo::DBox& osm2rdf::osm::Relation::envelope() const noexcept {
   return _envelope;
@@ -101,49 +107,33 @@ const ::util::geo::DPolygon& osm2rdf::osm::Relation::orientedBoundingBox()
 
 // ____________________________________________________________________________
 const ::util::geo::DPoint osm2rdf::osm::Relation::centroid() const noexcept {
-  return ::util::geo::centroid(_geom);
+  return _centroid;
 }
 
 // ____________________________________________________________________________
+template <typename L>
 void osm2rdf::osm::Relation::buildGeometry(
-    osm2rdf::osm::RelationHandler& relationHandler) {
-  _hasCompleteGeometry = true;
+    osm2rdf::osm::RelationHandler<L>& relationHandler) {
+  std::vector<uint64_t> members;
+  members.reserve(_members.size());
   for (const auto& member : _members) {
-    if (member.type() == RelationMemberType::WAY) {
-      const auto& nodeRefs = relationHandler.get_noderefs_of_way(member.id());
-      if (nodeRefs.empty()) {
-        _hasCompleteGeometry = false;
-      }
-
-      ::util::geo::DLine way;
-      way.reserve(nodeRefs.size());
-      for (const auto& nodeRef : nodeRefs) {
-        const auto& res = relationHandler.get_node_location(nodeRef);
-        if (res.valid()) {
-          way.push_back({res.lon(), res.lat()});
-        } else {
-          _hasCompleteGeometry = false;
-        }
-      }
-
-      if (way.size() > 0) _geom.push_back(way);
-    } else if (member.type() == RelationMemberType::NODE) {
-      const auto& res = relationHandler.get_node_location(member.id());
-      if (res.valid()) {
-        _geom.push_back(::util::geo::DPoint{res.lon(), res.lat()});
-      } else {
-        _hasCompleteGeometry = false;
-      }
-    } else if (member.type() == RelationMemberType::RELATION) {
-      // Mark relations containing relations as incomplete for now.
-      _hasCompleteGeometry = false;
-    }
+    members.push_back(
+        RelationHandler<L>::packMember(member.type(), member.id()));
+  }
+  _hasCompleteGeometry = relationHandler.buildMemberGeometry(members, &_geom);
+  if (!_geom.empty()) {
+    // Incomplete geometries are written as well.
+    _length = ::util::geo::len(_geom);
+    _centroid = ::util::geo::centroid(_geom);
   }
 
   if (_hasCompleteGeometry && !_geom.empty()) {
     _envelope = ::util::geo::getBoundingBox(_geom);
     _convexHull = ::util::geo::convexHull(_geom);
-    _obb = ::util::geo::convexHull(::util::geo::getOrientedEnvelope(_geom));
+    _obb = osm2rdf::osm::orientedBoundingBox(_convexHull);
+    if (_obb.getOuter().empty()) {
+      _obb = ::util::geo::convexHull(::util::geo::getOrientedEnvelope(_geom));
+    }
   } else {
     _envelope = {{0, 0}, {0, 0}};
     _convexHull = ::util::geo::convexHull(_envelope);
@@ -168,3 +158,23 @@ bool osm2rdf::osm::Relation::operator!=(
     const osm2rdf::osm::Relation& other) const noexcept {
   return !(*this == other);
 }
+
+// ____________________________________________________________________________
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandler>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerRAMDense>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerRAMDensePaged>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerRAMFlex>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerRAMCompressed>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerRAMRequired>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerFSSparse>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerFSDense>&);
+template void osm2rdf::osm::Relation::buildGeometry(
+    osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerFSPersistent>&);
@@ -16,138 +16,427 @@
 // You should have received a copy of the GNU General Public License
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <utility>
 
 #include "osm2rdf/osm/RelationHandler.h"
+#include "osm2rdf/util/Time.h"
+
+static const size_t ARENA_CHUNK_SIZE = 16 * 1024 * 1024;
+static const size_t MAX_VARINT_BYTES = 10;
+
+// ____________________________________________________________________________
+static uint8_t* writeVarint(uint8_t* out, uint64_t value) {
+  while (value >= 0x80) {
+    *out++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(value);
+  return out;
+}
+
+// ____________________________________________________________________________
+static const uint8_t* readVarint(const uint8_t* in, uint64_t* value) {
+  uint64_t result = 0;
+  for (size_t shift = 0;; shift += 7) {
+    const uint8_t byte = *in++;
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+  *value = result;
+  return in;
+}
 
 // ____________________________________________________________________________
-osm2rdf::osm::RelationHandler::RelationHandler(
+template <typename L>
+osm2rdf::osm::RelationHandler<L>::RelationHandler(
     const osm2rdf::config::Config& config) {
   _config = config;
   _locationHandler = nullptr;
 }
 
 // ____________________________________________________________________________
-void osm2rdf::osm::RelationHandler::prepare_for_lookup() {
+template <typename L>
+void osm2rdf::osm::RelationHandler<L>::prepare_for_lookup() {
+  // Only keep the members of relations which are members of other relations.
+  _relationMembersBegin.push_back(_relationMembers.size());
+  std::vector<uint64_t> children;
+  for (const auto& src : _relationGraph.getVertices()) {
+    for (const auto& dst : _relationGraph.getEdges(src)) {
+      children.push_back(dst);
+    }
+  }
+  std::sort(children.begin(), children.end());
+  children.erase(std::unique(children.begin(), children.end()),
+                 children.end());
+
+  std::vector<std::pair<uint64_t, size_t>> kept;
+  for (size_t i = 0; i < _relationIds.size(); ++i) {
+    if (std::binary_search(children.begin(), children.end(),
+                           _relationIds[i])) {
+      kept.emplace_back(_relationIds[i], i);
+    }
+  }
+  std::sort(kept.begin(), kept.end());
+  std::vector<uint64_t> relationIds;
+  std::vector<size_t> relationMembersBegin;
+  std::vector<uint64_t> relationMembers;
+  for (const auto& [id, i] : kept) {
+    if (!relationIds.empty() && relationIds.back() == id) {
+      continue;
+    }
+    relationIds.push_back(id);
+    relationMembersBegin.push_back(relationMembers.size());
+    relationMembers.insert(
+        relationMembers.end(),
+        _relationMembers.begin() + _relationMembersBegin[i],
+        _relationMembers.begin() + _relationMembersBegin[i + 1]);
+  }
+  relationMembersBegin.push_back(relationMembers.size());
+  _relationIds = std::move(relationIds);
+  _relationMembersBegin = std::move(relationMembersBegin);
+  _relationMembers = std::move(relationMembers);
+
+  // The ways of area relations are only needed if they are kept.
+  for (const auto& member : _relationMembers) {
+    if (static_cast<RelationMemberType>(member & 3) ==
+        RelationMemberType::WAY) {
+      _wayIds.push_back(member >> 2);
+    }
+  }
+  std::sort(_wayIds.begin(), _wayIds.end());
+  _wayIds.erase(std::unique(_wayIds.begin(), _wayIds.end()), _wayIds.end());
+  _wayIds.shrink_to_fit();
+  _wayNodeRefs.assign(_wayIds.size(), nullptr);
+
+  for (const auto& id : _relationGraph.sortTopologicallyBottomUp()) {
+    if (relationIndex(id) != _relationIds.size()) {
+      _nestedOrder.push_back(id);
+    }
+  }
+  // Group the order into levels, the relation members of a relation are on
+  // lower levels. The relations of one level are built in parallel.
+  std::vector<size_t> levels(_relationIds.size(), 0);
+  size_t numLevels = 0;
+  for (const auto& id : _nestedOrder) {
+    const size_t index = relationIndex(id);
+    for (size_t i = _relationMembersBegin[index];
+         i < _relationMembersBegin[index + 1]; ++i) {
+      const uint64_t member = _relationMembers[i];
+      if (static_cast<RelationMemberType>(member & 3) !=
+          RelationMemberType::RELATION) {
+        continue;
+      }
+      const size_t child = relationIndex(member >> 2);
+      if (child != _relationIds.size()) {
+        levels[index] = std::max(levels[index], levels[child] + 1);
+      }
+    }
+    numLevels = std::max(numLevels, levels[index] + 1);
+  }
+  std::stable_sort(_nestedOrder.begin(), _nestedOrder.end(),
+                   [&](uint64_t a, uint64_t b) {
+                     return levels[relationIndex(a)] < levels[relationIndex(b)];
+                   });
+  _nestedLevelsBegin.assign(numLevels + 1, 0);
+  for (const auto& id : _nestedOrder) {
+    _nestedLevelsBegin[levels[relationIndex(id)] + 1]++;
+  }
+  for (size_t level = 0; level < numLevels; ++level) {
+    _nestedLevelsBegin[level + 1] += _nestedLevelsBegin[level];
+  }
+  if (_nestedOrder.size() < _relationIds.size()) {
+    std::cerr << osm2rdf::util::currentTimeFormatted() << "Skipping geometry "
+              << "of " << _relationIds.size() - _nestedOrder.size()
+              << " relations on or depending on membership cycles"
+              << std::endl;
+  }
+  _relationGraph = osm2rdf::util::DirectedGraph<uint64_t>{};
+  _nestedGeoms.resize(_relationIds.size());
+  _nestedComplete.assign(_relationIds.size(), 0);
   _firstPassDone = true;
 }
 
 // ____________________________________________________________________________
-void osm2rdf::osm::RelationHandler::setLocationHandler(
-    osm2rdf::osm::LocationHandler* locationHandler) {
+template <typename L>
+void osm2rdf::osm::RelationHandler<L>::setLocationHandler(L* locationHandler) {
   _locationHandler = locationHandler;
 }
 
 // ____________________________________________________________________________
-bool osm2rdf::osm::RelationHandler::hasLocationHandler() const {
+template <typename L>
+bool osm2rdf::osm::RelationHandler<L>::hasLocationHandler() const {
   return _locationHandler != nullptr;
 }
 
 // ____________________________________________________________________________
-osmium::Location osm2rdf::osm::RelationHandler::get_node_location(
-    const uint64_t nodeId) const {
-  return _locationHandler->get_node_location(nodeId);
+template <typename L>
+size_t osm2rdf::osm::RelationHandler<L>::wayIndex(const uint64_t wayId) const {
+  const auto it = std::lower_bound(_wayIds.begin(), _wayIds.end(), wayId);
+  if (it == _wayIds.end() || *it != wayId) {
+    return _wayIds.size();
+  }
+  return std::distance(_wayIds.begin(), it);
+}
+
+// ____________________________________________________________________________
+template <typename L>
+size_t osm2rdf::osm::RelationHandler<L>::relationIndex(
+    const uint64_t relationId) const {
+  const auto it =
+      std::lower_bound(_relationIds.begin(), _relationIds.end(), relationId);
+  if (it == _relationIds.end() || *it != relationId) {
+    return _relationIds.size();
+  }
+  return std::distance(_relationIds.begin(), it);
+}
+
+// ____________________________________________________________________________
+template <typename L>
+uint8_t* osm2rdf::osm::RelationHandler<L>::allocate(size_t size) {
+  if (_chunks.empty() || _chunkUsed + size > _chunkSize) {
+    _chunkSize = std::max(ARENA_CHUNK_SIZE, size);
+    _chunks.emplace_back(new uint8_t[_chunkSize]);
+    _chunkUsed = 0;
+  }
+  uint8_t* result = _chunks.back().get() + _chunkUsed;
+  _chunkUsed += size;
+  return result;
 }
 
 // ____________________________________________________________________________
-std::vector<uint64_t> osm2rdf::osm::RelationHandler::getNodeRefs(
-    const std::vector<uint32_t>& refs) const {
+template <typename L>
+std::vector<uint64_t> osm2rdf::osm::RelationHandler<L>::get_noderefs_of_way(
+    const uint64_t wayId) const {
   std::vector<uint64_t> ret;
-  ret.reserve(refs.size());
+  const size_t index = wayIndex(wayId);
+  if (index == _wayIds.size() || _wayNodeRefs[index] == nullptr) {
+    return ret;
+  }
+  const uint8_t* in = _wayNodeRefs[index];
+  uint64_t size;
+  in = readVarint(in, &size);
+  ret.reserve(size);
+  uint64_t last = 0;
+  for (uint64_t i = 0; i < size; ++i) {
+    uint64_t zigzag;
+    in = readVarint(in, &zigzag);
+    // Decode zigzag, all arithmetic wraps around.
+    last += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+    ret.push_back(last);
+  }
+  return ret;
+}
 
-  for (size_t i = 0; i < refs.size(); i++) {
-    if (refs[i] >> 31 == 0) {
-      ret.push_back(refs[i]);
-    } else {
-      uint64_t fullId;
+// ____________________________________________________________________________
+template <typename L>
+void osm2rdf::osm::RelationHandler<L>::get_node_locations(
+    const std::vector<uint64_t>& nodeIds,
+    std::vector<osmium::Location>* locations) const {
+  std::vector<std::pair<uint64_t, size_t>> sorted;
+  sorted.reserve(nodeIds.size());
+  for (size_t i = 0; i < nodeIds.size(); ++i) {
+    sorted.emplace_back(nodeIds[i], i);
+  }
+  std::sort(sorted.begin(), sorted.end());
 
-      fullId = static_cast<uint64_t>(refs[i] << 1 >> 1) << 32;
-      fullId += refs[i + 1];
+  locations->resize(nodeIds.size());
+  osmium::Location location;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    if (i == 0 || sorted[i].first != sorted[i - 1].first) {
+      location = _locationHandler->get_node_location(sorted[i].first);
+    }
+    (*locations)[sorted[i].second] = location;
+  }
+}
 
-      ret.push_back(fullId);
-      i++;
+// ____________________________________________________________________________
+template <typename L>
+bool osm2rdf::osm::RelationHandler<L>::buildMemberGeometry(
+    const std::vector<uint64_t>& members,
+    ::util::geo::DCollection* geom) const {
+  bool complete = true;
+
+  // Collect the node ids of all members first and look them up in one batch.
+  std::vector<uint64_t> nodeIds;
+  std::vector<size_t> wayLengths;
+  for (const auto& member : members) {
+    const auto type = static_cast<RelationMemberType>(member & 3);
+    if (type == RelationMemberType::WAY) {
+      const auto& nodeRefs = get_noderefs_of_way(member >> 2);
+      nodeIds.insert(nodeIds.end(), nodeRefs.begin(), nodeRefs.end());
+      wayLengths.push_back(nodeRefs.size());
+    } else if (type == RelationMemberType::NODE) {
+      nodeIds.push_back(member >> 2);
     }
   }
+  std::vector<osmium::Location> locations;
+  get_node_locations(nodeIds, &locations);
 
-  return ret;
+  size_t pos = 0;
+  size_t wayIndex = 0;
+  for (const auto& member : members) {
+    const auto type = static_cast<RelationMemberType>(member & 3);
+    if (type == RelationMemberType::WAY) {
+      const size_t numNodeRefs = wayLengths[wayIndex++];
+      if (numNodeRefs == 0) {
+        complete = false;
+      }
+
+      ::util::geo::DLine way;
+      way.reserve(numNodeRefs);
+      for (size_t i = 0; i < numNodeRefs; ++i) {
+        const auto& res = locations[pos++];
+        if (res.valid()) {
+          way.push_back({res.lon(), res.lat()});
+        } else {
+          complete = false;
+        }
+      }
+
+      if (way.size() > 0) geom->push_back(way);
+    } else if (type == RelationMemberType::NODE) {
+      const auto& res = locations[pos++];
+      if (res.valid()) {
+        geom->push_back(::util::geo::DPoint{res.lon(), res.lat()});
+      } else {
+        complete = false;
+      }
+    } else if (type == RelationMemberType::RELATION) {
+      const size_t index = relationIndex(member >> 2);
+      if (index == _relationIds.size() || _nestedComplete[index] == 0) {
+        complete = false;
+        continue;
+      }
+      geom->insert(geom->end(), _nestedGeoms[index].begin(),
+                   _nestedGeoms[index].end());
+    }
+  }
+  return complete;
 }
 
 // ____________________________________________________________________________
-std::vector<uint64_t> osm2rdf::osm::RelationHandler::get_noderefs_of_way(
-    const uint64_t wayId) {
-  if (wayId > std::numeric_limits<uint32_t>::max()) {
-    return getNodeRefs(_ways64[wayId]);
-  } else {
-    return getNodeRefs(_ways32[wayId]);
+template <typename L>
+void osm2rdf::osm::RelationHandler<L>::buildNestedGeometries() {
+  if (!_nestedOrder.empty()) {
+    std::cerr << osm2rdf::util::currentTimeFormatted() << "Building geometry "
+              << "of " << _nestedOrder.size() << " relations in "
+              << _nestedLevelsBegin.size() - 1 << " levels" << std::endl;
+  }
+  // Children are on lower levels, their geometries are complete before any
+  // parent uses them. Each relation only writes its own geometry.
+  for (size_t level = 0; level + 1 < _nestedLevelsBegin.size(); ++level) {
+    const size_t begin = _nestedLevelsBegin[level];
+    const size_t end = _nestedLevelsBegin[level + 1];
+#pragma omp taskloop
+    for (size_t i = begin; i < end; ++i) {
+      const size_t index = relationIndex(_nestedOrder[i]);
+      const std::vector<uint64_t> members(
+          _relationMembers.begin() + _relationMembersBegin[index],
+          _relationMembers.begin() + _relationMembersBegin[index + 1]);
+      _nestedComplete[index] =
+          buildMemberGeometry(members, &_nestedGeoms[index]) ? 1 : 0;
+    }
   }
+  _nestedGeometriesBuilt = true;
 }
 
 // ____________________________________________________________________________
-void osm2rdf::osm::RelationHandler::relation(const osmium::Relation& relation) {
+template <typename L>
+void osm2rdf::osm::RelationHandler<L>::relation(
+    const osmium::Relation& relation) {
   if (_firstPassDone) {
+    // Relations follow all nodes and ways in the input.
+    if (!_nestedGeometriesBuilt && _locationHandler != nullptr) {
+      buildNestedGeometries();
+    }
     return;
   }
 
-  // skip area relations completely
+  // Area relations are assembled by the AreaManager. Only their member ways
+  // are kept, as their geometry if they are members of other relations.
+  bool area = false;
   for (const auto& tag : relation.tags()) {
     if (strcmp(tag.key(), "type") == 0 &&
         (strcmp(tag.value(), "multipolygon") == 0 ||
          strcmp(tag.value(), "boundary") == 0))
-      return;
+      area = true;
   }
 
+  _relationIds.push_back(relation.positive_id());
+  _relationMembersBegin.push_back(_relationMembers.size());
   for (const auto& relationMember : relation.cmembers()) {
-    if (relationMember.type() == osmium::item_type::way) {
-      if (relationMember.positive_ref() >
-          std::numeric_limits<uint32_t>::max()) {
-        _ways64[relationMember.positive_ref()] = {};
-      } else {
-        _ways32[relationMember.positive_ref()] = {};
+    if (area) {
+      if (relationMember.type() == osmium::item_type::way) {
+        _relationMembers.push_back(packMember(
+            RelationMemberType::WAY, relationMember.positive_ref()));
       }
+      continue;
     }
-  }
-}
-
-// ____________________________________________________________________________
-std::vector<uint32_t> osm2rdf::osm::RelationHandler::getCompressedIDs(
-    const osmium::Way& way) const {
-  std::vector<uint32_t> compressed;
-  compressed.reserve(way.nodes().size() / 2);
-
-  for (const auto& nodeRef : way.nodes()) {
-    size_t nid = nodeRef.positive_ref();
-    if (nid <= std::numeric_limits<int32_t>::max()) {
-      // handle normally
-      compressed.push_back(nid);
-    } else if (nid <=
-               (static_cast<size_t>(std::numeric_limits<int64_t>::max()))) {
-      // handle with continuation
-      int32_t lower = nid << 32 >> 32;
-      int32_t upper = nid >> 32;
-      upper = upper | (1 << 31);
-      compressed.push_back(upper);
-      compressed.push_back(lower);
-    } else {
-      throw std::out_of_range("Node ID is too large");
+    auto type = RelationMemberType::UNKNOWN;
+    if (relationMember.type() == osmium::item_type::node) {
+      type = RelationMemberType::NODE;
+    } else if (relationMember.type() == osmium::item_type::way) {
+      type = RelationMemberType::WAY;
+      _wayIds.push_back(relationMember.positive_ref());
+    } else if (relationMember.type() == osmium::item_type::relation) {
+      type = RelationMemberType::RELATION;
+      _relationGraph.addEdge(relation.positive_id(),
+                             relationMember.positive_ref());
     }
+    _relationMembers.push_back(
+        packMember(type, relationMember.positive_ref()));
   }
-
-  return compressed;
 }
 
 // ____________________________________________________________________________
-void osm2rdf::osm::RelationHandler::way(const osmium::Way& way) {
+template <typename L>
+void osm2rdf::osm::RelationHandler<L>::way(const osmium::Way& way) {
   if (!_firstPassDone) {
     return;
   }
 
-  if (way.positive_id() > std::numeric_limits<uint32_t>::max()) {
-    if (_ways64.find(way.positive_id()) != _ways64.end()) {
-      _ways64[way.positive_id()] = std::move(getCompressedIDs(way));
-    }
-  } else {
-    if (_ways32.find(way.positive_id()) != _ways32.end()) {
-      _ways32[way.positive_id()] = std::move(getCompressedIDs(way));
-    }
+  const size_t index = wayIndex(way.positive_id());
+  if (index == _wayIds.size()) {
+    return;
   }
+
+  const auto& nodes = way.nodes();
+  uint8_t* out = allocate((nodes.size() + 1) * MAX_VARINT_BYTES);
+  _wayNodeRefs[index] = out;
+  uint8_t* const begin = out;
+  out = writeVarint(out, nodes.size());
+  uint64_t last = 0;
+  for (const auto& nodeRef : nodes) {
+    const uint64_t nid = nodeRef.positive_ref();
+    // Zigzag encode the delta, all arithmetic wraps around.
+    const uint64_t delta = nid - last;
+    out = writeVarint(out, (delta << 1) ^ (0 - (delta >> 63)));
+    last = nid;
+  }
+  // Return the unused part of the reserved space.
+  _chunkUsed -= (nodes.size() + 1) * MAX_VARINT_BYTES - (out - begin);
 }
+
+// ____________________________________________________________________________
+template class osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandler>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerRAMDense>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerRAMDensePaged>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerRAMFlex>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerRAMCompressed>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerRAMRequired>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerFSSparse>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerFSDense>;
+template class osm2rdf::osm::RelationHandler<
+    osm2rdf::osm::LocationHandlerFSPersistent>;
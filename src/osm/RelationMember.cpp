@@ -18,7 +18,7 @@
 
 #include "osm2rdf/osm/RelationMember.h"
 
-#include <string>
+#include <string_view>
 
 #include "osmium/osm/item_type.hpp"
 #include "osmium/osm/relation.hpp"
@@ -32,7 +32,7 @@ osm2rdf::osm::RelationMember::RelationMember() {
 osm2rdf::osm::RelationMember::RelationMember(
     const osmium::RelationMember& relationMember) {
   _id = relationMember.positive_ref();
-  _role = std::string(relationMember.role());
+  _role = relationMember.role();
   if (_role.empty()) {
     _role = "member";
   }
@@ -58,7 +58,7 @@ osm2rdf::osm::RelationMember::id_t osm2rdf::osm::RelationMember::id()
 }
 
 // ____________________________________________________________________________
-std::string osm2rdf::osm::RelationMember::role() const noexcept {
+std::string_view osm2rdf::osm::RelationMember::role() const noexcept {
   return _role;
 }
 
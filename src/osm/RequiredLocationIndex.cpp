@@ -0,0 +1,73 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/RequiredLocationIndex.h"
+
+#include <utility>
+
+// ____________________________________________________________________________
+void osm2rdf::osm::RequiredLocationIndex::setRequiredNodes(
+    osm2rdf::util::RankBitVector&& requiredNodes) {
+  _requiredNodes = std::move(requiredNodes);
+  _requiredNodes.buildRank();
+  _locations.clear();
+  _locations.resize(_requiredNodes.count());
+  _locations.shrink_to_fit();
+}
+
+// ____________________________________________________________________________
+size_t osm2rdf::osm::RequiredLocationIndex::used_memory() const noexcept {
+  return sizeof(RequiredLocationIndex) + _requiredNodes.used_memory() +
+         _locations.capacity() * sizeof(osmium::Location);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::RequiredLocationIndex::set(
+    const osmium::unsigned_object_id_type id, const osmium::Location value) {
+  if (!_requiredNodes.get(id)) {
+    return;
+  }
+  _locations[_requiredNodes.rank(id)] = value;
+}
+
+// ____________________________________________________________________________
+osmium::Location osm2rdf::osm::RequiredLocationIndex::get_noexcept(
+    const osmium::unsigned_object_id_type id) const noexcept {
+  if (!_requiredNodes.get(id)) {
+    return osmium::index::empty_value<osmium::Location>();
+  }
+  return _locations[_requiredNodes.rank(id)];
+}
+
+// ____________________________________________________________________________
+osmium::Location osm2rdf::osm::RequiredLocationIndex::get(
+    const osmium::unsigned_object_id_type id) const {
+  const auto value = get_noexcept(id);
+  if (value == osmium::index::empty_value<osmium::Location>()) {
+    throw osmium::not_found{id};
+  }
+  return value;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::RequiredLocationIndex::clear() {
+  _requiredNodes = osm2rdf::util::RankBitVector{};
+  _requiredNodes.buildRank();
+  _locations.clear();
+  _locations.shrink_to_fit();
+}
@@ -0,0 +1,89 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/ShardMemberHandler.h"
+
+#include <algorithm>
+
+// ____________________________________________________________________________
+osm2rdf::osm::ShardMemberHandler::ShardMemberHandler(
+    const osm2rdf::config::Config& config)
+    : _config(config) {}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ShardMemberHandler::addWays(
+    const osmium::Relation& relation) {
+  for (const auto& member : relation.members()) {
+    if (member.type() == osmium::item_type::way) {
+      _wayIds.push_back(member.positive_ref());
+    }
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ShardMemberHandler::relation(
+    const osmium::Relation& relation) {
+  if (_passes > 0) {
+    if (std::binary_search(_relationIds.begin(), _relationIds.end(),
+                           relation.positive_id())) {
+      addWays(relation);
+    }
+    return;
+  }
+
+  bool hasRelationMembers = false;
+  for (const auto& member : relation.members()) {
+    if (member.type() == osmium::item_type::relation) {
+      _relationGraph.addEdge(relation.positive_id(), member.positive_ref());
+      hasRelationMembers = true;
+    }
+  }
+  if (_config.isInShard(relation.positive_id())) {
+    addWays(relation);
+    if (hasRelationMembers) {
+      _parentIds.push_back(relation.positive_id());
+    }
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::ShardMemberHandler::prepare_for_lookup() {
+  if (_passes++ == 0) {
+    for (const auto& id : _parentIds) {
+      for (const auto& member : _relationGraph.findSuccessors(id)) {
+        if (!_config.isInShard(member)) {
+          _relationIds.push_back(member);
+        }
+      }
+    }
+    std::sort(_relationIds.begin(), _relationIds.end());
+    _relationIds.erase(std::unique(_relationIds.begin(), _relationIds.end()),
+                       _relationIds.end());
+    _parentIds.clear();
+    _relationGraph = osm2rdf::util::DirectedGraph<uint64_t>{};
+  }
+  _done = _passes > 1 || _relationIds.empty();
+  if (_done) {
+    std::sort(_wayIds.begin(), _wayIds.end());
+    _wayIds.erase(std::unique(_wayIds.begin(), _wayIds.end()), _wayIds.end());
+    _wayIds.shrink_to_fit();
+  }
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::ShardMemberHandler::done() const { return _done; }
@@ -0,0 +1,219 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/Snapshot.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "osm2rdf/osm/CountHandler.h"
+#include "osmium/io/pbf_output.hpp"
+#include "osmium/io/writer.hpp"
+
+static const size_t SNAPSHOT_BUFFER_SIZE = 1024 * 1024 * 10;
+static const size_t SNAPSHOT_FINGERPRINT_BLOCK = 1024 * 1024;
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// ____________________________________________________________________________
+static uint64_t fnv1a(uint64_t hash, const char* data, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+// ____________________________________________________________________________
+static uint64_t fnv1a(uint64_t hash, uint64_t value) {
+  return fnv1a(hash, reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::Snapshot::Snapshot(const osm2rdf::config::Config& config)
+    : _config(config) {
+  _key = fnv1a(FNV_OFFSET, SNAPSHOT_VERSION);
+  if (!_config.snapshot) {
+    // Avoid reading the input if snapshots are disabled.
+    return;
+  }
+  _key = fnv1a(_key, fingerprint(_config.input));
+  // Only options changing the results of the first pass are part of the key.
+  _key = fnv1a(_key, _config.addUntaggedNodes);
+  _key = fnv1a(_key, _config.addUntaggedWays);
+  _key = fnv1a(_key, _config.addUntaggedRelations);
+  _key = fnv1a(_key, _config.storeLocations == "mem-required");
+  _key = fnv1a(_key, _config.tagFilter.c_str(), _config.tagFilter.size());
+  _key = fnv1a(_key, _config.shardWorker ? _config.shards : 1);
+  _key = fnv1a(_key, _config.shard);
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::Snapshot::~Snapshot() {
+  if (_writer) {
+    // Incomplete snapshot, never publish it.
+    _writer->close();
+    _writer.reset();
+    std::filesystem::remove(relationsPath().string() + ".tmp");
+  }
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::osm::Snapshot::fingerprint(
+    const std::filesystem::path& path) {
+  uint64_t hash = FNV_OFFSET;
+  const std::string absolute = std::filesystem::absolute(path).string();
+  hash = fnv1a(hash, absolute.c_str(), absolute.size());
+  if (!std::filesystem::exists(path)) {
+    return hash;
+  }
+  const uint64_t size = std::filesystem::file_size(path);
+  hash = fnv1a(hash, size);
+  hash = fnv1a(hash, static_cast<uint64_t>(
+                         std::filesystem::last_write_time(path)
+                             .time_since_epoch()
+                             .count()));
+
+  std::ifstream ifs(path, std::ifstream::binary);
+  std::vector<char> block(SNAPSHOT_FINGERPRINT_BLOCK);
+  ifs.read(block.data(), block.size());
+  hash = fnv1a(hash, block.data(), ifs.gcount());
+  if (size > SNAPSHOT_FINGERPRINT_BLOCK) {
+    ifs.clear();
+    ifs.seekg(size - SNAPSHOT_FINGERPRINT_BLOCK);
+    ifs.read(block.data(), block.size());
+    hash = fnv1a(hash, block.data(), ifs.gcount());
+  }
+  return hash;
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::osm::Snapshot::key() const noexcept { return _key; }
+
+// ____________________________________________________________________________
+std::filesystem::path osm2rdf::osm::Snapshot::headerPath() const {
+  std::ostringstream oss;
+  oss << "pass1-" << std::hex << std::setw(16) << std::setfill('0') << _key
+      << ".snapshot";
+  return _config.getTempPath("osm2rdf", oss.str());
+}
+
+// ____________________________________________________________________________
+std::filesystem::path osm2rdf::osm::Snapshot::relationsPath() const {
+  std::ostringstream oss;
+  oss << "pass1-" << std::hex << std::setw(16) << std::setfill('0') << _key
+      << ".relations.osm.pbf";
+  return _config.getTempPath("osm2rdf", oss.str());
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::Snapshot::load(
+    osm2rdf::osm::CountHandler* countHandler) const {
+  if (!std::filesystem::exists(headerPath()) ||
+      !std::filesystem::exists(relationsPath())) {
+    return false;
+  }
+  std::ifstream ifs(headerPath(), std::ifstream::binary);
+  uint32_t version = 0;
+  uint64_t key = 0;
+  uint64_t values[5] = {0, 0, 0, 0, 0};
+  ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+  ifs.read(reinterpret_cast<char*>(&key), sizeof(key));
+  ifs.read(reinterpret_cast<char*>(values), sizeof(values));
+  if (!ifs.good() || version != SNAPSHOT_VERSION || key != _key) {
+    return false;
+  }
+  uint64_t numWords = 0;
+  ifs.read(reinterpret_cast<char*>(&numWords), sizeof(numWords));
+  std::vector<uint64_t> words(numWords);
+  ifs.read(reinterpret_cast<char*>(words.data()),
+           numWords * sizeof(uint64_t));
+  if (!ifs.good()) {
+    return false;
+  }
+  countHandler->restore(values[0], values[1], values[2], values[3], values[4],
+                        osm2rdf::util::RankBitVector{std::move(words)});
+  return true;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::Snapshot::startRecording() {
+  osmium::io::File file{relationsPath().string() + ".tmp", "pbf"};
+  _writer = std::make_unique<osmium::io::Writer>(
+      file, osmium::io::overwrite::allow);
+  _buffer = osmium::memory::Buffer{SNAPSHOT_BUFFER_SIZE,
+                                   osmium::memory::Buffer::auto_grow::yes};
+  _recording = true;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::Snapshot::relation(const osmium::Relation& relation) {
+  if (!_recording) {
+    return;
+  }
+  _buffer.add_item(relation);
+  _buffer.commit();
+  if (_buffer.committed() > SNAPSHOT_BUFFER_SIZE / 2) {
+    flushBuffer();
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::Snapshot::flushBuffer() {
+  (*_writer)(std::move(_buffer));
+  _buffer = osmium::memory::Buffer{SNAPSHOT_BUFFER_SIZE,
+                                   osmium::memory::Buffer::auto_grow::yes};
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::Snapshot::store(osm2rdf::osm::CountHandler& countHandler) {
+  if (!_recording) {
+    return;
+  }
+  flushBuffer();
+  _writer->close();
+  _writer.reset();
+  _recording = false;
+
+  const std::string headerTmp = headerPath().string() + ".tmp";
+  {
+    std::ofstream ofs(headerTmp, std::ofstream::binary | std::ofstream::trunc);
+    const uint32_t version = SNAPSHOT_VERSION;
+    const uint64_t values[5] = {
+        countHandler.numNodes(), countHandler.numRelations(),
+        countHandler.numWays(), countHandler.minNodeId(),
+        countHandler.maxNodeId()};
+    ofs.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    ofs.write(reinterpret_cast<const char*>(&_key), sizeof(_key));
+    ofs.write(reinterpret_cast<const char*>(values), sizeof(values));
+    const auto& words = countHandler.requiredNodes().words();
+    const uint64_t numWords = words.size();
+    ofs.write(reinterpret_cast<const char*>(&numWords), sizeof(numWords));
+    ofs.write(reinterpret_cast<const char*>(words.data()),
+              numWords * sizeof(uint64_t));
+    if (!ofs.good()) {
+      throw std::runtime_error("Could not write snapshot " + headerTmp);
+    }
+  }
+  // Relations first: a header without relations is never considered valid.
+  std::filesystem::rename(relationsPath().string() + ".tmp", relationsPath());
+  std::filesystem::rename(headerTmp, headerPath());
+}
@@ -0,0 +1,113 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/TagFilter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// ____________________________________________________________________________
+static std::string_view trim(std::string_view text) {
+  const size_t first = text.find_first_not_of(" \t");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+// ____________________________________________________________________________
+// Splits text at each separator and removes surrounding whitespace.
+static std::vector<std::string_view> split(std::string_view text,
+                                           char separator) {
+  std::vector<std::string_view> parts;
+  while (true) {
+    const size_t end = text.find(separator);
+    parts.push_back(trim(text.substr(0, end)));
+    if (end == std::string_view::npos) {
+      return parts;
+    }
+    text.remove_prefix(end + 1);
+  }
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::TagFilter::TagFilter(std::string_view expression) {
+  if (trim(expression).empty()) {
+    return;
+  }
+  const auto invalid = [&]() {
+    return std::invalid_argument("Invalid tag filter: " +
+                                 std::string(expression));
+  };
+  for (const auto& termText : split(expression, ',')) {
+    std::vector<Condition> term;
+    for (auto conditionText : split(termText, '&')) {
+      Condition condition;
+      if (!conditionText.empty() && conditionText.front() == '!') {
+        condition.negated = true;
+        conditionText.remove_prefix(1);
+      }
+      const size_t equals = conditionText.find('=');
+      condition.key = trim(conditionText.substr(0, equals));
+      if (condition.key.empty()) {
+        throw invalid();
+      }
+      if (equals != std::string_view::npos) {
+        const auto values = split(conditionText.substr(equals + 1), '|');
+        if (values.size() != 1 || values.front() != "*") {
+          for (const auto& value : values) {
+            if (value.empty()) {
+              throw invalid();
+            }
+            condition.values.emplace_back(value);
+          }
+        }
+      }
+      term.push_back(std::move(condition));
+    }
+    _terms.push_back(std::move(term));
+  }
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::TagFilter::matches(const Condition& condition,
+                                      const osmium::TagList& tags) noexcept {
+  const char* value = tags.get_value_by_key(condition.key.c_str());
+  bool result = value != nullptr;
+  if (result && !condition.values.empty()) {
+    result = std::any_of(condition.values.begin(), condition.values.end(),
+                         [&](const std::string& expected) {
+                           return std::strcmp(expected.c_str(), value) == 0;
+                         });
+  }
+  return result != condition.negated;
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::TagFilter::matches(
+    const osmium::TagList& tags) const noexcept {
+  if (_terms.empty()) {
+    return true;
+  }
+  return std::any_of(_terms.begin(), _terms.end(), [&](const auto& term) {
+    return std::all_of(term.begin(), term.end(), [&](const auto& condition) {
+      return matches(condition, tags);
+    });
+  });
+}
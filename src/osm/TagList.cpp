@@ -16,21 +16,18 @@
 // You should have received a copy of the GNU General Public License
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
-#include <algorithm>
 #include "osm2rdf/osm/TagList.h"
 
 #include "osmium/tags/taglist.hpp"
 
 // ____________________________________________________________________________
 osm2rdf::osm::TagList osm2rdf::osm::convertTagList(
-    const osmium::TagList& tagList) {
-  osm2rdf::osm::TagList result;
+    const osmium::TagList& tagList, std::pmr::memory_resource* resource) {
+  osm2rdf::osm::TagList result{resource};
   result.reserve(tagList.size());
 
   for (const auto& tag : tagList) {
-    std::string key{tag.key()};
-    std::replace(key.begin(), key.end(), ' ', '_');
-    result.push_back({key, tag.value()});
+    result.emplace_back(tag.key(), tag.value());
   }
   return result;
 }
@@ -0,0 +1,564 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/UpdateHandler.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "osm2rdf/osm/Area.h"
+#include "osm2rdf/osm/Node.h"
+#include "osm2rdf/osm/Relation.h"
+#include "osm2rdf/osm/RelationHandler.h"
+#include "osm2rdf/osm/Way.h"
+#include "osm2rdf/ttl/Constants.h"
+#include "osm2rdf/util/Time.h"
+#include "osmium/area/assembler.hpp"
+#include "osmium/area/multipolygon_manager.hpp"
+#include "osmium/builder/attr.hpp"
+#include "osmium/io/any_input.hpp"
+#include "osmium/osm/area.hpp"
+#include "osmium/osm/location.hpp"
+#include "osmium/visitor.hpp"
+
+using osm2rdf::ttl::constants::NAMESPACE__OSM2RDF;
+using osm2rdf::ttl::constants::NAMESPACE__OSM2RDF_GEOM;
+using osm2rdf::ttl::constants::NODE_NAMESPACE;
+using osm2rdf::ttl::constants::RELATION_NAMESPACE;
+using osm2rdf::ttl::constants::WAY_NAMESPACE;
+
+static const size_t UPDATE_BUFFER_SIZE = 1024 * 1024;
+
+// ____________________________________________________________________________
+// Returns the keys of map in ascending order.
+template <typename T>
+static std::vector<uint64_t> sortedIds(const T& map) {
+  std::vector<uint64_t> ids;
+  ids.reserve(map.size());
+  for (const auto& entry : map) {
+    if constexpr (std::is_same_v<typename T::value_type, uint64_t>) {
+      ids.push_back(entry);
+    } else {
+      ids.push_back(entry.first);
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// ____________________________________________________________________________
+template <typename W>
+osm2rdf::osm::UpdateHandler<W>::UpdateHandler(
+    const osm2rdf::config::Config& config,
+    osm2rdf::osm::FactHandler<W>* factHandler,
+    osm2rdf::ttl::Writer<W>* writer, osm2rdf::util::Output* output)
+    : _config(config),
+      _factHandler(factHandler),
+      _writer(writer),
+      _output(output),
+      _tagFilter(config.tagFilter),
+      _state(std::make_unique<osm2rdf::osm::UpdateState>(config, false)),
+      _changes(UPDATE_BUFFER_SIZE, osmium::memory::Buffer::auto_grow::yes),
+      _unchanged(UPDATE_BUFFER_SIZE, osmium::memory::Buffer::auto_grow::yes) {}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::handle() {
+  std::cerr << std::endl;
+  std::cerr << osm2rdf::util::currentTimeFormatted() << "Update ... (Read "
+            << _config.updateChanges << ")" << std::endl;
+  readChanges();
+  std::cerr << osm2rdf::util::currentTimeFormatted() << "... done"
+            << std::endl;
+
+  std::cerr << std::endl;
+  std::cerr << osm2rdf::util::currentTimeFormatted()
+            << "Update ... (Find affected objects in state "
+            << _state->sequence() << ")" << std::endl;
+  readAffected();
+  readMembers();
+  auto locationHandler =
+      std::make_unique<osm2rdf::osm::LocationHandlerRAMFlex>(_config, 0, 0);
+  readLocations(locationHandler.get());
+  std::cerr << osm2rdf::util::currentTimeFormatted() << "... done"
+            << std::endl;
+  std::cerr << osm2rdf::util::currentTimeFormatted()
+            << "changed: " << numChanged() << " affected: " << numAffected()
+            << std::endl;
+
+  std::cerr << std::endl;
+  std::cerr << osm2rdf::util::currentTimeFormatted()
+            << "Update ... (Write SPARQL update)" << std::endl;
+  writeDeletes();
+  writeInserts(locationHandler.get());
+  locationHandler->finalize();
+  std::cerr << osm2rdf::util::currentTimeFormatted() << "... done"
+            << std::endl;
+
+  std::cerr << std::endl;
+  std::cerr << osm2rdf::util::currentTimeFormatted()
+            << "Update ... (Advance state)" << std::endl;
+  writeState();
+  std::cerr << osm2rdf::util::currentTimeFormatted() << "... done"
+            << std::endl;
+}
+
+// ____________________________________________________________________________
+template <typename W>
+size_t osm2rdf::osm::UpdateHandler<W>::numChanged() const noexcept {
+  return _changedNodes.size() + _changedWays.size() + _changedRelations.size();
+}
+
+// ____________________________________________________________________________
+template <typename W>
+size_t osm2rdf::osm::UpdateHandler<W>::numAffected() const noexcept {
+  return _affectedWays.size() + _affectedRelations.size();
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::readChanges() {
+  osmium::io::Reader reader{osmium::io::File{_config.updateChanges.string()},
+                            osmium::osm_entity_bits::nwr};
+  while (auto buf = reader.read()) {
+    for (const auto& object : buf.select<osmium::OSMObject>()) {
+      std::unordered_map<uint64_t, size_t>* changed = nullptr;
+      switch (object.type()) {
+        case osmium::item_type::node:
+          changed = &_changedNodes;
+          break;
+        case osmium::item_type::way:
+          changed = &_changedWays;
+          break;
+        case osmium::item_type::relation:
+          changed = &_changedRelations;
+          break;
+        default:
+          continue;
+      }
+      const auto it = changed->find(object.positive_id());
+      if (it != changed->end() &&
+          _changes.get<osmium::OSMObject>(it->second).version() >
+              object.version()) {
+        continue;
+      }
+      const size_t offset = _changes.committed();
+      _changes.add_item(object);
+      _changes.commit();
+      (*changed)[object.positive_id()] = offset;
+    }
+  }
+  reader.close();
+}
+
+// ____________________________________________________________________________
+template <typename W>
+bool osm2rdf::osm::UpdateHandler<W>::readUnchanged(osmium::item_type type,
+                                                   uint64_t id) {
+  auto& unchanged =
+      type == osmium::item_type::way ? _unchangedWays : _unchangedRelations;
+  if (unchanged.count(id) > 0) {
+    return true;
+  }
+  const size_t offset = _unchanged.committed();
+  if (!_state->read(type, id, &_unchanged)) {
+    return false;
+  }
+  unchanged[id] = offset;
+  return true;
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::readAffected() {
+  // Objects whose geometry changed, their parents are checked next.
+  std::vector<std::pair<osmium::item_type, uint64_t>> pending;
+  for (const auto& id : sortedIds(_changedNodes)) {
+    pending.emplace_back(osmium::item_type::node, id);
+  }
+  for (const auto& id : sortedIds(_changedWays)) {
+    pending.emplace_back(osmium::item_type::way, id);
+  }
+  for (const auto& id : sortedIds(_changedRelations)) {
+    pending.emplace_back(osmium::item_type::relation, id);
+  }
+
+  std::vector<uint64_t> parentWays;
+  std::vector<uint64_t> parentRelations;
+  while (!pending.empty()) {
+    const osmium::item_type type = pending.back().first;
+    const uint64_t id = pending.back().second;
+    pending.pop_back();
+    parentWays.clear();
+    parentRelations.clear();
+    _state->parents(type, id, &parentWays, &parentRelations);
+
+    // The stored parents are candidates, only unchanged ways and relations
+    // still referencing the object are affected.
+    for (const auto& parent : parentWays) {
+      if (_changedWays.count(parent) > 0 ||
+          _affectedWays.count(parent) > 0 ||
+          !readUnchanged(osmium::item_type::way, parent)) {
+        continue;
+      }
+      const auto& nodes = way(parent)->nodes();
+      if (std::any_of(nodes.begin(), nodes.end(), [&](const auto& nodeRef) {
+            return nodeRef.positive_ref() == id;
+          })) {
+        _affectedWays.insert(parent);
+        pending.emplace_back(osmium::item_type::way, parent);
+      }
+    }
+    for (const auto& parent : parentRelations) {
+      if (_changedRelations.count(parent) > 0 ||
+          _affectedRelations.count(parent) > 0 ||
+          !readUnchanged(osmium::item_type::relation, parent)) {
+        continue;
+      }
+      const auto& members = relation(parent)->members();
+      if (std::any_of(members.begin(), members.end(), [&](const auto& member) {
+            return member.type() == type && member.positive_ref() == id;
+          })) {
+        _affectedRelations.insert(parent);
+        pending.emplace_back(osmium::item_type::relation, parent);
+      }
+    }
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::readMembers() {
+  std::vector<uint64_t> pending;
+  for (const auto& [id, offset] : _changedRelations) {
+    if (relation(id) != nullptr) {
+      pending.push_back(id);
+    }
+  }
+  pending.insert(pending.end(), _affectedRelations.begin(),
+                 _affectedRelations.end());
+  std::unordered_set<uint64_t> relationIds(pending.begin(), pending.end());
+  std::unordered_set<uint64_t> wayIds;
+  for (const auto& [id, offset] : _changedWays) {
+    wayIds.insert(id);
+  }
+  wayIds.insert(_affectedWays.begin(), _affectedWays.end());
+
+  // Collect all relation members recursively, members unknown to the state
+  // are ignored.
+  while (!pending.empty()) {
+    const uint64_t id = pending.back();
+    pending.pop_back();
+    if (_changedRelations.count(id) == 0) {
+      readUnchanged(osmium::item_type::relation, id);
+    }
+    const auto* current = relation(id);
+    if (current == nullptr) {
+      continue;
+    }
+    for (const auto& member : current->members()) {
+      const uint64_t ref = member.positive_ref();
+      if (member.type() == osmium::item_type::way) {
+        wayIds.insert(ref);
+      } else if (member.type() == osmium::item_type::relation &&
+                 relationIds.insert(ref).second) {
+        pending.push_back(ref);
+      }
+    }
+  }
+
+  for (const auto& id : sortedIds(relationIds)) {
+    if (relation(id) != nullptr) {
+      _relationIds.push_back(id);
+    }
+  }
+  for (const auto& id : sortedIds(wayIds)) {
+    if (_changedWays.count(id) == 0) {
+      readUnchanged(osmium::item_type::way, id);
+    }
+    if (way(id) != nullptr) {
+      _wayIds.push_back(id);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::readLocations(
+    osm2rdf::osm::LocationHandlerRAMFlex* locationHandler) {
+  std::unordered_set<uint64_t> nodeIds;
+  for (const auto& id : _wayIds) {
+    for (const auto& nodeRef : way(id)->nodes()) {
+      nodeIds.insert(nodeRef.positive_ref());
+    }
+  }
+  for (const auto& id : _relationIds) {
+    for (const auto& member : relation(id)->members()) {
+      if (member.type() == osmium::item_type::node) {
+        nodeIds.insert(member.positive_ref());
+      }
+    }
+  }
+  // The handler only stores nodes, build them from the stored locations.
+  osmium::memory::Buffer nodes{UPDATE_BUFFER_SIZE,
+                               osmium::memory::Buffer::auto_grow::yes};
+  for (const auto& id : sortedIds(nodeIds)) {
+    if (_changedNodes.count(id) > 0) {
+      continue;
+    }
+    const auto location = _state->location(id);
+    if (location.valid()) {
+      osmium::builder::add_node(
+          nodes,
+          osmium::builder::attr::_id(static_cast<osmium::object_id_type>(id)),
+          osmium::builder::attr::_location(location));
+    }
+  }
+  for (const auto& node : nodes.select<osmium::Node>()) {
+    locationHandler->node(node);
+  }
+  for (const auto& id : sortedIds(_changedNodes)) {
+    const auto& node = _changes.get<osmium::Node>(_changedNodes.at(id));
+    if (node.visible()) {
+      locationHandler->node(node);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::writeDelete(const std::string& subject) {
+  _output->write("DELETE { ", 0);
+  _output->write(subject, 0);
+  _output->write(" ?p ?o . ?o ?q ?v } WHERE { ", 0);
+  _output->write(subject, 0);
+  _output->write(" ?p ?o . OPTIONAL { ?o ?q ?v FILTER(isBlank(?o) || "
+                 "STRSTARTS(STR(?o), \"",
+                 0);
+  _output->write(_writer->resolvePrefix(NAMESPACE__OSM2RDF_GEOM), 0);
+  _output->write("\") || STRSTARTS(STR(?o), \"", 0);
+  _output->write(_writer->resolvePrefix(NAMESPACE__OSM2RDF), 0);
+  _output->write("\")) } } ;", 0);
+  _output->writeNewLine(0);
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::writeDeletes() {
+  const auto dataset = _config.sourceDataset;
+  for (const auto& id : sortedIds(_changedNodes)) {
+    writeDelete(_writer->generateIRI(NODE_NAMESPACE[dataset], id));
+  }
+  auto wayIds = sortedIds(_changedWays);
+  wayIds.insert(wayIds.end(), _affectedWays.begin(), _affectedWays.end());
+  std::sort(wayIds.begin(), wayIds.end());
+  for (const auto& id : wayIds) {
+    writeDelete(_writer->generateIRI(WAY_NAMESPACE[dataset], id));
+  }
+  auto relationIds = sortedIds(_changedRelations);
+  relationIds.insert(relationIds.end(), _affectedRelations.begin(),
+                     _affectedRelations.end());
+  std::sort(relationIds.begin(), relationIds.end());
+  for (const auto& id : relationIds) {
+    writeDelete(_writer->generateIRI(RELATION_NAMESPACE[dataset], id));
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::writeInserts(
+    osm2rdf::osm::LocationHandlerRAMFlex* locationHandler) {
+  const auto isUpdatedWay = [&](uint64_t id) {
+    return _changedWays.count(id) > 0 || _affectedWays.count(id) > 0;
+  };
+  const auto isUpdatedRelation = [&](uint64_t id) {
+    return _changedRelations.count(id) > 0 || _affectedRelations.count(id) > 0;
+  };
+
+  _output->write("INSERT DATA {", 0);
+  _output->writeNewLine(0);
+
+  for (const auto& id : sortedIds(_changedNodes)) {
+    const auto& node = _changes.get<osmium::Node>(_changedNodes.at(id));
+    if (!node.visible() || !isOutput(node)) {
+      continue;
+    }
+    try {
+      _factHandler->node(osm2rdf::osm::Node(node));
+    } catch (const osmium::invalid_location& e) {
+      continue;
+    }
+  }
+
+  // Copy the current versions into buffers in input order, the handlers see
+  // them like in the second pass of a full run.
+  osmium::memory::Buffer relations{UPDATE_BUFFER_SIZE,
+                                   osmium::memory::Buffer::auto_grow::yes};
+  for (const auto& id : _relationIds) {
+    relations.add_item(*relation(id));
+    relations.commit();
+  }
+  osmium::memory::Buffer ways{UPDATE_BUFFER_SIZE,
+                              osmium::memory::Buffer::auto_grow::yes};
+  for (const auto& id : _wayIds) {
+    ways.add_item(*way(id));
+    ways.commit();
+  }
+
+  osmium::area::Assembler::config_type assemblerConfig;
+  assemblerConfig.create_empty_areas = false;
+  osmium::area::MultipolygonManager<osmium::area::Assembler> mpManager{
+      assemblerConfig};
+  osm2rdf::osm::RelationHandler<osm2rdf::osm::LocationHandlerRAMFlex>
+      relationHandler{_config};
+  osmium::apply(relations, mpManager, relationHandler);
+  mpManager.prepare_for_lookup();
+  relationHandler.prepare_for_lookup();
+  relationHandler.setLocationHandler(locationHandler);
+
+  osmium::memory::Buffer areas{UPDATE_BUFFER_SIZE,
+                               osmium::memory::Buffer::auto_grow::yes};
+  osmium::apply(ways, *locationHandler, relationHandler,
+                mpManager.handler([&](osmium::memory::Buffer&& buffer) {
+                  areas.add_buffer(buffer);
+                  areas.commit();
+                }));
+
+  for (const auto& way : ways.select<osmium::Way>()) {
+    if (!isUpdatedWay(way.positive_id()) || !isOutput(way)) {
+      continue;
+    }
+    try {
+      osm2rdf::osm::Way osmWay(way);
+      if (!osmWay.isArea()) {
+        osmWay.finalize();
+      }
+      _factHandler->way(osmWay);
+    } catch (const osmium::invalid_location& e) {
+      continue;
+    }
+  }
+
+  for (const auto& area : areas.select<osmium::Area>()) {
+    const auto id = static_cast<uint64_t>(area.orig_id());
+    if (!(area.from_way() ? isUpdatedWay(id) : isUpdatedRelation(id)) ||
+        !isOutput(area)) {
+      continue;
+    }
+    try {
+      osm2rdf::osm::Area osmArea(area);
+      osmArea.finalize();
+      _factHandler->area(osmArea);
+    } catch (const osmium::invalid_location& e) {
+      continue;
+    }
+  }
+
+  // The first relation of the second pass builds the nested geometries.
+  osmium::apply(relations, relationHandler);
+  for (const auto& relation : relations.select<osmium::Relation>()) {
+    if (!isUpdatedRelation(relation.positive_id()) || !isOutput(relation)) {
+      continue;
+    }
+    try {
+      osm2rdf::osm::Relation osmRelation(relation);
+      if (!osmRelation.isArea()) {
+        osmRelation.buildGeometry(relationHandler);
+      }
+      _factHandler->relation(osmRelation);
+    } catch (const osmium::invalid_location& e) {
+      continue;
+    }
+  }
+
+  _output->write("}", 0);
+  _output->writeNewLine(0);
+}
+
+// ____________________________________________________________________________
+template <typename W>
+void osm2rdf::osm::UpdateHandler<W>::writeState() {
+  for (const auto& id : sortedIds(_changedNodes)) {
+    _state->apply(_changes.get<osmium::OSMObject>(_changedNodes.at(id)));
+  }
+  for (const auto& id : sortedIds(_changedWays)) {
+    _state->apply(_changes.get<osmium::OSMObject>(_changedWays.at(id)));
+  }
+  for (const auto& id : sortedIds(_changedRelations)) {
+    _state->apply(_changes.get<osmium::OSMObject>(_changedRelations.at(id)));
+  }
+  _state->commit();
+}
+
+// ____________________________________________________________________________
+template <typename W>
+bool osm2rdf::osm::UpdateHandler<W>::isOutput(
+    const osmium::OSMObject& object) const noexcept {
+  if (_config.noFacts || !_tagFilter.matches(object.tags())) {
+    return false;
+  }
+  const bool tagged = !object.tags().empty();
+  switch (object.type()) {
+    case osmium::item_type::node:
+      return !_config.noNodeFacts && (tagged || _config.addUntaggedNodes);
+    case osmium::item_type::way:
+      return !_config.noWayFacts && (tagged || _config.addUntaggedWays);
+    case osmium::item_type::relation:
+      return !_config.noRelationFacts &&
+             (tagged || _config.addUntaggedRelations);
+    case osmium::item_type::area:
+      return !_config.noAreaFacts && (tagged || _config.addUntaggedAreas);
+    default:
+      return false;
+  }
+}
+
+// ____________________________________________________________________________
+template <typename W>
+const osmium::Way* osm2rdf::osm::UpdateHandler<W>::way(uint64_t id) const {
+  if (const auto it = _changedWays.find(id); it != _changedWays.end()) {
+    const auto& way = _changes.get<osmium::Way>(it->second);
+    return way.visible() ? &way : nullptr;
+  }
+  const auto it = _unchangedWays.find(id);
+  return it == _unchangedWays.end() ? nullptr
+                                    : &_unchanged.get<osmium::Way>(it->second);
+}
+
+// ____________________________________________________________________________
+template <typename W>
+const osmium::Relation* osm2rdf::osm::UpdateHandler<W>::relation(
+    uint64_t id) const {
+  if (const auto it = _changedRelations.find(id);
+      it != _changedRelations.end()) {
+    const auto& relation = _changes.get<osmium::Relation>(it->second);
+    return relation.visible() ? &relation : nullptr;
+  }
+  const auto it = _unchangedRelations.find(id);
+  return it == _unchangedRelations.end()
+             ? nullptr
+             : &_unchanged.get<osmium::Relation>(it->second);
+}
+
+// ____________________________________________________________________________
+template class osm2rdf::osm::UpdateHandler<osm2rdf::ttl::format::NT>;
+template class osm2rdf::osm::UpdateHandler<osm2rdf::ttl::format::TTL>;
+template class osm2rdf::osm::UpdateHandler<osm2rdf::ttl::format::QLEVER>;
@@ -0,0 +1,319 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/UpdateState.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#include "osm2rdf/config/Constants.h"
+#include "osm2rdf/osm/Snapshot.h"
+#include "osmium/osm/node.hpp"
+
+static const char MAGIC[8] = {'O', '2', 'R', 'U', 'P', 'D', 'S', 'T'};
+// Node parents are stored per bucket of 2^NODE_BUCKET_BITS consecutive node
+// ids, which keeps their index small.
+static const int NODE_BUCKET_BITS = 5;
+// Number of pending parents merged into the parent stores at once.
+static const size_t PARENT_BATCH_SIZE = 1 << 22;
+
+// ____________________________________________________________________________
+// Ways and relations share the member parent store and the encoding of node
+// parents.
+static uint64_t memberKey(osmium::item_type type, uint64_t id) {
+  return id << 1 | (type == osmium::item_type::relation ? 1 : 0);
+}
+
+// ____________________________________________________________________________
+// Appends the parents of each key as one record, pending is cleared.
+static void mergeParents(std::vector<std::pair<uint64_t, uint64_t>>* pending,
+                         osm2rdf::osm::PersistentStore* store) {
+  std::sort(pending->begin(), pending->end());
+  pending->erase(std::unique(pending->begin(), pending->end()),
+                 pending->end());
+  std::vector<uint64_t> parents;
+  for (auto it = pending->begin(); it != pending->end();) {
+    const uint64_t key = it->first;
+    parents.clear();
+    for (; it != pending->end() && it->first == key; ++it) {
+      parents.push_back(it->second);
+    }
+    store->append(key, std::string_view{
+                           reinterpret_cast<const char*>(parents.data()),
+                           parents.size() * sizeof(uint64_t)});
+  }
+  pending->clear();
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::UpdateState::UpdateState(const osm2rdf::config::Config& config,
+                                       bool create)
+    : _config(config),
+      _headerPath(config.getTempPath("update", "state")),
+      _header(create ? createHeader(config, _headerPath)
+                     : readHeader(config, _headerPath)),
+      _ways(config.getTempPath("update", "ways"), create),
+      _relations(config.getTempPath("update", "relations"), create),
+      _nodeParents(config.getTempPath("update", "node-parents"), create),
+      _memberParents(config.getTempPath("update", "member-parents"), create) {
+  if (create) {
+    return;
+  }
+  _locations = std::make_unique<osm2rdf::osm::PersistentLocationIndex>(
+      config.getTempPath("osmium", "n2l.persistent.cache"));
+  if (_locations->fingerprint() != _header.locationsFingerprint) {
+    std::stringstream ss;
+    ss << "Node locations in " << config.cache
+       << " do not belong to the update state";
+    throw std::runtime_error(ss.str());
+  }
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::UpdateState::Header osm2rdf::osm::UpdateState::readHeader(
+    const osm2rdf::config::Config& config, const std::filesystem::path& path) {
+  Header header{};
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  const bool found =
+      fd != -1 && ::pread(fd, &header, sizeof(header), 0) == sizeof(header);
+  if (fd != -1) {
+    ::close(fd);
+  }
+  if (!found || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != UPDATE_STATE_VERSION || header.complete != 1 ||
+      header.inputFingerprint !=
+          osm2rdf::osm::Snapshot::fingerprint(config.input)) {
+    std::stringstream ss;
+    ss << "No complete update state for " << config.input << " in "
+       << config.cache << ", convert the input with --"
+       << osm2rdf::config::constants::UPDATE_STATE_OPTION_LONG << " first";
+    throw std::runtime_error(ss.str());
+  }
+  return header;
+}
+
+// ____________________________________________________________________________
+osm2rdf::osm::UpdateState::Header osm2rdf::osm::UpdateState::createHeader(
+    const osm2rdf::config::Config& config, const std::filesystem::path& path) {
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = UPDATE_STATE_VERSION;
+  header.complete = 0;
+  header.inputFingerprint = osm2rdf::osm::Snapshot::fingerprint(config.input);
+  // The LocationHandler of the full run writes the index for the input.
+  header.locationsFingerprint = header.inputFingerprint;
+  header.sequence = 0;
+  // Written before the stores are truncated.
+  writeHeader(path, header);
+  return header;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::writeHeader(const std::filesystem::path& path,
+                                            const Header& header) {
+  const int RWRWRW = 0666;
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, RWRWRW);
+  const bool written =
+      fd != -1 && ::pwrite(fd, &header, sizeof(header), 0) == sizeof(header) &&
+      ::fsync(fd) == 0;
+  const int error = errno;
+  if (fd != -1) {
+    ::close(fd);
+  }
+  if (!written) {
+    throw std::filesystem::filesystem_error(
+        "Can't write UpdateState", path,
+        std::error_code(error, std::generic_category()));
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::way(const osmium::Way& way) { store(way); }
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::relation(const osmium::Relation& relation) {
+  store(relation);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::store(const osmium::OSMObject& object) {
+  const std::string_view data{reinterpret_cast<const char*>(object.data()),
+                              object.padded_size()};
+  const uint64_t id = object.positive_id();
+  const uint64_t parent = memberKey(object.type(), id);
+  if (object.type() == osmium::item_type::way) {
+    _ways.put(id, data);
+    for (const auto& nodeRef :
+         static_cast<const osmium::Way&>(object).nodes()) {
+      _pendingNodeParents.emplace_back(
+          nodeRef.positive_ref() >> NODE_BUCKET_BITS, parent);
+    }
+  } else if (object.type() == osmium::item_type::relation) {
+    _relations.put(id, data);
+    for (const auto& member :
+         static_cast<const osmium::Relation&>(object).members()) {
+      if (member.type() == osmium::item_type::node) {
+        _pendingNodeParents.emplace_back(
+            member.positive_ref() >> NODE_BUCKET_BITS, parent);
+      } else if (member.type() == osmium::item_type::way ||
+                 member.type() == osmium::item_type::relation) {
+        _pendingMemberParents.emplace_back(
+            memberKey(member.type(), member.positive_ref()), id);
+      }
+    }
+  }
+  if (_pendingNodeParents.size() + _pendingMemberParents.size() >=
+      PARENT_BATCH_SIZE) {
+    flushParents();
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::flushParents() {
+  mergeParents(&_pendingNodeParents, &_nodeParents);
+  mergeParents(&_pendingMemberParents, &_memberParents);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::finalize() {
+  flushParents();
+  _ways.sync();
+  _relations.sync();
+  _nodeParents.sync();
+  _memberParents.sync();
+  _header.complete = 1;
+  writeHeader(_headerPath, _header);
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::osm::UpdateState::read(osmium::item_type type, uint64_t id,
+                                     osmium::memory::Buffer* buffer) const {
+  std::string value;
+  const auto& store = type == osmium::item_type::way ? _ways : _relations;
+  if (!store.get(id, &value)) {
+    return false;
+  }
+  std::memcpy(buffer->reserve_space(value.size()), value.data(),
+              value.size());
+  buffer->commit();
+  return true;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::parents(
+    osmium::item_type type, uint64_t id, std::vector<uint64_t>* ways,
+    std::vector<uint64_t>* relations) const {
+  std::string value;
+  if (type == osmium::item_type::node) {
+    if (!_nodeParents.get(id >> NODE_BUCKET_BITS, &value)) {
+      return;
+    }
+  } else if (!_memberParents.get(memberKey(type, id), &value)) {
+    return;
+  }
+  for (size_t pos = 0; pos < value.size(); pos += sizeof(uint64_t)) {
+    uint64_t parent;
+    std::memcpy(&parent, value.data() + pos, sizeof(parent));
+    if (type != osmium::item_type::node) {
+      relations->push_back(parent);
+    } else if ((parent & 1) == 1) {
+      relations->push_back(parent >> 1);
+    } else {
+      ways->push_back(parent >> 1);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+osmium::Location osm2rdf::osm::UpdateState::location(uint64_t id) const {
+  return _locations ? _locations->get_noexcept(id) : osmium::Location{};
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::advance() {
+  if (_advancing) {
+    return;
+  }
+  // An interrupted update leaves a state no update reads and a location
+  // index no full run reuses.
+  _advancing = true;
+  _header.complete = 0;
+  writeHeader(_headerPath, _header);
+  _locations->setFingerprint(0);
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::apply(const osmium::OSMObject& object) {
+  advance();
+  const uint64_t id = object.positive_id();
+  switch (object.type()) {
+    case osmium::item_type::node: {
+      const auto& node = static_cast<const osmium::Node&>(object);
+      _locations->reserve(id);
+      _locations->set(id,
+                      node.visible() ? node.location() : osmium::Location{});
+      break;
+    }
+    case osmium::item_type::way:
+      if (object.visible()) {
+        store(object);
+      } else {
+        _ways.erase(id);
+      }
+      break;
+    case osmium::item_type::relation:
+      if (object.visible()) {
+        store(object);
+      } else {
+        _relations.erase(id);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// ____________________________________________________________________________
+void osm2rdf::osm::UpdateState::commit() {
+  advance();
+  flushParents();
+  _ways.sync();
+  _relations.sync();
+  _nodeParents.sync();
+  _memberParents.sync();
+  _header.sequence++;
+  // The locations now belong to the input advanced by the change file.
+  _header.locationsFingerprint =
+      osm2rdf::osm::Snapshot::fingerprint(_config.updateChanges);
+  _locations->setFingerprint(_header.locationsFingerprint);
+  _header.complete = 1;
+  writeHeader(_headerPath, _header);
+  _advancing = false;
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::osm::UpdateState::sequence() const noexcept {
+  return _header.sequence;
+}
@@ -17,26 +17,33 @@
 // You should have received a copy of the GNU General Public License
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <vector>
 
 #include "osm2rdf/osm/Box.h"
-#include "osm2rdf/osm/Node.h"
+#include "osm2rdf/osm/FixedGeom.h"
+#include "osm2rdf/osm/OrientedBoundingBox.h"
 #include "osm2rdf/osm/TagList.h"
 #include "osm2rdf/osm/Way.h"
 #include "osmium/osm/way.hpp"
 
+// Node list of default constructed ways.
+static const osmium::WayNodeList EMPTY_WAY_NODES;
+
 // ____________________________________________________________________________
 osm2rdf::osm::Way::Way() {
   _id = std::numeric_limits<osm2rdf::osm::Way::id_t>::max();
+  _nodes = &EMPTY_WAY_NODES;
 }
 
 // ____________________________________________________________________________
-osm2rdf::osm::Way::Way(const osmium::Way& way) {
+osm2rdf::osm::Way::Way(const osmium::Way& way,
+                       std::pmr::memory_resource* resource)
+    : _tags(osm2rdf::osm::convertTagList(way.tags(), resource)) {
   _id = way.positive_id();
   _timestamp = way.timestamp().seconds_since_epoch();
-  _tags = std::move(osm2rdf::osm::convertTagList(way.tags()));
-  _nodes.reserve(way.nodes().size());
-  _geom.reserve(way.nodes().size());
+  _nodes = &way.nodes();
+  _fixedGeom.reserve(way.nodes().size());
 
   auto areaTag = way.tags()["area"];
   _hasAreaTag = areaTag == nullptr || strcmp(areaTag, "no") != 0;
@@ -60,11 +67,9 @@ osm2rdf::osm::Way::Way(const osmium::Way& way) {
       latMax = nodeRef.lat();
     }
 
-    _nodes.emplace_back(nodeRef);
-
-    if (_geom.empty() || (nodeRef.lon() != _geom.back().getX() ||
-                          nodeRef.lat() != _geom.back().getY())) {
-      _geom.push_back({nodeRef.lon(), nodeRef.lat()});
+    if (_fixedGeom.empty() || (nodeRef.x() != _fixedGeom.back().getX() ||
+                               nodeRef.y() != _fixedGeom.back().getY())) {
+      _fixedGeom.push_back(osm2rdf::osm::toFixed(nodeRef));
     }
   }
   _envelope = {{lonMin, latMin}, {lonMax, latMax}};
@@ -72,8 +77,11 @@ osm2rdf::osm::Way::Way(const osmium::Way& way) {
 
 // ____________________________________________________________________________
 void osm2rdf::osm::Way::finalize() {
-  _convexHull = ::util::geo::convexHull(_geom);
-  _obb = ::util::geo::convexHull(::util::geo::getOrientedEnvelope(_geom));
+  _convexHull = ::util::geo::convexHull(geom());
+  _obb = osm2rdf::osm::orientedBoundingBox(_convexHull);
+  if (_obb.getOuter().empty()) {
+    _obb = ::util::geo::convexHull(::util::geo::getOrientedEnvelope(geom()));
+  }
 }
 
 // ____________________________________________________________________________
@@ -88,16 +96,39 @@ const osm2rdf::osm::TagList& osm2rdf::osm::Way::tags() const noexcept {
 }
 
 // ____________________________________________________________________________
-const std::vector<osm2rdf::osm::Node>& osm2rdf::osm::Way::nodes()
-    const noexcept {
-  return _nodes;
+const osmium::WayNodeList& osm2rdf::osm::Way::nodes() const noexcept {
+  return *_nodes;
 }
 
 // ____________________________________________________________________________
 const ::util::geo::DLine& osm2rdf::osm::Way::geom() const noexcept {
+  if (_geom.size() != _fixedGeom.size()) {
+    // Convert and measure in a single pass.
+    _geom.clear();
+    _geom.reserve(_fixedGeom.size());
+    _length = 0;
+    for (const auto& point : _fixedGeom) {
+      const ::util::geo::DPoint p = osm2rdf::osm::toDouble(point);
+      if (!_geom.empty()) {
+        _length += ::util::geo::dist(_geom.back(), p);
+      }
+      _geom.push_back(p);
+    }
+  }
   return _geom;
 }
 
+// ____________________________________________________________________________
+double osm2rdf::osm::Way::length() const noexcept {
+  geom();
+  return _length;
+}
+
+// ____________________________________________________________________________
+const ::util::geo::I32Line& osm2rdf::osm::Way::fixedGeom() const noexcept {
+  return _fixedGeom;
+}
+
 // ____________________________________________________________________________
 const ::util::geo::DBox& osm2rdf::osm::Way::envelope() const noexcept {
   return _envelope;
@@ -116,18 +147,19 @@ const ::util::geo::DPolygon& osm2rdf::osm::Way::orientedBoundingBox()
 
 // ____________________________________________________________________________
 const ::util::geo::DPoint osm2rdf::osm::Way::centroid() const noexcept {
-  return ::util::geo::centroid(_geom);
+  return ::util::geo::centroid(geom());
 }
 
 // ____________________________________________________________________________
 bool osm2rdf::osm::Way::closed() const noexcept {
-  return _nodes.front().geom() == _nodes.back().geom();
+  return !_nodes->empty() &&
+         _nodes->front().location() == _nodes->back().location();
 }
 
 // ____________________________________________________________________________
 bool osm2rdf::osm::Way::isArea() const noexcept {
   // See libosmium/include/osmium/area/multipolygon_manager.hpp:154
-  if (_nodes.size() < 4) {
+  if (_nodes->size() < 4) {
     return false;
   }
   if (!closed()) {
@@ -139,8 +171,15 @@ bool osm2rdf::osm::Way::isArea() const noexcept {
 // ____________________________________________________________________________
 bool osm2rdf::osm::Way::operator==(
     const osm2rdf::osm::Way& other) const noexcept {
-  return _id == other._id && _envelope == other._envelope &&
-         _nodes == other._nodes && _geom == other._geom && _tags == other._tags;
+  if (_id != other._id || !(_envelope == other._envelope) ||
+      !(_fixedGeom == other._fixedGeom) || _tags != other._tags) {
+    return false;
+  }
+  return std::equal(_nodes->begin(), _nodes->end(), other._nodes->begin(),
+                    other._nodes->end(),
+                    [](const osmium::NodeRef& a, const osmium::NodeRef& b) {
+                      return a.ref() == b.ref() && a.location() == b.location();
+                    });
 }
 
 // ____________________________________________________________________________
@@ -18,8 +18,10 @@
 // along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <charconv>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <thread>
 #include <vector>
@@ -270,7 +272,10 @@ std::string osm2rdf::ttl::Writer<T>::generateBlankNode() {
 #if defined(_OPENMP)
   threadId = omp_get_thread_num();
 #endif
-  return "_:" + std::to_string(threadId) + "_" +
+  // Labels have to be unique in the concatenated output of all shards.
+  const std::string shard =
+      _config.shardWorker ? std::to_string(_config.shard) + "_" : "";
+  return "_:" + shard + std::to_string(threadId) + "_" +
          std::to_string(_blankNodeCount[threadId]++);
 }
 
@@ -312,6 +317,16 @@ std::string osm2rdf::ttl::Writer<T>::generateIRI(std::string_view p,
   return generateIRIUnsafe(p, std::to_string(v));
 }
 
+// ____________________________________________________________________________
+template <typename T>
+void osm2rdf::ttl::Writer<T>::generateIRI(std::string_view p, uint64_t v,
+                                          std::string* out) {
+  // Ids are always safe, format them without a temporary string.
+  char digits[std::numeric_limits<uint64_t>::digits10 + 1];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), v);
+  formatIRIUnsafe(p, std::string_view(digits, result.ptr - digits), out);
+}
+
 // ____________________________________________________________________________
 template <typename T>
 std::string osm2rdf::ttl::Writer<T>::generateIRIUnsafe(std::string_view p,
@@ -411,6 +426,13 @@ std::string osm2rdf::ttl::Writer<T>::generateLiteral(std::string_view v) {
   return STRING_LITERAL_QUOTE(v);
 }
 
+// ____________________________________________________________________________
+template <typename T>
+void osm2rdf::ttl::Writer<T>::generateLiteral(std::string_view v,
+                                              std::string* out) {
+  STRING_LITERAL_QUOTE(v, out);
+}
+
 // ____________________________________________________________________________
 template <typename T>
 std::string osm2rdf::ttl::Writer<T>::generateLiteral(std::string_view v,
@@ -436,8 +458,8 @@ std::string osm2rdf::ttl::Writer<T>::generateLiteralUnsafe(std::string_view v,
 // ____________________________________________________________________________
 template <typename T>
 void osm2rdf::ttl::Writer<T>::writeUnsafeIRILiteralTriple(
-    const std::string& s, const std::string& p, const std::string& v,
-    const std::string& o) {
+    const std::string& s, const std::string& p, std::string_view v,
+    std::string_view o) {
   size_t part = 0;
 
 #if defined(_OPENMP)
@@ -453,8 +475,8 @@ void osm2rdf::ttl::Writer<T>::writeUnsafeIRILiteralTriple(
 template <typename T>
 void osm2rdf::ttl::Writer<T>::writeUnsafeIRILiteralTriple(const std::string& s,
                                                           const std::string& p,
-                                                          const std::string& v,
-                                                          const std::string& o,
+                                                          std::string_view v,
+                                                          std::string_view o,
                                                           size_t part) {
   _out->write(s, part);
   _out->write(' ', part);
@@ -470,8 +492,8 @@ void osm2rdf::ttl::Writer<T>::writeUnsafeIRILiteralTriple(const std::string& s,
 template <typename T>
 void osm2rdf::ttl::Writer<T>::writeIRILiteralTriple(const std::string& s,
                                                     const std::string& p,
-                                                    const std::string& v,
-                                                    const std::string& o) {
+                                                    std::string_view v,
+                                                    std::string_view o) {
   size_t part = 0;
 
 #if defined(_OPENMP)
@@ -487,8 +509,8 @@ void osm2rdf::ttl::Writer<T>::writeIRILiteralTriple(const std::string& s,
 template <typename T>
 void osm2rdf::ttl::Writer<T>::writeIRILiteralTriple(const std::string& s,
                                                     const std::string& p,
-                                                    const std::string& v,
-                                                    const std::string& o,
+                                                    std::string_view v,
+                                                    std::string_view o,
                                                     size_t part) {
   _out->write(s, part);
   _out->write(' ', part);
@@ -631,6 +653,59 @@ std::string osm2rdf::ttl::Writer<osm2rdf::ttl::format::QLEVER>::formatIRIUnsafe(
   return IRIREFUnsafe(p, v);
 }
 
+// ____________________________________________________________________________
+template <>
+void osm2rdf::ttl::Writer<osm2rdf::ttl::format::NT>::formatIRIUnsafe(
+    std::string_view p, std::string_view v, std::string* out) {
+  // NT:  [8]    IRIREF
+  //      https://www.w3.org/TR/n-triples/#grammar-production-IRIREF
+  auto prefix = _prefixes.find(std::string{p});
+  if (prefix != _prefixes.end()) {
+    p = prefix->second;
+  }
+  out->clear();
+  *out += '<';
+  *out += p;
+  *out += v;
+  *out += '>';
+}
+
+// ____________________________________________________________________________
+template <>
+void osm2rdf::ttl::Writer<osm2rdf::ttl::format::TTL>::formatIRIUnsafe(
+    std::string_view p, std::string_view v, std::string* out) {
+  // TTL: [135s] iri, see formatIRIUnsafe(p, v)
+  out->clear();
+  if (_prefixes.find(std::string{p}) != _prefixes.end()) {
+    *out += p;
+    *out += ':';
+    *out += v;
+    return;
+  }
+  *out += '<';
+  *out += p;
+  *out += v;
+  *out += '>';
+}
+
+// ____________________________________________________________________________
+template <>
+void osm2rdf::ttl::Writer<osm2rdf::ttl::format::QLEVER>::formatIRIUnsafe(
+    std::string_view p, std::string_view v, std::string* out) {
+  // TTL: [135s] iri, see formatIRIUnsafe(p, v)
+  out->clear();
+  if (_prefixes.find(std::string{p}) != _prefixes.end()) {
+    *out += p;
+    *out += ':';
+    *out += v;
+    return;
+  }
+  *out += '<';
+  *out += p;
+  *out += v;
+  *out += '>';
+}
+
 // ____________________________________________________________________________
 template <>
 std::string osm2rdf::ttl::Writer<osm2rdf::ttl::format::TTL>::formatIRI(
@@ -750,28 +825,36 @@ std::string osm2rdf::ttl::Writer<T>::STRING_LITERAL_QUOTE(std::string_view s) {
   // TTL: [22]  STRING_LITERAL_QUOTE
   //      https://www.w3.org/TR/turtle/#grammar-production-STRING_LITERAL_QUOTE
   std::string tmp;
-  tmp.reserve(s.size() * 2);
-  tmp += "\"";
+  STRING_LITERAL_QUOTE(s, &tmp);
+  return tmp;
+}
+
+// ____________________________________________________________________________
+template <typename T>
+void osm2rdf::ttl::Writer<T>::STRING_LITERAL_QUOTE(std::string_view s,
+                                                   std::string* out) {
+  out->clear();
+  out->reserve(s.size() * 2);
+  *out += "\"";
   for (const auto c : s) {
     switch (c) {
       case '\"':  // #x22
-        tmp += "\\\"";
+        *out += "\\\"";
         break;
       case '\\':  // #x5C
-        tmp += "\\\\";
+        *out += "\\\\";
         break;
       case '\n':  // #x0A
-        tmp += "\\n";
+        *out += "\\n";
         break;
       case '\r':  // #x0D
-        tmp += "\\r";
+        *out += "\\r";
         break;
       default:
-        tmp += c;
+        *out += c;
     }
   }
-  tmp += "\"";
-  return tmp;
+  *out += "\"";
 }
 
 // ____________________________________________________________________________
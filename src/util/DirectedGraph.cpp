@@ -170,6 +170,45 @@ std::vector<T> osm2rdf::util::DirectedGraph<T>::getEdges(T src) const {
   return _adjacency.at(src);
 }
 
+// ____________________________________________________________________________
+template <typename T>
+std::vector<T> osm2rdf::util::DirectedGraph<T>::sortTopologicallyBottomUp()
+    const {
+  // Kahn's algorithm on the reversed graph: a vertex is ready once all its
+  // outgoing edges lead to vertices already in the result.
+  std::map<T, size_t> remaining;
+  std::map<T, std::vector<T>> predecessors;
+  std::queue<T> ready;
+  for (const auto& [src, list] : _adjacency) {
+    remaining[src] = list.size();
+    for (const auto& dst : list) {
+      predecessors[dst].push_back(src);
+    }
+    if (list.empty()) {
+      ready.push(src);
+    }
+  }
+
+  std::vector<T> result;
+  result.reserve(_adjacency.size());
+  while (!ready.empty()) {
+    auto cur = ready.front();
+    ready.pop();
+    result.push_back(cur);
+
+    const auto& entry = predecessors.find(cur);
+    if (entry == predecessors.end()) {
+      continue;
+    }
+    for (const auto& src : entry->second) {
+      if (--remaining[src] == 0) {
+        ready.push(src);
+      }
+    }
+  }
+  return result;
+}
+
 // ____________________________________________________________________________
 template class osm2rdf::util::DirectedGraph<uint8_t>;
 template class osm2rdf::util::DirectedGraph<uint16_t>;
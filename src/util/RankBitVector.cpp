@@ -0,0 +1,147 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/RankBitVector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <utility>
+
+static const uint64_t WORD_BITS = 64;
+static const uint64_t WORDS_PER_BLOCK = 8;
+
+// ____________________________________________________________________________
+osm2rdf::util::RankBitVector::RankBitVector(std::vector<uint64_t> words)
+    : _words(std::move(words)) {
+  buildRank();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::util::RankBitVector::set(uint64_t pos) {
+  const uint64_t word = pos / WORD_BITS;
+  if (word >= _words.size()) {
+    // Grow geometrically, ids arrive roughly sorted.
+    _words.resize(std::max(word + 1, _words.size() + _words.size() / 2), 0);
+  }
+  _words[word] |= 1ULL << (pos % WORD_BITS);
+  _ranks.clear();
+}
+
+// ____________________________________________________________________________
+void osm2rdf::util::RankBitVector::merge(const RankBitVector& other) {
+  if (other._words.size() > _words.size()) {
+    _words.resize(other._words.size(), 0);
+  }
+  for (size_t i = 0; i < other._words.size(); ++i) {
+    _words[i] |= other._words[i];
+  }
+  _ranks.clear();
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::util::RankBitVector::get(uint64_t pos) const noexcept {
+  const uint64_t word = pos / WORD_BITS;
+  if (word >= _words.size()) {
+    return false;
+  }
+  return (_words[word] >> (pos % WORD_BITS)) & 1;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::util::RankBitVector::buildRank() {
+  // Drop unused words from growing.
+  while (!_words.empty() && _words.back() == 0) {
+    _words.pop_back();
+  }
+  _words.shrink_to_fit();
+  _ranks.clear();
+  _ranks.reserve(_words.size() / WORDS_PER_BLOCK + 2);
+  uint64_t total = 0;
+  for (size_t i = 0; i < _words.size(); ++i) {
+    if (i % WORDS_PER_BLOCK == 0) {
+      _ranks.push_back(total);
+    }
+    total += __builtin_popcountll(_words[i]);
+  }
+  _ranks.push_back(total);
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::util::RankBitVector::rank(uint64_t pos) const noexcept {
+  assert(!_ranks.empty());
+  const uint64_t word = pos / WORD_BITS;
+  if (word >= _words.size()) {
+    return _ranks.back();
+  }
+  uint64_t result = _ranks[word / WORDS_PER_BLOCK];
+  for (uint64_t i = word - word % WORDS_PER_BLOCK; i < word; ++i) {
+    result += __builtin_popcountll(_words[i]);
+  }
+  const uint64_t bit = pos % WORD_BITS;
+  if (bit > 0) {
+    result += __builtin_popcountll(_words[word] << (WORD_BITS - bit));
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::util::RankBitVector::select(uint64_t k) const noexcept {
+  assert(k < count());
+  // Last block starting with at most k set bits before it.
+  const auto it = std::upper_bound(_ranks.begin(), _ranks.end() - 1, k);
+  const uint64_t block = std::distance(_ranks.begin(), it) - 1;
+  uint64_t remaining = k - _ranks[block];
+  uint64_t word = block * WORDS_PER_BLOCK;
+  while (true) {
+    const auto bits = static_cast<uint64_t>(__builtin_popcountll(_words[word]));
+    if (remaining < bits) {
+      break;
+    }
+    remaining -= bits;
+    word++;
+  }
+  uint64_t value = _words[word];
+  for (; remaining > 0; --remaining) {
+    // Clear lowest set bit.
+    value &= value - 1;
+  }
+  return word * WORD_BITS + __builtin_ctzll(value);
+}
+
+// ____________________________________________________________________________
+uint64_t osm2rdf::util::RankBitVector::count() const noexcept {
+  assert(!_ranks.empty());
+  return _ranks.back();
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::util::RankBitVector::empty() const noexcept {
+  return _words.empty();
+}
+
+// ____________________________________________________________________________
+const std::vector<uint64_t>& osm2rdf::util::RankBitVector::words()
+    const noexcept {
+  return _words;
+}
+
+// ____________________________________________________________________________
+size_t osm2rdf::util::RankBitVector::used_memory() const noexcept {
+  return (_words.capacity() + _ranks.capacity()) * sizeof(uint64_t);
+}
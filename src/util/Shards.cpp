@@ -0,0 +1,138 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/Shards.h"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "osm2rdf/config/Constants.h"
+#include "osm2rdf/config/ExitCode.h"
+#include "osm2rdf/util/Time.h"
+
+static const uint64_t SHARD_BLOCK_SIZE = 1 << 16;
+
+// ____________________________________________________________________________
+size_t osm2rdf::util::shardOf(uint64_t id, size_t shards) {
+  return (id / SHARD_BLOCK_SIZE) % shards;
+}
+
+// ____________________________________________________________________________
+size_t osm2rdf::util::shardOfRange(uint64_t first, uint64_t last,
+                                   size_t shards) {
+  if (shards > 1 && first / SHARD_BLOCK_SIZE != last / SHARD_BLOCK_SIZE) {
+    return shards;
+  }
+  return shardOf(first, shards);
+}
+
+// ____________________________________________________________________________
+std::filesystem::path osm2rdf::util::shardOutput(
+    const std::filesystem::path& output, size_t shard) {
+  std::filesystem::path path = output;
+  path += ".shard_" + std::to_string(shard);
+  return path;
+}
+
+// ____________________________________________________________________________
+int osm2rdf::util::runShards(const osm2rdf::config::Config& config, int argc,
+                             char** argv) {
+  std::vector<pid_t> workers;
+  for (size_t shard = 0; shard < config.shards; ++shard) {
+    std::vector<std::string> args(argv, argv + argc);
+    args.push_back("--" + osm2rdf::config::constants::SHARD_OPTION_LONG + "=" +
+                   std::to_string(shard));
+    std::vector<char*> workerArgv;
+    workerArgv.reserve(args.size() + 1);
+    for (auto& arg : args) {
+      workerArgv.push_back(arg.data());
+    }
+    workerArgv.push_back(nullptr);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+      std::perror("fork");
+      for (const auto& worker : workers) {
+        kill(worker, SIGTERM);
+        waitpid(worker, nullptr, 0);
+      }
+      return osm2rdf::config::ExitCode::FAILURE;
+    }
+    if (pid == 0) {
+      execvp(workerArgv[0], workerArgv.data());
+      std::perror("execvp");
+      _exit(osm2rdf::config::ExitCode::FAILURE);
+    }
+    std::cerr << osm2rdf::util::currentTimeFormatted() << "Started shard "
+              << shard << " as process " << pid << std::endl;
+    workers.push_back(pid);
+  }
+
+  bool failed = false;
+  for (size_t shard = 0; shard < workers.size(); ++shard) {
+    int status = 0;
+    if (waitpid(workers[shard], &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != osm2rdf::config::ExitCode::SUCCESS) {
+      std::cerr << osm2rdf::util::currentTimeFormatted() << "Shard " << shard
+                << " failed" << std::endl;
+      failed = true;
+    }
+  }
+  if (failed) {
+    return osm2rdf::config::ExitCode::FAILURE;
+  }
+  if (config.mergeOutput == osm2rdf::util::OutputMergeMode::NONE) {
+    return osm2rdf::config::ExitCode::SUCCESS;
+  }
+
+  // Concatenate in shard order, the result only depends on the input and the
+  // number of shards. Compressed shards are valid multi-stream files.
+  std::ofstream outFile{config.output,
+                        std::ofstream::out | std::ofstream::binary |
+                            std::ofstream::trunc};
+  if (!outFile.is_open()) {
+    std::cerr << "Can't open final output file: " << config.output
+              << " keeping files!" << std::endl;
+    return osm2rdf::config::ExitCode::FAILURE;
+  }
+  for (size_t shard = 0; shard < config.shards; ++shard) {
+    const auto filename = shardOutput(config.output, shard);
+    std::ifstream inFile{filename, std::ifstream::binary};
+    if (!inFile.is_open() || !inFile.good()) {
+      std::cerr << "Error opening file: " << filename << std::endl;
+      return osm2rdf::config::ExitCode::FAILURE;
+    }
+    if (inFile.peek() != std::ifstream::traits_type::eof()) {
+      outFile << inFile.rdbuf();
+    }
+    inFile.close();
+    if (!config.outputKeepFiles) {
+      std::filesystem::remove(filename);
+    }
+  }
+  outFile.flush();
+  return osm2rdf::config::ExitCode::SUCCESS;
+}
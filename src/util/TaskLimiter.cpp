@@ -0,0 +1,66 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/TaskLimiter.h"
+
+// ____________________________________________________________________________
+osm2rdf::util::TaskLimiter::TaskLimiter(std::size_t maxObjects,
+                                        std::size_t maxBytes)
+    : _maxObjects(maxObjects), _maxBytes(maxBytes) {}
+
+// ____________________________________________________________________________
+bool osm2rdf::util::TaskLimiter::add(std::size_t bytes) {
+  _objects++;
+  _bytes += bytes;
+  if ((_maxObjects > 0 && objects() >= _maxObjects) ||
+      (_maxBytes > 0 && this->bytes() >= _maxBytes)) {
+    _numWaits++;
+    return true;
+  }
+  return false;
+}
+
+// ____________________________________________________________________________
+void osm2rdf::util::TaskLimiter::done(std::size_t objects,
+                                      std::size_t bytes) noexcept {
+  _doneObjects.fetch_add(objects, std::memory_order_relaxed);
+  _doneBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// ____________________________________________________________________________
+bool osm2rdf::util::TaskLimiter::drained() const noexcept {
+  return (_maxObjects == 0 || objects() <= _maxObjects / 2) &&
+         (_maxBytes == 0 || bytes() <= _maxBytes / 2);
+}
+
+// ____________________________________________________________________________
+std::size_t osm2rdf::util::TaskLimiter::objects() const noexcept {
+  // A task may finish objects before the producer registered the last of
+  // them.
+  const std::size_t done = _doneObjects.load(std::memory_order_relaxed);
+  return _objects > done ? _objects - done : 0;
+}
+
+// ____________________________________________________________________________
+std::size_t osm2rdf::util::TaskLimiter::bytes() const noexcept {
+  const std::size_t done = _doneBytes.load(std::memory_order_relaxed);
+  return _bytes > done ? _bytes - done : 0;
+}
+
+// ____________________________________________________________________________
+std::size_t osm2rdf::util::TaskLimiter::numWaits() const { return _numWaits; }
@@ -0,0 +1,84 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/ThreadCounters.h"
+
+#include <algorithm>
+
+#if defined(_OPENMP)
+#include "omp.h"
+#endif
+
+// ____________________________________________________________________________
+static std::size_t slotCount(std::size_t numThreads) {
+#if defined(_OPENMP)
+  numThreads = std::max<std::size_t>(numThreads, omp_get_max_threads());
+#endif
+  return std::max<std::size_t>(numThreads, 1);
+}
+
+// ____________________________________________________________________________
+osm2rdf::util::ThreadCounters::ThreadCounters(std::size_t numThreads,
+                                              std::size_t numCounters)
+    : _numThreads(slotCount(numThreads)),
+      _linesPerThread((numCounters + kCountersPerLine - 1) / kCountersPerLine),
+      _lines(_numThreads * _linesPerThread) {
+  for (auto& line : _lines) {
+    for (auto& value : line.values) {
+      value.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+std::atomic<std::size_t>& osm2rdf::util::ThreadCounters::at(
+    std::size_t thread, std::size_t counter) {
+  return _lines[thread * _linesPerThread + counter / kCountersPerLine]
+      .values[counter % kCountersPerLine];
+}
+
+// ____________________________________________________________________________
+const std::atomic<std::size_t>& osm2rdf::util::ThreadCounters::at(
+    std::size_t thread, std::size_t counter) const {
+  return _lines[thread * _linesPerThread + counter / kCountersPerLine]
+      .values[counter % kCountersPerLine];
+}
+
+// ____________________________________________________________________________
+void osm2rdf::util::ThreadCounters::add(std::size_t counter,
+                                        std::size_t value) noexcept {
+  std::size_t thread = 0;
+#if defined(_OPENMP)
+  thread = omp_get_thread_num() % _numThreads;
+#endif
+  // Only the owning thread writes, so a relaxed load + store is sufficient
+  // and avoids a locked read-modify-write instruction.
+  auto& slot = at(thread, counter);
+  slot.store(slot.load(std::memory_order_relaxed) + value,
+             std::memory_order_relaxed);
+}
+
+// ____________________________________________________________________________
+std::size_t osm2rdf::util::ThreadCounters::get(
+    std::size_t counter) const noexcept {
+  std::size_t sum = 0;
+  for (std::size_t thread = 0; thread < _numThreads; ++thread) {
+    sum += at(thread, counter).load(std::memory_order_relaxed);
+  }
+  return sum;
+}
@@ -32,6 +32,13 @@ void assertDefaultConfig(const osm2rdf::config::Config& config) {
   ASSERT_FALSE(config.noFacts);
   ASSERT_FALSE(config.noGeometricRelations);
   ASSERT_TRUE(config.storeLocations.empty());
+  ASSERT_FALSE(config.parallelLocations);
+  ASSERT_FALSE(config.parallelAreas);
+  ASSERT_FALSE(config.blobIndex);
+  ASSERT_TRUE(config.clipBbox.empty());
+  ASSERT_TRUE(config.clipPolygon.empty());
+  ASSERT_TRUE(config.updateChanges.empty());
+  ASSERT_TRUE(config.tagFilter.empty());
 
   ASSERT_FALSE(config.noAreaFacts);
   ASSERT_FALSE(config.noNodeFacts);
@@ -61,6 +68,13 @@ void assertDefaultConfig(const osm2rdf::config::Config& config) {
   ASSERT_FALSE(config.outputKeepFiles);
 
   ASSERT_EQ(std::filesystem::temp_directory_path(), config.cache);
+  ASSERT_FALSE(config.snapshot);
+  ASSERT_FALSE(config.updateState);
+  ASSERT_EQ(1 << 16, config.maxInFlightObjects);
+  ASSERT_EQ(0, config.maxInFlightBytes);
+  ASSERT_EQ(1024, config.batchSize);
+  ASSERT_EQ(1, config.shards);
+  ASSERT_FALSE(config.shardWorker);
 }
 
 // ____________________________________________________________________________
@@ -764,6 +778,332 @@ TEST(CONFIG_Config, fromArgsOutputKeepFilesLong) {
   ASSERT_TRUE(config.outputKeepFiles);
 }
 
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsUpdateStateLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::UPDATE_STATE_OPTION_LONG;
+  const auto arg2 = "--" + osm2rdf::config::constants::SHARDS_OPTION_LONG;
+  const int argc = 7;
+  char* argv[argc] = {const_cast<char*>(""),
+                      const_cast<char*>(arg.c_str()),
+                      const_cast<char*>(arg2.c_str()),
+                      const_cast<char*>("4"),
+                      const_cast<char*>("-o"),
+                      const_cast<char*>("/tmp/dummyOutput"),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_TRUE(config.updateState);
+  ASSERT_EQ("disk-persistent", config.storeLocations);
+  ASSERT_EQ(1, config.shards);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsSnapshotLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::SNAPSHOT_OPTION_LONG;
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ("", config.output.string());
+  ASSERT_TRUE(config.snapshot);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsMaxInFlightLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto objectsArg =
+      "--" + osm2rdf::config::constants::MAX_IN_FLIGHT_OBJECTS_OPTION_LONG;
+  const auto bytesArg =
+      "--" + osm2rdf::config::constants::MAX_IN_FLIGHT_BYTES_OPTION_LONG;
+  const int argc = 6;
+  char* argv[argc] = {
+      const_cast<char*>(""),         const_cast<char*>(objectsArg.c_str()),
+      const_cast<char*>("1000"),     const_cast<char*>(bytesArg.c_str()),
+      const_cast<char*>("4096"),     const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ(1000, config.maxInFlightObjects);
+  ASSERT_EQ(4096, config.maxInFlightBytes);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsBatchSizeLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::BATCH_SIZE_OPTION_LONG;
+  const int argc = 4;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("1"),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ(1, config.batchSize);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsShardsLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::SHARDS_OPTION_LONG;
+  const int argc = 6;
+  char* argv[argc] = {const_cast<char*>(""),
+                      const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("4"),
+                      const_cast<char*>("-o"),
+                      const_cast<char*>("/tmp/dummyOutput"),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ(4, config.shards);
+  ASSERT_FALSE(config.shardWorker);
+  ASSERT_TRUE(config.storeLocations.empty());
+  ASSERT_TRUE(config.noGeometricRelations);
+  ASSERT_TRUE(config.isInShard(0));
+  ASSERT_TRUE(config.isInShard(1ULL << 20));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsShardLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::SHARDS_OPTION_LONG;
+  const auto argShard =
+      "--" + osm2rdf::config::constants::SHARD_OPTION_LONG + "=1";
+  const int argc = 7;
+  char* argv[argc] = {const_cast<char*>(""),
+                      const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("2"),
+                      const_cast<char*>(argShard.c_str()),
+                      const_cast<char*>("-o"),
+                      const_cast<char*>("/tmp/dummyOutput"),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ(2, config.shards);
+  ASSERT_TRUE(config.shardWorker);
+  ASSERT_EQ(1, config.shard);
+  ASSERT_EQ("/tmp/dummyOutput.bz2.shard_1", config.output.string());
+  ASSERT_FALSE(config.isInShard(0));
+  ASSERT_TRUE(config.isInShard(1 << 16));
+  ASSERT_EQ("mem-required", config.storeLocations);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsShardStoreLocations) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::SHARDS_OPTION_LONG;
+  const auto argShard =
+      "--" + osm2rdf::config::constants::SHARD_OPTION_LONG + "=1";
+  const auto argStore = "--" + osm2rdf::config::constants::STORE_LOCATIONS_LONG;
+  const int argc = 9;
+  char* argv[argc] = {const_cast<char*>(""),
+                      const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("2"),
+                      const_cast<char*>(argShard.c_str()),
+                      const_cast<char*>(argStore.c_str()),
+                      const_cast<char*>("mem-dense"),
+                      const_cast<char*>("-o"),
+                      const_cast<char*>("/tmp/dummyOutput"),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_TRUE(config.shardWorker);
+  ASSERT_EQ("mem-dense", config.storeLocations);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsShardCacheAndThreads) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::SHARDS_OPTION_LONG;
+  const auto argShard =
+      "--" + osm2rdf::config::constants::SHARD_OPTION_LONG + "=3";
+  const auto argThreads =
+      "--" + osm2rdf::config::constants::NUM_THREADS_OPTION_LONG;
+  const auto argCache = "--" + osm2rdf::config::constants::CACHE_OPTION_LONG;
+  const int argc = 11;
+  char* argv[argc] = {const_cast<char*>(""),
+                      const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("4"),
+                      const_cast<char*>(argShard.c_str()),
+                      const_cast<char*>(argThreads.c_str()),
+                      const_cast<char*>("10"),
+                      const_cast<char*>(argCache.c_str()),
+                      const_cast<char*>("/tmp"),
+                      const_cast<char*>("-o"),
+                      const_cast<char*>("/tmp/dummyOutput"),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ("/tmp/shard_3", config.cache.string());
+  ASSERT_TRUE(std::filesystem::is_directory(config.cache));
+  ASSERT_EQ(2, config.numThreads);
+  std::filesystem::remove("/tmp/shard_3");
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsShardsWithoutOutput) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::SHARDS_OPTION_LONG;
+  const int argc = 4;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("4"),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ(1, config.shards);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsParallelLocationsLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg =
+      "--" + osm2rdf::config::constants::PARALLEL_LOCATIONS_OPTION_LONG;
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_TRUE(config.parallelLocations);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsParallelAreasLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg =
+      "--" + osm2rdf::config::constants::PARALLEL_AREAS_OPTION_LONG;
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_TRUE(config.parallelAreas);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsBlobIndexLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::BLOB_INDEX_OPTION_LONG;
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_TRUE(config.blobIndex);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsClipBboxLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg =
+      "--" + osm2rdf::config::constants::CLIP_BBOX_OPTION_LONG + "=7,47,8,48";
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ("7,47,8,48", config.clipBbox);
+  ASSERT_TRUE(config.clipPolygon.empty());
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsClipPolygonLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+  osm2rdf::util::CacheFile cfPolygon("/tmp/dummyPolygon.poly");
+
+  const auto arg = "--" + osm2rdf::config::constants::CLIP_POLYGON_OPTION_LONG +
+                   "=/tmp/dummyPolygon.poly";
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_TRUE(config.clipBbox.empty());
+  ASSERT_EQ("/tmp/dummyPolygon.poly", config.clipPolygon.string());
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsUpdateLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+  osm2rdf::util::CacheFile cfChanges("/tmp/dummyChanges.osc");
+
+  const auto arg = "--" + osm2rdf::config::constants::UPDATE_OPTION_LONG +
+                   "=/tmp/dummyChanges.osc";
+  const auto arg2 =
+      "--" + osm2rdf::config::constants::OGC_GEO_TRIPLES_OPTION_LONG + "=none";
+  const int argc = 4;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>(arg2.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ("/tmp/dummyChanges.osc", config.updateChanges.string());
+  ASSERT_EQ("nt", config.outputFormat);
+  ASSERT_TRUE(config.noGeometricRelations);
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsUpdateRequiresNoGeometricRelations) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+  osm2rdf::util::CacheFile cfChanges("/tmp/dummyChanges.osc");
+
+  const auto arg = "--" + osm2rdf::config::constants::UPDATE_OPTION_LONG +
+                   "=/tmp/dummyChanges.osc";
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  ASSERT_EXIT(config.fromArgs(argc, argv),
+              ::testing::ExitedWithCode(
+                  osm2rdf::config::ExitCode::
+                      UPDATE_REQUIRES_NO_GEOMETRIC_RELATIONS),
+              "^Updates require a target written with");
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, fromArgsTagFilterLong) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  osm2rdf::util::CacheFile cf("/tmp/dummyInput");
+
+  const auto arg = "--" + osm2rdf::config::constants::TAG_FILTER_OPTION_LONG +
+                   "=highway=*,boundary=administrative";
+  const int argc = 3;
+  char* argv[argc] = {const_cast<char*>(""), const_cast<char*>(arg.c_str()),
+                      const_cast<char*>("/tmp/dummyInput")};
+  config.fromArgs(argc, argv);
+  ASSERT_EQ("highway=*,boundary=administrative", config.tagFilter);
+}
+
 // ____________________________________________________________________________
 TEST(CONFIG_Config, getInfoHasSections) {
   osm2rdf::config::Config config;
@@ -1000,4 +1340,125 @@ TEST(CONFIG_Config, getInfoOutputKeepFiles) {
                   osm2rdf::config::constants::OUTPUT_KEEP_FILES_OPTION_INFO));
 }
 
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoUpdateState) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.updateState = true;
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::UPDATE_STATE_INFO));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoSnapshot) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.snapshot = true;
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res,
+              ::testing::HasSubstr(osm2rdf::config::constants::SNAPSHOT_INFO));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoBlobIndex) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.blobIndex = true;
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(
+      res, ::testing::HasSubstr(osm2rdf::config::constants::BLOB_INDEX_INFO));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoParallelAreas) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.parallelAreas = true;
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::PARALLEL_AREAS_INFO));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoClip) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.clipBbox = "7,47,8,48";
+  config.clipPolygon = "/tmp/dummyPolygon.poly";
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res,
+              ::testing::HasSubstr(osm2rdf::config::constants::CLIP_BBOX_INFO +
+                                   " 7,47,8,48"));
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::CLIP_POLYGON_INFO +
+                       " /tmp/dummyPolygon.poly"));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoUpdate) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.updateChanges = "/tmp/dummyChanges.osc";
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res,
+              ::testing::HasSubstr(osm2rdf::config::constants::UPDATE_INFO +
+                                   " /tmp/dummyChanges.osc"));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoTagFilter) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.tagFilter = "highway=*";
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::TAG_FILTER_INFO +
+                       " highway=*"));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoMaxInFlight) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.maxInFlightBytes = 4096;
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::MAX_IN_FLIGHT_OBJECTS_INFO));
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::MAX_IN_FLIGHT_BYTES_INFO));
+}
+
+// ____________________________________________________________________________
+TEST(CONFIG_Config, getInfoShards) {
+  osm2rdf::config::Config config;
+  assertDefaultConfig(config);
+  config.shards = 4;
+  config.shardWorker = true;
+  config.shard = 2;
+
+  const std::string res = config.getInfo("");
+
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::SHARDS_INFO + " 4"));
+  ASSERT_THAT(res, ::testing::HasSubstr(
+                       osm2rdf::config::constants::SHARD_INFO + " 2"));
+}
+
 }  // namespace osm2rdf::config
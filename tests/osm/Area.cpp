@@ -21,6 +21,7 @@
 #include "gtest/gtest.h"
 #include "osmium/builder/attr.hpp"
 #include "osmium/builder/osm_object_builder.hpp"
+#include "util/geo/Geo.h"
 
 namespace osm2rdf::osm {
 
@@ -111,6 +112,40 @@ TEST(OSM_Area, BoundaryWithAdminLevel) {
   ASSERT_NEAR(7.61, a.envelope().getUpperRight().getY(), 0.01);
 }
 
+// ____________________________________________________________________________
+TEST(OSM_Area, lengthAndCentroid) {
+  // Create osmium object
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer osmiumBuffer{initial_buffer_size,
+                                      osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_area(osmiumBuffer, osmium::builder::attr::_id(42),
+                            osmium::builder::attr::_outer_ring({
+                                {1, {48.0, 7.51}},
+                                {2, {48.0, 7.61}},
+                                {3, {48.1, 7.61}},
+                                {4, {48.1, 7.51}},
+                                {1, {48.0, 7.51}},
+                            }),
+                            osmium::builder::attr::_inner_ring({
+                                {5, {48.02, 7.53}},
+                                {6, {48.04, 7.53}},
+                                {7, {48.04, 7.55}},
+                                {5, {48.02, 7.53}},
+                            }));
+
+  // Create osm2rdf object from osmium object
+  osm2rdf::osm::Area a{osmiumBuffer.get<osmium::Area>(0)};
+  a.finalize();
+  // The inner ring does not count towards the perimeter.
+  ASSERT_NEAR(0.4, a.length(), 1e-9);
+  ASSERT_DOUBLE_EQ(::util::geo::len(a.geom()), a.length());
+  const auto centroid = ::util::geo::centroid(a.geom());
+  ASSERT_DOUBLE_EQ(centroid.getX(), a.centroid().getX());
+  ASSERT_DOUBLE_EQ(centroid.getY(), a.centroid().getY());
+  // Memoized.
+  ASSERT_DOUBLE_EQ(centroid.getX(), a.centroid().getX());
+}
+
 // ____________________________________________________________________________
 TEST(OSM_Area, equalsOperator) {
   // Create osmium object
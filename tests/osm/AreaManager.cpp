@@ -0,0 +1,143 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/AreaManager.h"
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/area.hpp"
+#include "osmium/osm/item_type.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+// Holds back the assembly of relations until release is set.
+class BlockingAreaManager : public AreaManager {
+ public:
+  using AreaManager::AreaManager;
+  std::promise<void> release;
+
+ protected:
+  void assemble(const osmium::Relation& relation,
+                const std::vector<const osmium::Way*>& ways,
+                osmium::memory::Buffer* buffer) override {
+    _released.wait();
+    AreaManager::assemble(relation, ways, buffer);
+  }
+  std::shared_future<void> _released = release.get_future().share();
+};
+
+// ____________________________________________________________________________
+// Adds the ways 10 and 11 and the relations 20 and 21 to buffer. Way 10 is
+// untagged and only part of the multipolygon relation 20, way 11 is a closed
+// tagged way.
+void addAreaObjects(osmium::memory::Buffer* buffer) {
+  using namespace osmium::builder::attr;
+  const std::vector<osmium::NodeRef> ring = {
+      {1, osmium::Location(7.0, 48.0)},
+      {2, osmium::Location(7.1, 48.0)},
+      {3, osmium::Location(7.1, 48.1)},
+      {4, osmium::Location(7.0, 48.1)},
+      {1, osmium::Location(7.0, 48.0)}};
+  osmium::builder::add_way(*buffer, _id(10), _nodes(ring));
+  osmium::builder::add_way(*buffer, _id(11), _tag("building", "yes"),
+                           _nodes(ring));
+  osmium::builder::add_relation(*buffer, _id(20),
+                                _tag("type", "multipolygon"),
+                                _tag("landuse", "forest"),
+                                _member(osmium::item_type::way, 10, "outer"));
+  osmium::builder::add_relation(*buffer, _id(21), _tag("type", "route"),
+                                _member(osmium::item_type::way, 11, ""));
+}
+
+// ____________________________________________________________________________
+std::vector<osmium::object_id_type> assembleAreaIds(size_t numThreads) {
+  osmium::memory::Buffer buffer{10000,
+                                osmium::memory::Buffer::auto_grow::yes};
+  addAreaObjects(&buffer);
+
+  osmium::area::Assembler::config_type config;
+  config.create_empty_areas = false;
+  osm2rdf::osm::AreaManager manager{config, numThreads};
+  osmium::apply(buffer, manager);
+  manager.prepare_for_lookup();
+
+  std::vector<osmium::object_id_type> ids;
+  const auto collect = [&](osmium::memory::Buffer&& areas) {
+    for (const auto& area : areas.select<osmium::Area>()) {
+      ids.push_back(area.id());
+    }
+  };
+  osmium::apply(buffer, manager.handler(collect));
+  manager.wait();
+  manager.drain(collect);
+  EXPECT_EQ(0, manager.pending());
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// ____________________________________________________________________________
+TEST(OSM_AreaManager, assembleInReadingThread) {
+  const std::vector<osmium::object_id_type> expected = {22, 41};
+  ASSERT_EQ(expected, assembleAreaIds(0));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_AreaManager, assembleInPool) {
+  const std::vector<osmium::object_id_type> expected = {22, 41};
+  ASSERT_EQ(expected, assembleAreaIds(1));
+  ASSERT_EQ(expected, assembleAreaIds(4));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_AreaManager, readingContinuesWhileAssemblyPending) {
+  osmium::memory::Buffer buffer{10000,
+                                osmium::memory::Buffer::auto_grow::yes};
+  addAreaObjects(&buffer);
+
+  osmium::area::Assembler::config_type config;
+  config.create_empty_areas = false;
+  BlockingAreaManager manager{config, 1};
+  osmium::apply(buffer, manager);
+  manager.prepare_for_lookup();
+
+  std::vector<osmium::object_id_type> ids;
+  const auto collect = [&](osmium::memory::Buffer&& areas) {
+    for (const auto& area : areas.select<osmium::Area>()) {
+      ids.push_back(area.id());
+    }
+  };
+  // Way 10 completes relation 20, whose assembly is held back. The reading
+  // thread still passes way 11 and its area.
+  osmium::apply(buffer, manager.handler(collect));
+  ASSERT_EQ(1, manager.pending());
+  ASSERT_EQ(std::vector<osmium::object_id_type>{22}, ids);
+
+  manager.release.set_value();
+  manager.wait();
+  manager.drain(collect);
+  ASSERT_EQ(0, manager.pending());
+  ASSERT_EQ((std::vector<osmium::object_id_type>{22, 41}), ids);
+}
+
+}  // namespace osm2rdf::osm
@@ -0,0 +1,153 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/ClipHandler.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "osm2rdf/osm/AreaManager.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/area.hpp"
+#include "osmium/osm/item_type.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+osmium::memory::Buffer createClipBuffer() {
+  using namespace osmium::builder::attr;
+  osmium::memory::Buffer buffer{10000,
+                                osmium::memory::Buffer::auto_grow::yes};
+  // Node 1 inside, nodes 2 and 3 outside of the region.
+  osmium::builder::add_node(buffer, _id(1), _location(7.5, 47.5));
+  osmium::builder::add_node(buffer, _id(2), _location(9.0, 47.5));
+  osmium::builder::add_node(buffer, _id(3), _location(9.5, 47.5));
+  // Way 10 crosses the border, way 11 is outside.
+  osmium::builder::add_way(buffer, _id(10), _nodes({1, 2}));
+  osmium::builder::add_way(buffer, _id(11), _nodes({2, 3}));
+  // Relation 21 is only kept because of the later relation 22. Relation 23
+  // is kept complete with node 3.
+  osmium::builder::add_relation(buffer, _id(20),
+                                _member(osmium::item_type::way, 11, ""));
+  osmium::builder::add_relation(buffer, _id(21),
+                                _member(osmium::item_type::relation, 22, ""));
+  osmium::builder::add_relation(buffer, _id(22),
+                                _member(osmium::item_type::node, 1, ""));
+  osmium::builder::add_relation(buffer, _id(23),
+                                _member(osmium::item_type::node, 3, ""),
+                                _member(osmium::item_type::way, 10, ""));
+  return buffer;
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ClipHandler, keepsReferenceClosure) {
+  ClipHandler clipHandler{ClipRegion::fromBbox("7,47,8,48")};
+  const auto buffer = createClipBuffer();
+  osmium::apply(buffer, clipHandler);
+  clipHandler.prepare_for_lookup();
+  ASSERT_FALSE(clipHandler.hasIncompleteWays());
+  clipHandler.finalize();
+
+  ASSERT_EQ(3, clipHandler.numNodes());
+  ASSERT_EQ(1, clipHandler.numWays());
+  ASSERT_EQ(3, clipHandler.numRelations());
+  ASSERT_EQ(1, clipHandler.minNodeId());
+  ASSERT_EQ(3, clipHandler.maxNodeId());
+
+  std::vector<std::pair<osmium::item_type, osmium::object_id_type>> kept;
+  const auto filtered = clipHandler.filter(buffer);
+  for (const auto& object : filtered.select<osmium::OSMObject>()) {
+    kept.emplace_back(object.type(), object.id());
+  }
+  const std::vector<std::pair<osmium::item_type, osmium::object_id_type>>
+      expected{{osmium::item_type::node, 1},
+               {osmium::item_type::node, 2},
+               {osmium::item_type::node, 3},
+               {osmium::item_type::way, 10},
+               {osmium::item_type::relation, 21},
+               {osmium::item_type::relation, 22},
+               {osmium::item_type::relation, 23}};
+  ASSERT_EQ(expected, kept);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ClipHandler, keepsMultipolygonCrossingBorder) {
+  using namespace osmium::builder::attr;
+  osmium::memory::Buffer buffer{10000,
+                                osmium::memory::Buffer::auto_grow::yes};
+  const osmium::NodeRef n1{1, osmium::Location(7.5, 47.5)};
+  const osmium::NodeRef n2{2, osmium::Location(8.5, 47.5)};
+  const osmium::NodeRef n3{3, osmium::Location(8.5, 48.5)};
+  const osmium::NodeRef n4{4, osmium::Location(7.5, 48.5)};
+  // Only node 1 is inside of the region, the outer ring is split into three
+  // ways and way 31 is completely outside.
+  for (const auto& nodeRef : {n1, n2, n3, n4}) {
+    osmium::builder::add_node(buffer, _id(nodeRef.ref()),
+                              _location(nodeRef.location()));
+  }
+  osmium::builder::add_way(buffer, _id(30), _nodes({n1, n2}));
+  osmium::builder::add_way(buffer, _id(31), _nodes({n2, n3, n4}));
+  osmium::builder::add_way(buffer, _id(32), _nodes({n4, n1}));
+  osmium::builder::add_relation(buffer, _id(40), _tag("type", "multipolygon"),
+                                _tag("landuse", "forest"),
+                                _member(osmium::item_type::way, 30, "outer"),
+                                _member(osmium::item_type::way, 31, "outer"),
+                                _member(osmium::item_type::way, 32, "outer"));
+
+  ClipHandler clipHandler{ClipRegion::fromBbox("7,47,8,48")};
+  osmium::apply(buffer, clipHandler);
+  clipHandler.prepare_for_lookup();
+  ASSERT_TRUE(clipHandler.hasIncompleteWays());
+  for (const auto& way : buffer.select<osmium::Way>()) {
+    clipHandler.completeWay(way);
+  }
+  clipHandler.finalize();
+  ASSERT_EQ(4, clipHandler.numNodes());
+  ASSERT_EQ(3, clipHandler.numWays());
+  ASSERT_EQ(1, clipHandler.numRelations());
+
+  // The area of the relation is assembled from the clipped input.
+  auto filtered = clipHandler.filter(buffer);
+  osmium::area::Assembler::config_type config;
+  config.create_empty_areas = false;
+  osm2rdf::osm::AreaManager manager{config, 0};
+  osmium::apply(filtered, manager);
+  manager.prepare_for_lookup();
+  std::vector<osmium::object_id_type> areas;
+  osmium::apply(filtered,
+                manager.handler([&](osmium::memory::Buffer&& assembled) {
+                  for (const auto& area : assembled.select<osmium::Area>()) {
+                    areas.push_back(area.orig_id());
+                  }
+                }));
+  ASSERT_EQ(std::vector<osmium::object_id_type>{40}, areas);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ClipHandler, createFromConfig) {
+  osm2rdf::config::Config config;
+  ASSERT_EQ(nullptr, ClipHandler::create(config));
+  config.clipBbox = "7,47,8,48";
+  ASSERT_NE(nullptr, ClipHandler::create(config));
+  config.clipBbox = "7,47";
+  ASSERT_THROW(ClipHandler::create(config), std::invalid_argument);
+}
+
+}  // namespace osm2rdf::osm
@@ -0,0 +1,123 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/ClipRegion.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "osmium/osm/location.hpp"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+TEST(OSM_ClipRegion, fromBbox) {
+  const auto region = osm2rdf::osm::ClipRegion::fromBbox("7,47,8,48.5");
+  ASSERT_TRUE(region.contains(osmium::Location{7.5, 48.0}));
+  ASSERT_TRUE(region.contains(osmium::Location{7.0, 47.0}));
+  ASSERT_TRUE(region.contains(osmium::Location{8.0, 48.5}));
+  ASSERT_FALSE(region.contains(osmium::Location{8.1, 48.0}));
+  ASSERT_FALSE(region.contains(osmium::Location{7.5, 46.9}));
+  ASSERT_FALSE(region.contains(osmium::Location{}));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ClipRegion, fromBboxInvalid) {
+  ASSERT_THROW(osm2rdf::osm::ClipRegion::fromBbox("7,47,8"),
+               std::invalid_argument);
+  ASSERT_THROW(osm2rdf::osm::ClipRegion::fromBbox("7,47,8,48,9"),
+               std::invalid_argument);
+  ASSERT_THROW(osm2rdf::osm::ClipRegion::fromBbox("8,47,7,48"),
+               std::invalid_argument);
+  ASSERT_THROW(osm2rdf::osm::ClipRegion::fromBbox("7,47,8,91"),
+               std::invalid_argument);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ClipRegion, fromPolyFile) {
+  const std::filesystem::path path{"/tmp/osm2rdf-clipregion.poly"};
+  {
+    // Triangle with a square hole and a separate square.
+    std::ofstream ofs{path};
+    ofs << "test\n"
+        << "1\n"
+        << "   0.0E+00   0.0E+00\n"
+        << "   1.0E+01   0.0E+00\n"
+        << "   0.0E+00   1.0E+01\n"
+        << "END\n"
+        << "!2\n"
+        << "   1.0 1.0\n"
+        << "   2.0 1.0\n"
+        << "   2.0 2.0\n"
+        << "   1.0 2.0\n"
+        << "END\n"
+        << "3\n"
+        << "   20.0 20.0\n"
+        << "   21.0 20.0\n"
+        << "   21.0 21.0\n"
+        << "   20.0 21.0\n"
+        << "   20.0 20.0\n"
+        << "END\n"
+        << "END\n";
+  }
+  const auto region = osm2rdf::osm::ClipRegion::fromPolyFile(path);
+  ASSERT_TRUE(region.contains(osmium::Location{0.5, 0.5}));
+  ASSERT_TRUE(region.contains(osmium::Location{4.0, 5.0}));
+  ASSERT_TRUE(region.contains(osmium::Location{20.5, 20.5}));
+  // Inside the envelope, but outside the triangle.
+  ASSERT_FALSE(region.contains(osmium::Location{6.0, 6.0}));
+  // Inside the hole.
+  ASSERT_FALSE(region.contains(osmium::Location{1.5, 1.5}));
+  ASSERT_FALSE(region.contains(osmium::Location{15.0, 15.0}));
+  ASSERT_FALSE(region.contains(osmium::Location{-1.0, 0.5}));
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ClipRegion, fromPolyFileInvalid) {
+  const std::filesystem::path path{"/tmp/osm2rdf-clipregion.poly"};
+  {
+    std::ofstream ofs{path};
+    ofs << "test\n"
+        << "1\n"
+        << "   0.0 0.0\n"
+        << "   abc 1.0\n"
+        << "END\n"
+        << "END\n";
+  }
+  ASSERT_THROW(osm2rdf::osm::ClipRegion::fromPolyFile(path),
+               std::runtime_error);
+  {
+    // Missing final END.
+    std::ofstream ofs{path};
+    ofs << "test\n"
+        << "1\n"
+        << "   0.0 0.0\n"
+        << "   1.0 0.0\n"
+        << "   1.0 1.0\n"
+        << "END\n";
+  }
+  ASSERT_THROW(osm2rdf::osm::ClipRegion::fromPolyFile(path),
+               std::runtime_error);
+  std::filesystem::remove(path);
+  ASSERT_THROW(osm2rdf::osm::ClipRegion::fromPolyFile(path),
+               std::runtime_error);
+}
+
+}  // namespace osm2rdf::osm
@@ -0,0 +1,110 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/CompressedLocationIndex.h"
+
+#include <limits>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+TEST(OSM_CompressedLocationIndex, setAndGet) {
+  osm2rdf::osm::CompressedLocationIndex index{10, 20};
+  ASSERT_EQ(11, index.size());
+  index.set(10, osmium::Location{7.51, 48.0});
+  index.set(12, osmium::Location{0.0, 0.0});
+  index.set(13, osmium::Location{-179.5, -89.5});
+  ASSERT_EQ(osmium::Location(7.51, 48.0), index.get(10));
+  ASSERT_EQ(osmium::Location(0.0, 0.0), index.get(12));
+  ASSERT_EQ(osmium::Location(-179.5, -89.5), index.get(13));
+  // Unset and out of range ids are invalid.
+  ASSERT_FALSE(index.get_noexcept(11).valid());
+  ASSERT_FALSE(index.get_noexcept(9).valid());
+  ASSERT_FALSE(index.get_noexcept(21).valid());
+  ASSERT_THROW(index.get(11), osmium::not_found);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_CompressedLocationIndex, multipleBlocks) {
+  osm2rdf::osm::CompressedLocationIndex index{1, 10000};
+  for (size_t id = 1; id <= 10000; id += 3) {
+    index.set(id, osmium::Location{(id % 360) - 180.0, (id % 180) - 90.0});
+  }
+  for (size_t id = 1; id <= 10000; ++id) {
+    if ((id - 1) % 3 == 0) {
+      ASSERT_EQ(osmium::Location((id % 360) - 180.0, (id % 180) - 90.0),
+                index.get(id));
+    } else {
+      ASSERT_FALSE(index.get_noexcept(id).valid());
+    }
+  }
+}
+
+// ____________________________________________________________________________
+TEST(OSM_CompressedLocationIndex, unsortedSet) {
+  osm2rdf::osm::CompressedLocationIndex index{0, 1000};
+  index.set(5, osmium::Location{1.0, 1.0});
+  index.set(900, osmium::Location{2.0, 2.0});
+  // Lookup caches the stored block before it is changed.
+  ASSERT_EQ(osmium::Location(1.0, 1.0), index.get(5));
+  index.set(6, osmium::Location{3.0, 3.0});
+  ASSERT_EQ(osmium::Location(1.0, 1.0), index.get(5));
+  ASSERT_EQ(osmium::Location(3.0, 3.0), index.get(6));
+  ASSERT_EQ(osmium::Location(2.0, 2.0), index.get(900));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_CompressedLocationIndex, concurrentGet) {
+  osm2rdf::osm::CompressedLocationIndex index{0, 100000};
+  for (size_t id = 0; id <= 100000; ++id) {
+    index.set(id, osmium::Location{static_cast<int32_t>(id), 0});
+  }
+  index.sort();
+  std::vector<std::thread> threads;
+  std::vector<size_t> errors(4, 0);
+  for (size_t t = 0; t < errors.size(); ++t) {
+    threads.emplace_back([&index, &errors, t]() {
+      for (size_t id = t; id <= 100000; id += 7) {
+        if (index.get_noexcept(id).x() != static_cast<int32_t>(id)) {
+          errors[t]++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& error : errors) {
+    ASSERT_EQ(0, error);
+  }
+}
+
+// ____________________________________________________________________________
+TEST(OSM_CompressedLocationIndex, noNodes) {
+  // Range of a CountHandler without nodes.
+  osm2rdf::osm::CompressedLocationIndex index{
+      std::numeric_limits<size_t>::max(), 0};
+  ASSERT_EQ(0, index.size());
+  index.set(15, osmium::Location{7.51, 48.0});
+  ASSERT_FALSE(index.get_noexcept(15).valid());
+}
+
+}  // namespace osm2rdf::osm
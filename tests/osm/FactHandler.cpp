@@ -362,6 +362,177 @@ TEST(OSM_FactHandler, relationHandler) {
   ASSERT_EQ(c, d);
 }
 
+// ____________________________________________________________________________
+TEST(OSM_FactHandler, relationHandlerNodeLocations) {
+  osm2rdf::config::Config config;
+
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer osmiumBuffer{initial_buffer_size,
+                                      osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(1),
+      osmium::builder::attr::_location(osmium::Location(7.52, 48.0)));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(2),
+      osmium::builder::attr::_location(osmium::Location(7.61, 48.0)));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(23),
+      osmium::builder::attr::_location(osmium::Location(7.51, 48.0)));
+
+  RelationHandler rh = RelationHandler(config);
+  LocationHandler* lh = LocationHandler::create(config, 0, 0);
+  for (const auto& node : osmiumBuffer.select<osmium::Node>()) {
+    lh->node(node);
+  }
+  rh.prepare_for_lookup();
+  rh.setLocationHandler(lh);
+
+  // Unsorted, duplicate and unknown ids.
+  const std::vector<uint64_t> nodeIds{23, 1, 23, 99, 2};
+  std::vector<osmium::Location> locations;
+  rh.get_node_locations(nodeIds, &locations);
+
+  ASSERT_EQ(nodeIds.size(), locations.size());
+  ASSERT_EQ(osmium::Location(7.51, 48.0), locations[0]);
+  ASSERT_EQ(osmium::Location(7.52, 48.0), locations[1]);
+  ASSERT_EQ(osmium::Location(7.51, 48.0), locations[2]);
+  ASSERT_FALSE(locations[3].valid());
+  ASSERT_EQ(osmium::Location(7.61, 48.0), locations[4]);
+
+  delete lh;
+}
+
+// ____________________________________________________________________________
+TEST(OSM_FactHandler, relationHandlerNestedGeometry) {
+  osm2rdf::config::Config config;
+
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer osmiumBuffer{initial_buffer_size,
+                                      osmium::memory::Buffer::auto_grow::yes};
+  // 42 -> 43 -> way 55, 46 -> 44 <-> 45
+  osmium::builder::add_relation(
+      osmiumBuffer, osmium::builder::attr::_id(42),
+      osmium::builder::attr::_member(osmium::item_type::relation, 43, ""));
+  osmium::builder::add_relation(
+      osmiumBuffer, osmium::builder::attr::_id(43),
+      osmium::builder::attr::_member(osmium::item_type::way, 55, ""));
+  osmium::builder::add_relation(
+      osmiumBuffer, osmium::builder::attr::_id(44),
+      osmium::builder::attr::_member(osmium::item_type::relation, 45, ""));
+  osmium::builder::add_relation(
+      osmiumBuffer, osmium::builder::attr::_id(45),
+      osmium::builder::attr::_member(osmium::item_type::relation, 44, ""),
+      osmium::builder::attr::_member(osmium::item_type::way, 55, ""));
+  osmium::builder::add_relation(
+      osmiumBuffer, osmium::builder::attr::_id(46),
+      osmium::builder::attr::_member(osmium::item_type::relation, 44, ""));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(1),
+      osmium::builder::attr::_location(osmium::Location(7.52, 48.0)));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(2),
+      osmium::builder::attr::_location(osmium::Location(7.61, 48.0)));
+  osmium::builder::add_way(osmiumBuffer, osmium::builder::attr::_id(55),
+                           osmium::builder::attr::_nodes({
+                               {1, {48.0, 7.52}},
+                               {2, {48.1, 7.61}},
+                           }));
+
+  RelationHandler rh = RelationHandler(config);
+  LocationHandler* lh = LocationHandler::create(config, 0, 0);
+  for (const auto& relation : osmiumBuffer.select<osmium::Relation>()) {
+    rh.relation(relation);
+  }
+  for (const auto& node : osmiumBuffer.select<osmium::Node>()) {
+    lh->node(node);
+  }
+  rh.prepare_for_lookup();
+  rh.setLocationHandler(lh);
+  for (const auto& way : osmiumBuffer.select<osmium::Way>()) {
+    rh.way(way);
+  }
+  // The first relation of the second pass builds the nested geometries.
+  rh.relation(osmiumBuffer.get<osmium::Relation>(0));
+
+  std::vector<osm2rdf::osm::Relation> relations;
+  for (const auto& relation : osmiumBuffer.select<osmium::Relation>()) {
+    relations.emplace_back(relation);
+    relations.back().buildGeometry(rh);
+  }
+  ASSERT_EQ(5, relations.size());
+  ASSERT_TRUE(relations[0].hasCompleteGeometry());
+  ASSERT_EQ(1, relations[0].geom().size());
+  ASSERT_TRUE(relations[1].hasCompleteGeometry());
+  // Relations on a cycle or depending on one have no complete geometry.
+  ASSERT_FALSE(relations[2].hasCompleteGeometry());
+  ASSERT_FALSE(relations[3].hasCompleteGeometry());
+  ASSERT_FALSE(relations[4].hasCompleteGeometry());
+
+  delete lh;
+}
+
+// ____________________________________________________________________________
+TEST(OSM_FactHandler, relationHandlerNestedAreaGeometry) {
+  osm2rdf::config::Config config;
+
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer osmiumBuffer{initial_buffer_size,
+                                      osmium::memory::Buffer::auto_grow::yes};
+  // 42 -> multipolygon 43 -> way 55, the subarea 44 of 43 is ignored.
+  osmium::builder::add_relation(
+      osmiumBuffer, osmium::builder::attr::_id(42),
+      osmium::builder::attr::_member(osmium::item_type::relation, 43, ""));
+  osmium::builder::add_relation(
+      osmiumBuffer, osmium::builder::attr::_id(43),
+      osmium::builder::attr::_tag("type", "multipolygon"),
+      osmium::builder::attr::_member(osmium::item_type::way, 55, "outer"),
+      osmium::builder::attr::_member(osmium::item_type::relation, 44,
+                                     "subarea"));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(1),
+      osmium::builder::attr::_location(osmium::Location(7.52, 48.0)));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(2),
+      osmium::builder::attr::_location(osmium::Location(7.61, 48.0)));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(3),
+      osmium::builder::attr::_location(osmium::Location(7.61, 48.1)));
+  osmium::builder::add_way(osmiumBuffer, osmium::builder::attr::_id(55),
+                           osmium::builder::attr::_nodes({
+                               {1, {7.52, 48.0}},
+                               {2, {7.61, 48.0}},
+                               {3, {7.61, 48.1}},
+                               {1, {7.52, 48.0}},
+                           }));
+
+  RelationHandler rh = RelationHandler(config);
+  LocationHandler* lh = LocationHandler::create(config, 0, 0);
+  for (const auto& relation : osmiumBuffer.select<osmium::Relation>()) {
+    rh.relation(relation);
+  }
+  for (const auto& node : osmiumBuffer.select<osmium::Node>()) {
+    lh->node(node);
+  }
+  rh.prepare_for_lookup();
+  rh.setLocationHandler(lh);
+  for (const auto& way : osmiumBuffer.select<osmium::Way>()) {
+    rh.way(way);
+  }
+  rh.relation(osmiumBuffer.get<osmium::Relation>(0));
+
+  osm2rdf::osm::Relation parent{osmiumBuffer.get<osmium::Relation>(0)};
+  parent.buildGeometry(rh);
+  // The multipolygon contributes the line of its outer way.
+  ASSERT_TRUE(parent.hasCompleteGeometry());
+  ASSERT_EQ(1, parent.geom().size());
+  ASSERT_DOUBLE_EQ(7.52, parent.envelope().getLowerLeft().getX());
+  ASSERT_DOUBLE_EQ(48.0, parent.envelope().getLowerLeft().getY());
+  ASSERT_DOUBLE_EQ(7.61, parent.envelope().getUpperRight().getX());
+  ASSERT_DOUBLE_EQ(48.1, parent.envelope().getUpperRight().getY());
+
+  delete lh;
+}
+
 // ____________________________________________________________________________
 TEST(OSM_FactHandler, relationWithGeometry) {
   // Capture std::cout
@@ -1527,6 +1698,56 @@ TEST(OSM_FactHandler, writeTagList) {
   std::cout.rdbuf(sbuf);
 }
 
+// ____________________________________________________________________________
+TEST(OSM_FactHandler, writeTagListKeyWithSpace) {
+  // Capture std::cout
+  std::stringstream buffer;
+  std::streambuf* sbuf = std::cout.rdbuf();
+  std::cout.rdbuf(buffer.rdbuf());
+
+  osm2rdf::config::Config config;
+  config.output = "";
+  config.numThreads = 1;  // set to one to avoid concurrency issues with the
+                          // stringstream read buffer
+  config.outputCompress = osm2rdf::config::NONE;
+  config.addCentroids = false;
+  config.mergeOutput = osm2rdf::util::OutputMergeMode::NONE;
+
+  osm2rdf::util::Output output{config, config.output};
+  output.open();
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::TTL> writer{config, &output};
+  osm2rdf::osm::FactHandler dh{config, &writer};
+
+  const std::string tag1Key = "city name";
+  const std::string tag1Value = "Freiburg";
+  const std::string tag2Key = "name of city";
+  const std::string tag2Value = "Freiburg";
+
+  const std::string subject = "subject";
+  const std::string predicate1 = writer.generateIRI(
+      osm2rdf::ttl::constants::NAMESPACE__OSM_TAG, "city_name");
+  const std::string predicate2 = writer.generateIRI(
+      osm2rdf::ttl::constants::NAMESPACE__OSM_TAG, "name_of_city");
+  const std::string object = writer.generateLiteral("Freiburg", "");
+
+  osm2rdf::osm::TagList tagList;
+  tagList.push_back({tag1Key, tag1Value});
+  tagList.push_back({tag2Key, tag2Value});
+
+  dh.writeTagList(subject, tagList);
+  output.flush();
+  output.close();
+
+  const std::string printedData = buffer.str();
+  ASSERT_THAT(printedData, ::testing::HasSubstr(subject + " " + predicate1 +
+                                                " " + object + " .\n"));
+  ASSERT_THAT(printedData, ::testing::HasSubstr(subject + " " + predicate2 +
+                                                " " + object + " .\n"));
+
+  // Cleanup
+  std::cout.rdbuf(sbuf);
+}
+
 // ____________________________________________________________________________
 TEST(OSM_FactHandler, writeTagListRefSingle) {
   // Capture std::cout
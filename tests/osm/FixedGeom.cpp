@@ -0,0 +1,72 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/FixedGeom.h"
+
+#include "gtest/gtest.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/builder/osm_object_builder.hpp"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+TEST(OSM_FixedGeom, toFixed) {
+  // Create osmium object
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer osmiumBuffer{initial_buffer_size,
+                                      osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_way(osmiumBuffer, osmium::builder::attr::_id(42),
+                           osmium::builder::attr::_nodes({
+                               {1, {7.51, 48.0}},
+                               {2, {-7.61, -48.1}},
+                           }));
+
+  const auto& nodes = osmiumBuffer.get<osmium::Way>(0).nodes();
+  const ::util::geo::I32Point p1 = osm2rdf::osm::toFixed(nodes[0]);
+  ASSERT_EQ(75100000, p1.getX());
+  ASSERT_EQ(480000000, p1.getY());
+  const ::util::geo::I32Point p2 = osm2rdf::osm::toFixed(nodes[1]);
+  ASSERT_EQ(-76100000, p2.getX());
+  ASSERT_EQ(-481000000, p2.getY());
+
+  // Same values as reading the location directly.
+  ASSERT_EQ(nodes[0].lon(), osm2rdf::osm::toDouble(p1).getX());
+  ASSERT_EQ(nodes[0].lat(), osm2rdf::osm::toDouble(p1).getY());
+  ASSERT_EQ(nodes[1].lon(), osm2rdf::osm::toDouble(p2).getX());
+  ASSERT_EQ(nodes[1].lat(), osm2rdf::osm::toDouble(p2).getY());
+}
+
+// ____________________________________________________________________________
+TEST(OSM_FixedGeom, toDoubleMultiPolygon) {
+  ::util::geo::I32MultiPolygon fixed(1);
+  fixed[0].getOuter() = {{0, 0}, {10000000, 0}, {10000000, 10000000}, {0, 0}};
+  fixed[0].getInners().push_back(
+      {{1000000, 1000000}, {2000000, 1000000}, {2000000, 2000000}});
+
+  const ::util::geo::DMultiPolygon result = osm2rdf::osm::toDouble(fixed);
+  ASSERT_EQ(1, result.size());
+  ASSERT_EQ(4, result[0].getOuter().size());
+  ASSERT_DOUBLE_EQ(1.0, result[0].getOuter()[1].getX());
+  ASSERT_DOUBLE_EQ(1.0, result[0].getOuter()[2].getY());
+  ASSERT_EQ(1, result[0].getInners().size());
+  ASSERT_EQ(3, result[0].getInners()[0].size());
+  ASSERT_DOUBLE_EQ(0.2, result[0].getInners()[0][2].getX());
+  ASSERT_DOUBLE_EQ(0.1, result[0].getInners()[0][0].getY());
+}
+
+}  // namespace osm2rdf::osm
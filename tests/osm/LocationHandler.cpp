@@ -0,0 +1,89 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/LocationHandler.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "osm2rdf/config/Config.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/location.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+std::vector<osmium::Location> wayNodeLocations(
+    const std::string& storeLocations, bool parallel) {
+  using namespace osmium::builder::attr;
+  osmium::memory::Buffer buffer{10000,
+                                osmium::memory::Buffer::auto_grow::yes};
+  // Unsorted node ids, as in OSM XML files.
+  osmium::builder::add_node(buffer, _id(4), _location(7.4, 48.4));
+  osmium::builder::add_node(buffer, _id(2), _location(7.2, 48.2));
+  osmium::builder::add_node(buffer, _id(5), _location(7.5, 48.5));
+  osmium::builder::add_node(buffer, _id(1), _location(7.1, 48.1));
+  osmium::builder::add_node(buffer, _id(3), _location(7.3, 48.3));
+  // Node 6 does not exist.
+  osmium::builder::add_way(buffer, _id(10), _nodes({1, 2, 3}));
+  osmium::builder::add_way(buffer, _id(11), _nodes({5, 4, 6}));
+
+  osm2rdf::config::Config config;
+  config.storeLocations = storeLocations;
+  std::unique_ptr<LocationHandler> handler{
+      LocationHandler::create(config, 1, 5)};
+  if (parallel) {
+#pragma omp parallel
+    {
+#pragma omp single
+      handler->setLocations(buffer);
+    }
+  } else {
+    osmium::apply(buffer, *handler);
+  }
+  handler->finalize();
+
+  std::vector<osmium::Location> locations;
+  for (const auto& way : buffer.select<osmium::Way>()) {
+    for (const auto& nodeRef : way.nodes()) {
+      locations.push_back(nodeRef.location());
+    }
+  }
+  return locations;
+}
+
+// ____________________________________________________________________________
+TEST(OSM_LocationHandler, setLocationsUnsortedNodes) {
+  const std::vector<osmium::Location> expected{
+      osmium::Location{7.1, 48.1}, osmium::Location{7.2, 48.2},
+      osmium::Location{7.3, 48.3}, osmium::Location{7.5, 48.5},
+      osmium::Location{7.4, 48.4}, osmium::Location{}};
+  for (const std::string storeLocations :
+       {"mem-flex", "mem-dense", "mem-dense-paged", "mem-compressed",
+        "disk-sparse", "disk-dense"}) {
+    SCOPED_TRACE(storeLocations);
+    ASSERT_EQ(expected, wayNodeLocations(storeLocations, false));
+    ASSERT_EQ(expected, wayNodeLocations(storeLocations, true));
+  }
+}
+
+}  // namespace osm2rdf::osm
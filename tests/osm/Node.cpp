@@ -63,8 +63,8 @@ TEST(OSM_Node, FromNodeWithTags) {
   ASSERT_DOUBLE_EQ(48.0, n.geom().getY());
 
   ASSERT_EQ(1, n.tags().size());
-  ASSERT_STREQ("city", n.tags()[0].first.c_str());
-  ASSERT_STREQ("Freiburg", n.tags()[0].second.c_str());
+  ASSERT_EQ("city", n.tags()[0].first);
+  ASSERT_EQ("Freiburg", n.tags()[0].second);
 }
 
 // ____________________________________________________________________________
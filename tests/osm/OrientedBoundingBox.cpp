@@ -0,0 +1,78 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/OrientedBoundingBox.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "util/geo/Geo.h"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+TEST(OSM_OrientedBoundingBox, axisAligned) {
+  const ::util::geo::DLine line{
+      {48.0, 7.5}, {48.05, 7.55}, {48.0, 7.6}, {48.1, 7.6}, {48.1, 7.5}};
+  const auto hull = ::util::geo::convexHull(line);
+
+  const auto obb = osm2rdf::osm::orientedBoundingBox(hull);
+  // Exact corners of the envelope, in the same order as a convex hull.
+  ASSERT_EQ(::util::geo::convexHull(::util::geo::DLine{
+                {48.0, 7.5}, {48.1, 7.5}, {48.1, 7.6}, {48.0, 7.6}}),
+            obb);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_OrientedBoundingBox, rotatedRectangle) {
+  // Rectangle of size 4x1 rotated by 30 degrees with an additional vertex on
+  // one of its sides.
+  const double c = std::cos(M_PI / 6);
+  const double s = std::sin(M_PI / 6);
+  const ::util::geo::DLine line{
+      {0, 0}, {4 * c, 4 * s}, {4 * c - s, 4 * s + c}, {-s, c}, {2 * c, 2 * s}};
+  const auto hull = ::util::geo::convexHull(line);
+
+  const auto obb = osm2rdf::osm::orientedBoundingBox(hull);
+  ASSERT_NEAR(4, ::util::geo::area(obb), 1e-9);
+  // The additional vertex does not change the hull.
+  ASSERT_NEAR(::util::geo::area(hull), ::util::geo::area(obb), 1e-9);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_OrientedBoundingBox, smallerThanEnvelope) {
+  // Diamond, the envelope has twice its area.
+  const ::util::geo::DLine line{{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+  const auto hull = ::util::geo::convexHull(line);
+
+  const auto obb = osm2rdf::osm::orientedBoundingBox(hull);
+  ASSERT_NEAR(2, ::util::geo::area(obb), 1e-9);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_OrientedBoundingBox, degenerate) {
+  const ::util::geo::DLine line{{48.0, 7.5}, {48.1, 7.6}};
+  const auto hull = ::util::geo::convexHull(line);
+
+  ASSERT_TRUE(osm2rdf::osm::orientedBoundingBox(hull).getOuter().empty());
+  ASSERT_TRUE(
+      osm2rdf::osm::orientedBoundingBox(::util::geo::DPolygon{}).getOuter()
+          .empty());
+}
+
+}  // namespace osm2rdf::osm
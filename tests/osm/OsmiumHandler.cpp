@@ -113,6 +113,8 @@ void addOsmiumItems(osm2rdf::osm::OsmiumHandler<W>* oh) {
                            }),
                            osmium::builder::attr::_tag("city", "Freiburg"));
   oh->way(osmiumBuffer.get<osmium::Way>(0));
+  // Process collected batches
+  oh->flush();
 }
 
 // ____________________________________________________________________________
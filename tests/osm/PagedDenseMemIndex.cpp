@@ -0,0 +1,71 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PagedDenseMemIndex.h"
+
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "osmium/osm/location.hpp"
+#include "osmium/osm/types.hpp"
+
+namespace osm2rdf::osm {
+
+using Index = osm2rdf::osm::PagedDenseMemIndex<osmium::unsigned_object_id_type,
+                                               osmium::Location>;
+
+// ____________________________________________________________________________
+TEST(OSM_PagedDenseMemIndex, setAndGet) {
+  Index index{10, 20};
+  ASSERT_EQ(11, index.size());
+  index.set(10, osmium::Location{7.51, 48.0});
+  index.set(20, osmium::Location{0.0, 0.0});
+  ASSERT_EQ(osmium::Location(7.51, 48.0), index.get(10));
+  ASSERT_EQ(osmium::Location(0.0, 0.0), index.get(20));
+  // Unset and out of range ids are invalid.
+  ASSERT_FALSE(index.get_noexcept(11).valid());
+  ASSERT_FALSE(index.get_noexcept(9).valid());
+  ASSERT_FALSE(index.get_noexcept(21).valid());
+  ASSERT_THROW(index.get(11), osmium::not_found);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PagedDenseMemIndex, sparseIds) {
+  const size_t maxId = 1000 * Index::kPageSize;
+  Index index{1, maxId};
+  index.set(1, osmium::Location{1.0, 1.0});
+  index.set(maxId / 2, osmium::Location{2.0, 2.0});
+  index.set(maxId, osmium::Location{3.0, 3.0});
+  ASSERT_EQ(osmium::Location(1.0, 1.0), index.get(1));
+  ASSERT_EQ(osmium::Location(2.0, 2.0), index.get(maxId / 2));
+  ASSERT_EQ(osmium::Location(3.0, 3.0), index.get(maxId));
+  ASSERT_FALSE(index.get_noexcept(maxId / 4).valid());
+  // Only the written pages are allocated.
+  ASSERT_LT(index.used_memory(),
+            4 * Index::kPageSize * sizeof(osmium::Location));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PagedDenseMemIndex, noNodes) {
+  // Range of a CountHandler without nodes.
+  Index index{std::numeric_limits<size_t>::max(), 0};
+  ASSERT_EQ(0, index.size());
+  ASSERT_FALSE(index.get_noexcept(15).valid());
+}
+
+}  // namespace osm2rdf::osm
@@ -0,0 +1,139 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PbfBlobIndex.h"
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/handler.hpp"
+#include "osmium/io/pbf_output.hpp"
+#include "osmium/io/writer.hpp"
+#include "osmium/memory/buffer.hpp"
+
+namespace osm2rdf::osm {
+
+// Counts all handled objects.
+class TestCountHandler : public osmium::handler::Handler {
+ public:
+  void node(const osmium::Node&) { ++nodes; }
+  void way(const osmium::Way&) { ++ways; }
+  void relation(const osmium::Relation&) { ++relations; }
+  size_t nodes = 0;
+  size_t ways = 0;
+  size_t relations = 0;
+};
+
+// ____________________________________________________________________________
+void writeTestFile(const std::filesystem::path& path) {
+  using namespace osmium::builder::attr;
+  osmium::memory::Buffer buffer{1024,
+                                osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_node(buffer, _id(1), _location(7.51, 48.0),
+                            _tag("name", "Freiburg"));
+  osmium::builder::add_node(buffer, _id(2), _location(7.52, 48.1));
+  osmium::builder::add_way(buffer, _id(10), _nodes({1, 2}));
+  osmium::builder::add_relation(buffer, _id(20),
+                                _member(osmium::item_type::way, 10, "outer"));
+  std::filesystem::remove(path);
+  osmium::io::Writer writer{path.string()};
+  writer(std::move(buffer));
+  writer.close();
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PbfBlobIndex, applyAllBlobs) {
+  const std::filesystem::path path{"/tmp/osm2rdf-pbfblobindex.osm.pbf"};
+  writeTestFile(path);
+
+  osm2rdf::osm::PbfBlobIndex index{path};
+  ASSERT_LE(1, index.numBlobs());
+
+  TestCountHandler counts;
+  uint64_t minId = std::numeric_limits<uint64_t>::max();
+  uint64_t maxId = 0;
+  for (size_t i = 0; i < index.numBlobs(); ++i) {
+    ASSERT_EQ(osmium::osm_entity_bits::nothing, index.blob(i).entities);
+    index.apply(i, osmium::osm_entity_bits::object, counts);
+    ASSERT_NE(osmium::osm_entity_bits::nothing, index.blob(i).entities);
+    minId = std::min(minId, index.blob(i).minId);
+    maxId = std::max(maxId, index.blob(i).maxId);
+  }
+  ASSERT_EQ(2, counts.nodes);
+  ASSERT_EQ(1, counts.ways);
+  ASSERT_EQ(1, counts.relations);
+  ASSERT_EQ(1, minId);
+  ASSERT_EQ(20, maxId);
+
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PbfBlobIndex, applySelectedTypes) {
+  const std::filesystem::path path{"/tmp/osm2rdf-pbfblobindex.osm.pbf"};
+  writeTestFile(path);
+
+  osm2rdf::osm::PbfBlobIndex index{path};
+  TestCountHandler counts;
+  for (size_t i = 0; i < index.numBlobs(); ++i) {
+    index.apply(i, osmium::osm_entity_bits::relation, counts);
+  }
+  ASSERT_EQ(0, counts.nodes);
+  ASSERT_EQ(0, counts.ways);
+  ASSERT_EQ(1, counts.relations);
+
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PbfBlobIndex, scanNodes) {
+  const std::filesystem::path path{"/tmp/osm2rdf-pbfblobindex.osm.pbf"};
+  writeTestFile(path);
+
+  osm2rdf::osm::PbfBlobIndex index{path};
+  uint64_t numNodes = 0;
+  uint64_t numTaggedNodes = 0;
+  uint64_t minId = std::numeric_limits<uint64_t>::max();
+  uint64_t maxId = 0;
+  auto entities = osmium::osm_entity_bits::nothing;
+  for (size_t i = 0; i < index.numBlobs(); ++i) {
+    osm2rdf::osm::PbfNodeSummary nodes;
+    ASSERT_TRUE(index.scan(i, &nodes));
+    numNodes += nodes.numNodes;
+    numTaggedNodes += nodes.numTaggedNodes;
+    minId = std::min(minId, nodes.minId);
+    maxId = std::max(maxId, nodes.maxId);
+    entities |= index.blob(i).entities;
+  }
+  ASSERT_EQ(2, numNodes);
+  ASSERT_EQ(1, numTaggedNodes);
+  ASSERT_EQ(1, minId);
+  ASSERT_EQ(2, maxId);
+  ASSERT_EQ(osmium::osm_entity_bits::nwr, entities);
+
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PbfBlobIndex, missingFile) {
+  ASSERT_THROW(osm2rdf::osm::PbfBlobIndex{"/tmp/osm2rdf-missing.osm.pbf"},
+               std::filesystem::filesystem_error);
+}
+
+}  // namespace osm2rdf::osm
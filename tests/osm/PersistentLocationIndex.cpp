@@ -0,0 +1,145 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PersistentLocationIndex.h"
+
+#include <filesystem>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentLocationIndex, setAndGet) {
+  const std::filesystem::path path{"/tmp/osm2rdf-persistent-setAndGet"};
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 10, 20};
+    ASSERT_FALSE(index.reused());
+    ASSERT_EQ(11, index.size());
+    index.set(10, osmium::Location{7.51, 48.0});
+    index.set(12, osmium::Location{0.0, 0.0});
+    ASSERT_EQ(osmium::Location(7.51, 48.0), index.get(10));
+    ASSERT_EQ(osmium::Location(0.0, 0.0), index.get(12));
+    // Unset and out of range ids are invalid.
+    ASSERT_FALSE(index.get_noexcept(11).valid());
+    ASSERT_FALSE(index.get_noexcept(9).valid());
+    ASSERT_FALSE(index.get_noexcept(21).valid());
+    ASSERT_THROW(index.get(11), osmium::not_found);
+  }
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentLocationIndex, reuseComplete) {
+  const std::filesystem::path path{"/tmp/osm2rdf-persistent-reuseComplete"};
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 10, 20};
+    index.set(15, osmium::Location{7.51, 48.0});
+    index.markComplete();
+  }
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 10, 20};
+    ASSERT_TRUE(index.reused());
+    ASSERT_EQ(osmium::Location(7.51, 48.0), index.get(15));
+  }
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentLocationIndex, noReuse) {
+  const std::filesystem::path path{"/tmp/osm2rdf-persistent-noReuse"};
+  {
+    // Incomplete index
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 10, 20};
+    index.set(15, osmium::Location{7.51, 48.0});
+  }
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 10, 20};
+    ASSERT_FALSE(index.reused());
+    ASSERT_FALSE(index.get_noexcept(15).valid());
+    index.markComplete();
+  }
+  {
+    // Different input
+    osm2rdf::osm::PersistentLocationIndex index{path, 43, 10, 20};
+    ASSERT_FALSE(index.reused());
+    index.markComplete();
+  }
+  {
+    // Different id range
+    osm2rdf::osm::PersistentLocationIndex index{path, 43, 10, 30};
+    ASSERT_FALSE(index.reused());
+  }
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentLocationIndex, noNodes) {
+  const std::filesystem::path path{"/tmp/osm2rdf-persistent-noNodes"};
+  {
+    // Range of a CountHandler without nodes.
+    osm2rdf::osm::PersistentLocationIndex index{
+        path, 42, std::numeric_limits<size_t>::max(), 0};
+    ASSERT_EQ(0, index.size());
+    index.set(15, osmium::Location{7.51, 48.0});
+    ASSERT_FALSE(index.get_noexcept(15).valid());
+  }
+  std::filesystem::remove(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentLocationIndex, advance) {
+  const std::filesystem::path path{"/tmp/osm2rdf-persistent-advance"};
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 0, 20};
+    index.set(15, osmium::Location{7.51, 48.0});
+  }
+  // Incomplete indexes can not be advanced.
+  ASSERT_THROW(osm2rdf::osm::PersistentLocationIndex{path},
+               std::filesystem::filesystem_error);
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 0, 20};
+    index.set(15, osmium::Location{7.51, 48.0});
+    index.markComplete();
+  }
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path};
+    ASSERT_EQ(42, index.fingerprint());
+    ASSERT_EQ(osmium::Location(7.51, 48.0), index.get(15));
+    index.reserve(1000);
+    ASSERT_LE(1001, index.size());
+    index.set(1000, osmium::Location{7.8, 48.1});
+    index.set(15, osmium::Location{});
+    index.setFingerprint(43);
+  }
+  {
+    osm2rdf::osm::PersistentLocationIndex index{path};
+    ASSERT_EQ(43, index.fingerprint());
+    ASSERT_EQ(osmium::Location(7.8, 48.1), index.get(1000));
+    ASSERT_FALSE(index.get_noexcept(15).valid());
+  }
+  {
+    // The old input does not reuse the advanced index.
+    osm2rdf::osm::PersistentLocationIndex index{path, 42, 0, 20};
+    ASSERT_FALSE(index.reused());
+  }
+  std::filesystem::remove(path);
+}
+
+}  // namespace osm2rdf::osm
@@ -0,0 +1,101 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/PersistentStore.h"
+
+#include <filesystem>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+void removeStore(const std::filesystem::path& path) {
+  std::filesystem::remove(path.string() + ".index");
+  std::filesystem::remove(path.string() + ".data");
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentStore, putAndGet) {
+  const std::filesystem::path path{"/tmp/osm2rdf-store-putAndGet"};
+  {
+    osm2rdf::osm::PersistentStore store{path, true};
+    std::string value;
+    ASSERT_FALSE(store.get(5, &value));
+    store.put(5, "first");
+    ASSERT_TRUE(store.get(5, &value));
+    ASSERT_EQ("first", value);
+    store.put(5, "second");
+    store.put(1 << 20, "large id");
+    ASSERT_TRUE(store.get(5, &value));
+    ASSERT_EQ("second", value);
+    store.erase(5);
+    ASSERT_FALSE(store.get(5, &value));
+    ASSERT_FALSE(store.get(6, &value));
+  }
+  removeStore(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentStore, append) {
+  const std::filesystem::path path{"/tmp/osm2rdf-store-append"};
+  {
+    osm2rdf::osm::PersistentStore store{path, true};
+    store.append(7, "ab");
+    store.append(7, "cd");
+    std::string value;
+    ASSERT_TRUE(store.get(7, &value));
+    ASSERT_EQ("cdab", value);
+    store.put(7, "ef");
+    ASSERT_TRUE(store.get(7, &value));
+    ASSERT_EQ("ef", value);
+  }
+  removeStore(path);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_PersistentStore, reopen) {
+  const std::filesystem::path path{"/tmp/osm2rdf-store-reopen"};
+  {
+    osm2rdf::osm::PersistentStore store{path, true};
+    store.put(5, "kept");
+    store.append(1 << 20, "ab");
+    store.sync();
+  }
+  {
+    osm2rdf::osm::PersistentStore store{path, false};
+    std::string value;
+    ASSERT_TRUE(store.get(5, &value));
+    ASSERT_EQ("kept", value);
+    store.append(1 << 20, "cd");
+    ASSERT_TRUE(store.get(1 << 20, &value));
+    ASSERT_EQ("cdab", value);
+  }
+  {
+    // Creating a store discards the old one.
+    osm2rdf::osm::PersistentStore store{path, true};
+    std::string value;
+    ASSERT_FALSE(store.get(5, &value));
+  }
+  removeStore(path);
+  ASSERT_THROW(osm2rdf::osm::PersistentStore(path, false),
+               std::filesystem::filesystem_error);
+}
+
+}  // namespace osm2rdf::osm
@@ -56,8 +56,8 @@ TEST(OSM_Relation, FromRelationWithTags) {
   ASSERT_EQ(42, r.id());
 
   ASSERT_EQ(1, r.tags().size());
-  ASSERT_STREQ("city", r.tags()[0].first.c_str());
-  ASSERT_STREQ("Freiburg", r.tags()[0].second.c_str());
+  ASSERT_EQ("city", r.tags()[0].first);
+  ASSERT_EQ("Freiburg", r.tags()[0].second);
 
   ASSERT_EQ(0, r.members().size());
 }
@@ -105,8 +105,8 @@ TEST(OSM_Relation, FromRelationWithMembersAndTags) {
   ASSERT_EQ(42, r.id());
 
   ASSERT_EQ(1, r.tags().size());
-  ASSERT_STREQ("city", r.tags()[0].first.c_str());
-  ASSERT_STREQ("Freiburg", r.tags()[0].second.c_str());
+  ASSERT_EQ("city", r.tags()[0].first);
+  ASSERT_EQ("Freiburg", r.tags()[0].second);
 
   ASSERT_EQ(2, r.members().size());
   ASSERT_EQ(osm2rdf::osm::RelationMemberType::NODE, r.members().at(0).type());
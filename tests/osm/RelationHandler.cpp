@@ -0,0 +1,196 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/RelationHandler.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/builder/osm_object_builder.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+// Exposes the arena of encoded way node refs.
+class TestRelationHandler : public RelationHandler<LocationHandler> {
+ public:
+  using RelationHandler<LocationHandler>::RelationHandler;
+  [[nodiscard]] size_t numChunks() const { return _chunks.size(); }
+  [[nodiscard]] const std::vector<uint64_t>& nestedOrder() const {
+    return _nestedOrder;
+  }
+  [[nodiscard]] const std::vector<size_t>& nestedLevelsBegin() const {
+    return _nestedLevelsBegin;
+  }
+};
+
+// ____________________________________________________________________________
+// Adds a way with the given node ids to buffer.
+void addWay(osmium::memory::Buffer* buffer, uint64_t id,
+            const std::vector<uint64_t>& nodeIds) {
+  {
+    osmium::builder::WayBuilder builder{*buffer};
+    builder.set_id(static_cast<osmium::object_id_type>(id));
+    osmium::builder::WayNodeListBuilder nodes{builder};
+    for (const auto& nodeId : nodeIds) {
+      nodes.add_node_ref(static_cast<osmium::object_id_type>(nodeId));
+    }
+  }
+  buffer->commit();
+}
+
+// ____________________________________________________________________________
+// Runs both passes over a relation with all wayIds as members and ways.
+void storeWays(TestRelationHandler* relationHandler,
+               const std::vector<uint64_t>& wayIds,
+               osmium::memory::Buffer* ways) {
+  osmium::memory::Buffer relations{10000,
+                                   osmium::memory::Buffer::auto_grow::yes};
+  {
+    osmium::builder::RelationBuilder builder{relations};
+    builder.set_id(1);
+    osmium::builder::RelationMemberListBuilder members{builder};
+    for (const auto& wayId : wayIds) {
+      members.add_member(osmium::item_type::way,
+                         static_cast<osmium::object_id_type>(wayId), "");
+    }
+  }
+  relations.commit();
+  osmium::apply(relations, *relationHandler);
+  relationHandler->prepare_for_lookup();
+  osmium::apply(*ways, *relationHandler);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_RelationHandler, decreasingAndDuplicateNodeIds) {
+  osm2rdf::config::Config config;
+  TestRelationHandler relationHandler{config};
+  osmium::memory::Buffer ways{10000, osmium::memory::Buffer::auto_grow::yes};
+  const std::vector<uint64_t> nodeIds{5, 3, 3, 1, 100, 2, 2};
+  addWay(&ways, 10, nodeIds);
+  storeWays(&relationHandler, {10}, &ways);
+
+  ASSERT_EQ(nodeIds, relationHandler.get_noderefs_of_way(10));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_RelationHandler, largeIdGaps) {
+  osm2rdf::config::Config config;
+  TestRelationHandler relationHandler{config};
+  osmium::memory::Buffer ways{10000, osmium::memory::Buffer::auto_grow::yes};
+  // Deltas need one to ten bytes in both directions.
+  const std::vector<uint64_t> nodeIds{
+      1, 200, 1ULL << 20, 7, 1ULL << 35, (1ULL << 62) + 5, 3, 1ULL << 62};
+  addWay(&ways, 10, nodeIds);
+  addWay(&ways, 11, {1ULL << 62});
+  storeWays(&relationHandler, {10, 11}, &ways);
+
+  ASSERT_EQ(nodeIds, relationHandler.get_noderefs_of_way(10));
+  ASSERT_EQ(std::vector<uint64_t>{1ULL << 62},
+            relationHandler.get_noderefs_of_way(11));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_RelationHandler, missingWays) {
+  osm2rdf::config::Config config;
+  TestRelationHandler relationHandler{config};
+  osmium::memory::Buffer ways{10000, osmium::memory::Buffer::auto_grow::yes};
+  addWay(&ways, 10, {1, 2});
+  // Not a relation member.
+  addWay(&ways, 11, {3, 4});
+  // Way 12 is a member, but not part of the input.
+  storeWays(&relationHandler, {10, 12}, &ways);
+
+  ASSERT_EQ(std::vector<uint64_t>({1, 2}),
+            relationHandler.get_noderefs_of_way(10));
+  ASSERT_TRUE(relationHandler.get_noderefs_of_way(11).empty());
+  ASSERT_TRUE(relationHandler.get_noderefs_of_way(12).empty());
+  ASSERT_TRUE(relationHandler.get_noderefs_of_way(99).empty());
+}
+
+// ____________________________________________________________________________
+TEST(OSM_RelationHandler, nodeListsStartNewChunks) {
+  osm2rdf::config::Config config;
+  TestRelationHandler relationHandler{config};
+  osmium::memory::Buffer ways{10000, osmium::memory::Buffer::auto_grow::yes};
+  // Alternating ids need at least nine bytes per node, four of these ways do
+  // not fit into one 16 MiB chunk.
+  const size_t numNodes = 500000;
+  std::vector<std::vector<uint64_t>> nodeIds(4);
+  for (size_t i = 0; i < nodeIds.size(); ++i) {
+    for (size_t j = 0; j < numNodes; ++j) {
+      nodeIds[i].push_back(j % 2 == 0 ? i + j : (1ULL << 62) + j);
+    }
+    addWay(&ways, 10 + i, nodeIds[i]);
+  }
+  // Larger than a whole chunk.
+  std::vector<uint64_t> largeNodeIds;
+  for (size_t j = 0; j < 4 * numNodes; ++j) {
+    largeNodeIds.push_back(j % 2 == 0 ? j : (1ULL << 62) + j);
+  }
+  addWay(&ways, 20, largeNodeIds);
+  storeWays(&relationHandler, {10, 11, 12, 13, 20}, &ways);
+
+  ASSERT_LE(3, relationHandler.numChunks());
+  for (size_t i = 0; i < nodeIds.size(); ++i) {
+    ASSERT_EQ(nodeIds[i], relationHandler.get_noderefs_of_way(10 + i));
+  }
+  ASSERT_EQ(largeNodeIds, relationHandler.get_noderefs_of_way(20));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_RelationHandler, nestedLevels) {
+  osm2rdf::config::Config config;
+  TestRelationHandler relationHandler{config};
+  osmium::memory::Buffer relations{10000,
+                                   osmium::memory::Buffer::auto_grow::yes};
+  // 1 -> 2 -> 3 -> way 10, 1 -> 3, 4 -> 5, 6 -> 3
+  osmium::builder::add_relation(
+      relations, osmium::builder::attr::_id(1),
+      osmium::builder::attr::_member(osmium::item_type::relation, 2, ""),
+      osmium::builder::attr::_member(osmium::item_type::relation, 3, ""));
+  osmium::builder::add_relation(
+      relations, osmium::builder::attr::_id(2),
+      osmium::builder::attr::_member(osmium::item_type::relation, 3, ""));
+  osmium::builder::add_relation(
+      relations, osmium::builder::attr::_id(3),
+      osmium::builder::attr::_member(osmium::item_type::way, 10, ""));
+  osmium::builder::add_relation(
+      relations, osmium::builder::attr::_id(4),
+      osmium::builder::attr::_member(osmium::item_type::relation, 5, ""));
+  osmium::builder::add_relation(
+      relations, osmium::builder::attr::_id(5),
+      osmium::builder::attr::_member(osmium::item_type::way, 10, ""));
+  osmium::builder::add_relation(
+      relations, osmium::builder::attr::_id(6),
+      osmium::builder::attr::_member(osmium::item_type::relation, 3, ""));
+  osmium::apply(relations, relationHandler);
+  relationHandler.prepare_for_lookup();
+
+  // Only members of other relations are kept, 3 and 5 have no relation
+  // members.
+  ASSERT_EQ(3, relationHandler.nestedOrder().size());
+  ASSERT_EQ((std::vector<size_t>{0, 2, 3}),
+            relationHandler.nestedLevelsBegin());
+  ASSERT_EQ(2, relationHandler.nestedOrder()[2]);
+}
+
+}  // namespace osm2rdf::osm
@@ -0,0 +1,59 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/RequiredLocationIndex.h"
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+TEST(OSM_RequiredLocationIndex, onlyRequiredNodes) {
+  osm2rdf::util::RankBitVector required;
+  required.set(12);
+  required.set(10);
+  required.set(1000);
+  osm2rdf::osm::RequiredLocationIndex index;
+  index.setRequiredNodes(std::move(required));
+  ASSERT_EQ(3, index.size());
+  index.set(10, osmium::Location{7.51, 48.0});
+  index.set(11, osmium::Location{1.0, 1.0});
+  index.set(12, osmium::Location{-1.0, -1.0});
+  index.set(1000, osmium::Location{0.0, 0.0});
+  ASSERT_EQ(osmium::Location(7.51, 48.0), index.get(10));
+  ASSERT_EQ(osmium::Location(-1.0, -1.0), index.get(12));
+  ASSERT_EQ(osmium::Location(0.0, 0.0), index.get(1000));
+  // Nodes not required are never stored.
+  ASSERT_FALSE(index.get_noexcept(11).valid());
+  ASSERT_FALSE(index.get_noexcept(2000).valid());
+  ASSERT_THROW(index.get(11), osmium::not_found);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_RequiredLocationIndex, requiredButUnset) {
+  osm2rdf::util::RankBitVector required;
+  required.set(5);
+  osm2rdf::osm::RequiredLocationIndex index;
+  index.setRequiredNodes(std::move(required));
+  ASSERT_FALSE(index.get_noexcept(5).valid());
+  ASSERT_THROW(index.get(5), osmium::not_found);
+  index.clear();
+  ASSERT_EQ(0, index.size());
+}
+
+}  // namespace osm2rdf::osm
@@ -0,0 +1,132 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/ShardMemberHandler.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "osm2rdf/osm/CountHandler.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+// Ids from 1 << 16 to (2 << 16) - 1 are in shard 1 of 2.
+static const uint64_t IN_SHARD = 1 << 16;
+
+// ____________________________________________________________________________
+osm2rdf::config::Config shardConfig() {
+  osm2rdf::config::Config config;
+  config.shards = 2;
+  config.shardWorker = true;
+  config.shard = 1;
+  config.storeLocations = "mem-required";
+  return config;
+}
+
+// ____________________________________________________________________________
+// Relation IN_SHARD -> 2 -> 4 are converted by the worker, 7 -> 9 are not.
+void addShardRelations(osmium::memory::Buffer* buffer) {
+  using namespace osmium::builder::attr;
+  osmium::builder::add_relation(*buffer, _id(IN_SHARD),
+                                _member(osmium::item_type::way, 1, ""),
+                                _member(osmium::item_type::relation, 2, ""),
+                                _member(osmium::item_type::node, 5, ""));
+  osmium::builder::add_relation(*buffer, _id(2),
+                                _member(osmium::item_type::way, 3, ""),
+                                _member(osmium::item_type::relation, 4, ""),
+                                _member(osmium::item_type::node, 15, ""));
+  osmium::builder::add_relation(*buffer, _id(4),
+                                _member(osmium::item_type::way, 6, ""));
+  osmium::builder::add_relation(*buffer, _id(7),
+                                _member(osmium::item_type::way, 8, ""),
+                                _member(osmium::item_type::relation, 9, ""),
+                                _member(osmium::item_type::node, 14, ""));
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ShardMemberHandler, nestedRelationsNeedSecondPass) {
+  osmium::memory::Buffer buffer{10000, osmium::memory::Buffer::auto_grow::yes};
+  addShardRelations(&buffer);
+
+  ShardMemberHandler handler{shardConfig()};
+  osmium::apply(buffer, handler);
+  handler.prepare_for_lookup();
+  ASSERT_FALSE(handler.done());
+  ASSERT_EQ((std::vector<uint64_t>{2, 4}), handler.relationIds());
+
+  osmium::apply(buffer, handler);
+  handler.prepare_for_lookup();
+  ASSERT_TRUE(handler.done());
+  ASSERT_EQ((std::vector<uint64_t>{1, 3, 6}), handler.wayIds());
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ShardMemberHandler, withoutNestedRelations) {
+  using namespace osmium::builder::attr;
+  osmium::memory::Buffer buffer{10000, osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_relation(buffer, _id(IN_SHARD),
+                                _member(osmium::item_type::way, 3, ""),
+                                _member(osmium::item_type::way, 1, ""),
+                                _member(osmium::item_type::way, 3, ""));
+  osmium::builder::add_relation(buffer, _id(2),
+                                _member(osmium::item_type::way, 8, ""));
+
+  ShardMemberHandler handler{shardConfig()};
+  osmium::apply(buffer, handler);
+  handler.prepare_for_lookup();
+  ASSERT_TRUE(handler.done());
+  ASSERT_TRUE(handler.relationIds().empty());
+  ASSERT_EQ((std::vector<uint64_t>{1, 3}), handler.wayIds());
+}
+
+// ____________________________________________________________________________
+TEST(OSM_ShardMemberHandler, countHandlerRequiresShardMembers) {
+  using namespace osmium::builder::attr;
+  osmium::memory::Buffer relations{10000,
+                                   osmium::memory::Buffer::auto_grow::yes};
+  addShardRelations(&relations);
+  ShardMemberHandler handler{shardConfig()};
+  while (!handler.done()) {
+    osmium::apply(relations, handler);
+    handler.prepare_for_lookup();
+  }
+
+  osmium::memory::Buffer ways{10000, osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_way(ways, _id(1), _nodes({10, 11}));
+  osmium::builder::add_way(ways, _id(8), _nodes({12}));
+  osmium::builder::add_way(ways, _id(IN_SHARD + 1), _nodes({13}));
+  CountHandler countHandler{shardConfig()};
+  countHandler.restrictToShard(std::move(handler.relationIds()),
+                               std::move(handler.wayIds()));
+  osmium::apply(ways, countHandler);
+  osmium::apply(relations, countHandler);
+
+  const auto& required = countHandler.requiredNodes();
+  for (const uint64_t id : {5, 10, 11, 13, 15}) {
+    ASSERT_TRUE(required.get(id)) << id;
+  }
+  // Only members of relation 7 and way 8, both outside the shard.
+  ASSERT_FALSE(required.get(12));
+  ASSERT_FALSE(required.get(14));
+}
+
+}  // namespace osm2rdf::osm
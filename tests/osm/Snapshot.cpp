@@ -0,0 +1,254 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/Snapshot.h"
+
+#include <filesystem>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "osm2rdf/osm/AreaManager.h"
+#include "osm2rdf/osm/CountHandler.h"
+#include "osm2rdf/osm/RelationHandler.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/handler/node_locations_for_ways.hpp"
+#include "osmium/index/map/sparse_mem_array.hpp"
+#include "osmium/io/pbf_input.hpp"
+#include "osmium/io/pbf_output.hpp"
+#include "osmium/io/reader.hpp"
+#include "osmium/io/writer.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/area.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+using TestRelationHandler = RelationHandler<LocationHandler>;
+using TestLocationIndex =
+    osmium::index::map::SparseMemArray<osmium::unsigned_object_id_type,
+                                       osmium::Location>;
+
+// ____________________________________________________________________________
+void writeSnapshotInput(const std::filesystem::path& path, bool extraNode) {
+  using namespace osmium::builder::attr;
+  osmium::memory::Buffer buffer{10000,
+                                osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_node(buffer, _id(1), _location(7.5, 47.5),
+                            _tag("name", "Freiburg"));
+  osmium::builder::add_node(buffer, _id(2), _location(7.6, 47.5));
+  osmium::builder::add_node(buffer, _id(3), _location(7.6, 47.6));
+  osmium::builder::add_node(buffer, _id(4), _location(7.5, 47.6));
+  osmium::builder::add_node(buffer, _id(5), _location(7.4, 47.7));
+  if (extraNode) {
+    osmium::builder::add_node(buffer, _id(6), _location(7.3, 47.8));
+  }
+  osmium::builder::add_way(buffer, _id(10), _nodes({1, 2, 3, 4, 1}));
+  osmium::builder::add_way(buffer, _id(11), _nodes({4, 5}),
+                           _tag("highway", "residential"));
+  osmium::builder::add_relation(buffer, _id(20), _tag("type", "multipolygon"),
+                                _tag("landuse", "forest"),
+                                _member(osmium::item_type::way, 10, "outer"));
+  osmium::builder::add_relation(buffer, _id(21), _tag("type", "route"),
+                                _member(osmium::item_type::way, 11, ""),
+                                _member(osmium::item_type::node, 5, "stop"));
+  osmium::builder::add_relation(buffer, _id(22), _tag("type", "route_master"),
+                                _member(osmium::item_type::relation, 21, ""));
+  std::filesystem::remove(path);
+  osmium::io::Writer writer{path.string()};
+  writer(std::move(buffer));
+  writer.close();
+}
+
+// ____________________________________________________________________________
+osm2rdf::config::Config snapshotConfig() {
+  osm2rdf::config::Config config;
+  config.cache = std::filesystem::temp_directory_path() / "OSM_Snapshot";
+  std::filesystem::remove_all(config.cache);
+  std::filesystem::create_directories(config.cache);
+  config.input = config.cache / "input.osm.pbf";
+  config.snapshot = true;
+  config.storeLocations = "mem-required";
+  writeSnapshotInput(config.input, false);
+  return config;
+}
+
+// ____________________________________________________________________________
+// Runs the first pass over the input of config and stores the snapshot.
+void recordSnapshot(const osm2rdf::config::Config& config,
+                    CountHandler* countHandler, AreaManager* areaManager,
+                    TestRelationHandler* relationHandler) {
+  Snapshot snapshot{config};
+  snapshot.startRecording();
+  osmium::io::Reader reader{config.input.string(),
+                            osmium::osm_entity_bits::object};
+  while (auto buf = reader.read()) {
+    osmium::apply(buf, *areaManager, *relationHandler, *countHandler,
+                  snapshot);
+  }
+  reader.close();
+  snapshot.store(*countHandler);
+  areaManager->prepare_for_lookup();
+  relationHandler->prepare_for_lookup();
+}
+
+// ____________________________________________________________________________
+// Runs the second pass over the input of config, returns the ids of all
+// assembled areas.
+std::vector<osmium::object_id_type> secondPass(
+    const osm2rdf::config::Config& config, AreaManager* areaManager,
+    TestRelationHandler* relationHandler) {
+  TestLocationIndex index;
+  osmium::handler::NodeLocationsForWays<TestLocationIndex> locations{index};
+  std::vector<osmium::object_id_type> areas;
+  osmium::io::Reader reader{config.input.string(),
+                            osmium::osm_entity_bits::object};
+  while (auto buf = reader.read()) {
+    osmium::apply(
+        buf, locations, *relationHandler,
+        areaManager->handler([&](osmium::memory::Buffer&& assembled) {
+          for (const auto& area : assembled.select<osmium::Area>()) {
+            areas.push_back(area.orig_id());
+          }
+        }));
+  }
+  reader.close();
+  return areas;
+}
+
+// ____________________________________________________________________________
+osmium::area::Assembler::config_type assemblerConfig() {
+  osmium::area::Assembler::config_type config;
+  config.create_empty_areas = false;
+  return config;
+}
+
+// ____________________________________________________________________________
+TEST(OSM_Snapshot, roundTrip) {
+  const auto config = snapshotConfig();
+  CountHandler counts{config};
+  AreaManager areaManager{assemblerConfig(), 0};
+  TestRelationHandler relationHandler{config};
+  recordSnapshot(config, &counts, &areaManager, &relationHandler);
+  ASSERT_TRUE(std::filesystem::exists(Snapshot{config}.headerPath()));
+  ASSERT_TRUE(std::filesystem::exists(Snapshot{config}.relationsPath()));
+
+  CountHandler restored{config};
+  ASSERT_TRUE(Snapshot{config}.load(&restored));
+  ASSERT_EQ(counts.numNodes(), restored.numNodes());
+  ASSERT_EQ(counts.numWays(), restored.numWays());
+  ASSERT_EQ(counts.numRelations(), restored.numRelations());
+  ASSERT_EQ(1, restored.minNodeId());
+  ASSERT_EQ(5, restored.maxNodeId());
+  ASSERT_EQ(counts.requiredNodes().words(), restored.requiredNodes().words());
+  for (uint64_t id = 1; id <= 5; ++id) {
+    ASSERT_TRUE(restored.requiredNodes().get(id));
+  }
+
+  // Replay the stored relations like OsmiumHandler does.
+  AreaManager restoredAreaManager{assemblerConfig(), 0};
+  TestRelationHandler restoredRelationHandler{config};
+  osmium::io::Reader reader{
+      osmium::io::File{Snapshot{config}.relationsPath().string(), "pbf"},
+      osmium::osm_entity_bits::relation};
+  while (auto buf = reader.read()) {
+    osmium::apply(buf, restoredAreaManager, restoredRelationHandler);
+  }
+  reader.close();
+  restoredAreaManager.prepare_for_lookup();
+  restoredRelationHandler.prepare_for_lookup();
+
+  const auto areas = secondPass(config, &areaManager, &relationHandler);
+  ASSERT_EQ(std::vector<osmium::object_id_type>{20}, areas);
+  ASSERT_EQ(areas, secondPass(config, &restoredAreaManager,
+                              &restoredRelationHandler));
+  ASSERT_EQ((std::vector<uint64_t>{4, 5}),
+            restoredRelationHandler.get_noderefs_of_way(11));
+  ASSERT_EQ(relationHandler.get_noderefs_of_way(11),
+            restoredRelationHandler.get_noderefs_of_way(11));
+  // Way 10 is only referenced by an area relation.
+  ASSERT_TRUE(restoredRelationHandler.get_noderefs_of_way(10).empty());
+
+  std::filesystem::remove_all(config.cache);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_Snapshot, incompleteSnapshotIsNotPublished) {
+  const auto config = snapshotConfig();
+  {
+    Snapshot snapshot{config};
+    snapshot.startRecording();
+  }
+  CountHandler restored{config};
+  ASSERT_FALSE(Snapshot{config}.load(&restored));
+  ASSERT_FALSE(std::filesystem::exists(
+      Snapshot{config}.relationsPath().string() + ".tmp"));
+
+  std::filesystem::remove_all(config.cache);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_Snapshot, invalidatedByChangedInput) {
+  const auto config = snapshotConfig();
+  CountHandler counts{config};
+  AreaManager areaManager{assemblerConfig(), 0};
+  TestRelationHandler relationHandler{config};
+  recordSnapshot(config, &counts, &areaManager, &relationHandler);
+  const uint64_t key = Snapshot{config}.key();
+
+  writeSnapshotInput(config.input, true);
+  ASSERT_NE(key, Snapshot{config}.key());
+  CountHandler restored{config};
+  ASSERT_FALSE(Snapshot{config}.load(&restored));
+
+  std::filesystem::remove_all(config.cache);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_Snapshot, invalidatedByChangedOptions) {
+  const auto config = snapshotConfig();
+  CountHandler counts{config};
+  AreaManager areaManager{assemblerConfig(), 0};
+  TestRelationHandler relationHandler{config};
+  recordSnapshot(config, &counts, &areaManager, &relationHandler);
+  const uint64_t key = Snapshot{config}.key();
+
+  auto tagFilter = config;
+  tagFilter.tagFilter = "highway=*";
+  auto shard = config;
+  shard.shardWorker = true;
+  shard.shards = 2;
+  shard.shard = 1;
+  auto storeLocations = config;
+  storeLocations.storeLocations = "mem-flex";
+  for (const auto& changed : {tagFilter, shard, storeLocations}) {
+    ASSERT_NE(key, Snapshot{changed}.key());
+    CountHandler restored{changed};
+    ASSERT_FALSE(Snapshot{changed}.load(&restored));
+  }
+
+  // Options not used in the first pass keep the snapshot valid.
+  auto threads = config;
+  threads.numThreads = config.numThreads + 1;
+  ASSERT_EQ(key, Snapshot{threads}.key());
+  CountHandler restored{threads};
+  ASSERT_TRUE(Snapshot{threads}.load(&restored));
+
+  std::filesystem::remove_all(config.cache);
+}
+
+}  // namespace osm2rdf::osm
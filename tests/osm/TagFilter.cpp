@@ -0,0 +1,106 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/TagFilter.h"
+
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "osmium/builder/attr.hpp"
+#include "osmium/builder/osm_object_builder.hpp"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+osmium::memory::Buffer createTagFilterBuffer() {
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer osmiumBuffer{initial_buffer_size,
+                                      osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(1),
+      osmium::builder::attr::_location(osmium::Location(7.51, 48.0)),
+      osmium::builder::attr::_tag("highway", "primary"),
+      osmium::builder::attr::_tag("name", "B31"));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(2),
+      osmium::builder::attr::_location(osmium::Location(7.51, 48.0)),
+      osmium::builder::attr::_tag("boundary", "administrative"),
+      osmium::builder::attr::_tag("admin_level", "4"));
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(3),
+      osmium::builder::attr::_location(osmium::Location(7.51, 48.0)));
+  return osmiumBuffer;
+}
+
+// ____________________________________________________________________________
+TEST(OSM_TagFilter, empty) {
+  const auto buffer = createTagFilterBuffer();
+  const osm2rdf::osm::TagFilter filter{" "};
+  ASSERT_TRUE(filter.empty());
+  for (const auto& node : buffer.select<osmium::Node>()) {
+    ASSERT_TRUE(filter.matches(node.tags()));
+  }
+}
+
+// ____________________________________________________________________________
+TEST(OSM_TagFilter, key) {
+  const auto buffer = createTagFilterBuffer();
+  const osm2rdf::osm::TagFilter filter{"highway"};
+  ASSERT_FALSE(filter.empty());
+  ASSERT_TRUE(filter.matches(buffer.get<osmium::Node>(0).tags()));
+  const osm2rdf::osm::TagFilter anyValue{"highway=*"};
+  ASSERT_TRUE(anyValue.matches(buffer.get<osmium::Node>(0).tags()));
+  for (const auto& node : buffer.select<osmium::Node>()) {
+    ASSERT_EQ(node.id() == 1, filter.matches(node.tags()));
+    ASSERT_EQ(node.id() == 1, anyValue.matches(node.tags()));
+  }
+}
+
+// ____________________________________________________________________________
+TEST(OSM_TagFilter, values) {
+  const auto buffer = createTagFilterBuffer();
+  const osm2rdf::osm::TagFilter filter{"highway=secondary|primary"};
+  const osm2rdf::osm::TagFilter other{"highway=secondary"};
+  for (const auto& node : buffer.select<osmium::Node>()) {
+    ASSERT_EQ(node.id() == 1, filter.matches(node.tags()));
+    ASSERT_FALSE(other.matches(node.tags()));
+  }
+}
+
+// ____________________________________________________________________________
+TEST(OSM_TagFilter, termsAndConditions) {
+  const auto buffer = createTagFilterBuffer();
+  const osm2rdf::osm::TagFilter filter{
+      "highway=motorway, boundary=administrative & admin_level=2|4"};
+  const osm2rdf::osm::TagFilter negated{"!highway"};
+  for (const auto& node : buffer.select<osmium::Node>()) {
+    ASSERT_EQ(node.id() == 2, filter.matches(node.tags()));
+    ASSERT_EQ(node.id() != 1, negated.matches(node.tags()));
+  }
+}
+
+// ____________________________________________________________________________
+TEST(OSM_TagFilter, invalid) {
+  ASSERT_THROW(osm2rdf::osm::TagFilter{"=primary"}, std::invalid_argument);
+  ASSERT_THROW(osm2rdf::osm::TagFilter{"highway,"}, std::invalid_argument);
+  ASSERT_THROW(osm2rdf::osm::TagFilter{"highway=a||b"},
+               std::invalid_argument);
+  ASSERT_THROW(osm2rdf::osm::TagFilter{"highway&!"}, std::invalid_argument);
+}
+
+}  // namespace osm2rdf::osm
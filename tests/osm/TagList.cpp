@@ -18,6 +18,8 @@
 
 #include "osm2rdf/osm/TagList.h"
 
+#include <memory_resource>
+
 #include "gtest/gtest.h"
 #include "osmium/builder/attr.hpp"
 #include "osmium/builder/osm_object_builder.hpp"
@@ -60,11 +62,34 @@ TEST(OSM_TagList, convertTagListWithSpaceInKey) {
   osm2rdf::osm::TagList tl =
       osm2rdf::osm::convertTagList(osmiumBuffer.get<osmium::Node>(0).tags());
 
+  // Keys are normalized when written, see FactHandler::writeTagList.
   ASSERT_EQ(2, tl.size());
-  ASSERT_EQ("city_name", tl[0].first);
+  ASSERT_EQ("city name", tl[0].first);
   ASSERT_EQ("Freiburg", tl[0].second);
-  ASSERT_EQ("name_of_city", tl[1].first);
+  ASSERT_EQ("name of city", tl[1].first);
   ASSERT_EQ("Freiburg", tl[1].second);
 }
 
+// ____________________________________________________________________________
+TEST(OSM_TagList, convertTagListWithResource) {
+  // Create osmium object
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer osmiumBuffer{initial_buffer_size,
+                                      osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_node(
+      osmiumBuffer, osmium::builder::attr::_id(42),
+      osmium::builder::attr::_location(osmium::Location(7.51, 48.0)),
+      osmium::builder::attr::_tag("city", "Freiburg"));
+
+  // Create osm2rdf object from osmium object using an arena
+  std::pmr::monotonic_buffer_resource arena;
+  osm2rdf::osm::TagList tl = osm2rdf::osm::convertTagList(
+      osmiumBuffer.get<osmium::Node>(0).tags(), &arena);
+
+  ASSERT_EQ(&arena, tl.get_allocator().resource());
+  ASSERT_EQ(1, tl.size());
+  ASSERT_EQ("city", tl[0].first);
+  ASSERT_EQ("Freiburg", tl[0].second);
+}
+
 }  // namespace osm2rdf::osm
@@ -0,0 +1,299 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/osm/UpdateHandler.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock-matchers.h"
+#include "gtest/gtest.h"
+#include "osm2rdf/osm/LocationHandler.h"
+#include "osm2rdf/osm/UpdateState.h"
+#include "osmium/io/any_input.hpp"
+#include "osmium/visitor.hpp"
+
+namespace osm2rdf::osm {
+
+// ____________________________________________________________________________
+void writeUpdateInput(const osm2rdf::config::Config& config) {
+  std::ofstream input(config.input);
+  input << "<?xml version='1.0' encoding='UTF-8'?>\n"
+           "<osm version=\"0.6\" generator=\"test\">\n"
+           " <node id=\"1\" version=\"1\" lat=\"48.0\" lon=\"7.8\"/>\n"
+           " <node id=\"2\" version=\"1\" lat=\"48.1\" lon=\"7.9\"/>\n"
+           " <node id=\"3\" version=\"1\" lat=\"48.2\" lon=\"7.7\"/>\n"
+           " <way id=\"10\" version=\"1\">\n"
+           "  <nd ref=\"1\"/>\n"
+           "  <nd ref=\"2\"/>\n"
+           "  <tag k=\"highway\" v=\"residential\"/>\n"
+           " </way>\n"
+           " <way id=\"11\" version=\"1\">\n"
+           "  <nd ref=\"2\"/>\n"
+           "  <nd ref=\"3\"/>\n"
+           "  <tag k=\"highway\" v=\"track\"/>\n"
+           " </way>\n"
+           " <relation id=\"20\" version=\"1\">\n"
+           "  <member type=\"way\" ref=\"10\" role=\"\"/>\n"
+           "  <tag k=\"type\" v=\"route\"/>\n"
+           " </relation>\n"
+           "</osm>\n";
+}
+
+// ____________________________________________________________________________
+// Writes the state like the second pass of a full run with --update-state.
+void writeUpdateState(const osm2rdf::config::Config& config) {
+  osm2rdf::osm::LocationHandlerFSPersistent locationHandler{config, 1, 3};
+  osm2rdf::osm::UpdateState state{config, true};
+  osmium::io::Reader reader{osmium::io::File{config.input.string()}};
+  while (auto buf = reader.read()) {
+    osmium::apply(buf, state, locationHandler);
+  }
+  reader.close();
+  locationHandler.finalize();
+  state.finalize();
+}
+
+// ____________________________________________________________________________
+// Writes the SPARQL update for changes and returns it.
+std::string writeUpdate(const osm2rdf::config::Config& config,
+                        const std::string& changes) {
+  {
+    std::ofstream file(config.updateChanges);
+    file << "<?xml version='1.0' encoding='UTF-8'?>\n"
+            "<osmChange version=\"0.6\" generator=\"test\">\n"
+         << changes << "</osmChange>\n";
+  }
+  std::stringstream buffer;
+  std::streambuf* sbuf = std::cout.rdbuf();
+  std::cout.rdbuf(buffer.rdbuf());
+  osm2rdf::util::Output output{config, config.output};
+  output.open();
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::NT> writer{config, &output};
+  osm2rdf::osm::FactHandler<osm2rdf::ttl::format::NT> factHandler(config,
+                                                                  &writer);
+  osm2rdf::osm::UpdateHandler<osm2rdf::ttl::format::NT> updateHandler{
+      config, &factHandler, &writer, &output};
+  updateHandler.handle();
+  output.flush();
+  output.close();
+  std::cout.rdbuf(sbuf);
+  return buffer.str();
+}
+
+// ____________________________________________________________________________
+TEST(OSM_UpdateHandler, modifiedNodeAffectsWayAndRelation) {
+  // Capture std::cout and std::cerr
+  std::stringstream buffer;
+  std::stringstream cerrBuffer;
+  std::streambuf* sbuf = std::cout.rdbuf();
+  std::streambuf* cerrBufferOrig = std::cerr.rdbuf();
+  std::cout.rdbuf(buffer.rdbuf());
+  std::cerr.rdbuf(cerrBuffer.rdbuf());
+
+  osm2rdf::config::Config config;
+  config.output = "";
+  config.numThreads = 1;
+  config.outputCompress = osm2rdf::config::NONE;
+  config.mergeOutput = osm2rdf::util::OutputMergeMode::NONE;
+  config.ogcGeoTriplesMode = osm2rdf::config::GeoTriplesMode::none;
+  config.noGeometricRelations = true;
+  config.updateState = true;
+  config.input = config.getTempPath("OSM_UpdateHandler", "input.osm");
+  config.updateChanges =
+      config.getTempPath("OSM_UpdateHandler", "changes.osc");
+  writeUpdateInput(config);
+  writeUpdateState(config);
+  {
+    std::ofstream changes(config.updateChanges);
+    changes << "<?xml version='1.0' encoding='UTF-8'?>\n"
+               "<osmChange version=\"0.6\" generator=\"test\">\n"
+               " <modify>\n"
+               "  <node id=\"1\" version=\"2\" lat=\"48.05\" lon=\"7.85\"/>\n"
+               " </modify>\n"
+               "</osmChange>\n";
+  }
+
+  osm2rdf::util::Output output{config, config.output};
+  output.open();
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::NT> writer{config, &output};
+  osm2rdf::osm::FactHandler<osm2rdf::ttl::format::NT> factHandler(config,
+                                                                  &writer);
+  osm2rdf::osm::UpdateHandler<osm2rdf::ttl::format::NT> updateHandler{
+      config, &factHandler, &writer, &output};
+  updateHandler.handle();
+  output.flush();
+  output.close();
+
+  ASSERT_EQ(1, updateHandler.numChanged());
+  ASSERT_EQ(2, updateHandler.numAffected());
+  const std::string printedData = buffer.str();
+  ASSERT_THAT(printedData,
+              ::testing::HasSubstr(
+                  "DELETE { <https://www.openstreetmap.org/way/10> ?p ?o"));
+  ASSERT_THAT(printedData,
+              ::testing::HasSubstr("DELETE { "
+                                   "<https://www.openstreetmap.org/relation/20>"
+                                   " ?p ?o"));
+  ASSERT_THAT(printedData,
+              ::testing::Not(::testing::HasSubstr(
+                  "<https://www.openstreetmap.org/way/11>")));
+  ASSERT_THAT(printedData, ::testing::HasSubstr("INSERT DATA {"));
+  ASSERT_THAT(printedData, ::testing::HasSubstr("7.85"));
+
+  // Reset std::cout and std::cerr
+  std::cout.rdbuf(sbuf);
+  std::cerr.rdbuf(cerrBufferOrig);
+  std::filesystem::remove(config.input);
+  std::filesystem::remove(config.updateChanges);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_UpdateHandler, deletedWayIsNotInserted) {
+  // Capture std::cout and std::cerr
+  std::stringstream buffer;
+  std::stringstream cerrBuffer;
+  std::streambuf* sbuf = std::cout.rdbuf();
+  std::streambuf* cerrBufferOrig = std::cerr.rdbuf();
+  std::cout.rdbuf(buffer.rdbuf());
+  std::cerr.rdbuf(cerrBuffer.rdbuf());
+
+  osm2rdf::config::Config config;
+  config.output = "";
+  config.numThreads = 1;
+  config.outputCompress = osm2rdf::config::NONE;
+  config.mergeOutput = osm2rdf::util::OutputMergeMode::NONE;
+  config.ogcGeoTriplesMode = osm2rdf::config::GeoTriplesMode::none;
+  config.noGeometricRelations = true;
+  config.updateState = true;
+  config.input = config.getTempPath("OSM_UpdateHandler", "input.osm");
+  config.updateChanges =
+      config.getTempPath("OSM_UpdateHandler", "changes.osc");
+  writeUpdateInput(config);
+  writeUpdateState(config);
+  {
+    std::ofstream changes(config.updateChanges);
+    changes << "<?xml version='1.0' encoding='UTF-8'?>\n"
+               "<osmChange version=\"0.6\" generator=\"test\">\n"
+               " <delete>\n"
+               "  <way id=\"11\" version=\"2\" visible=\"false\"/>\n"
+               " </delete>\n"
+               "</osmChange>\n";
+  }
+
+  osm2rdf::util::Output output{config, config.output};
+  output.open();
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::NT> writer{config, &output};
+  osm2rdf::osm::FactHandler<osm2rdf::ttl::format::NT> factHandler(config,
+                                                                  &writer);
+  osm2rdf::osm::UpdateHandler<osm2rdf::ttl::format::NT> updateHandler{
+      config, &factHandler, &writer, &output};
+  updateHandler.handle();
+  output.flush();
+  output.close();
+
+  ASSERT_EQ(1, updateHandler.numChanged());
+  ASSERT_EQ(0, updateHandler.numAffected());
+  const std::string printedData = buffer.str();
+  ASSERT_THAT(printedData,
+              ::testing::HasSubstr(
+                  "DELETE { <https://www.openstreetmap.org/way/11> ?p ?o"));
+  const std::string inserts =
+      printedData.substr(printedData.find("INSERT DATA {"));
+  ASSERT_THAT(inserts, ::testing::Not(::testing::HasSubstr(
+                           "<https://www.openstreetmap.org/way/11>")));
+
+  // Reset std::cout and std::cerr
+  std::cout.rdbuf(sbuf);
+  std::cerr.rdbuf(cerrBufferOrig);
+  std::filesystem::remove(config.input);
+  std::filesystem::remove(config.updateChanges);
+}
+
+// ____________________________________________________________________________
+TEST(OSM_UpdateHandler, updatesAdvanceState) {
+  // Capture std::cerr
+  std::stringstream cerrBuffer;
+  std::streambuf* cerrBufferOrig = std::cerr.rdbuf();
+  std::cerr.rdbuf(cerrBuffer.rdbuf());
+
+  osm2rdf::config::Config config;
+  config.output = "";
+  config.numThreads = 1;
+  config.outputCompress = osm2rdf::config::NONE;
+  config.mergeOutput = osm2rdf::util::OutputMergeMode::NONE;
+  config.ogcGeoTriplesMode = osm2rdf::config::GeoTriplesMode::none;
+  config.noGeometricRelations = true;
+  config.updateState = true;
+  config.input = config.getTempPath("OSM_UpdateHandler", "input.osm");
+  config.updateChanges =
+      config.getTempPath("OSM_UpdateHandler", "changes.osc");
+  writeUpdateInput(config);
+  writeUpdateState(config);
+
+  // A new way with a new node, added to the relation.
+  writeUpdate(config,
+              " <create>\n"
+              "  <node id=\"4\" version=\"1\" lat=\"48.3\" lon=\"7.6\"/>\n"
+              "  <way id=\"12\" version=\"1\">\n"
+              "   <nd ref=\"3\"/>\n"
+              "   <nd ref=\"4\"/>\n"
+              "   <tag k=\"highway\" v=\"path\"/>\n"
+              "  </way>\n"
+              " </create>\n"
+              " <modify>\n"
+              "  <relation id=\"20\" version=\"2\">\n"
+              "   <member type=\"way\" ref=\"10\" role=\"\"/>\n"
+              "   <member type=\"way\" ref=\"12\" role=\"\"/>\n"
+              "   <tag k=\"type\" v=\"route\"/>\n"
+              "  </relation>\n"
+              " </modify>\n");
+  // The state knows the objects of the first change file.
+  const std::string printedData =
+      writeUpdate(config,
+                  " <modify>\n"
+                  "  <node id=\"4\" version=\"2\" lat=\"48.35\" "
+                  "lon=\"7.65\"/>\n"
+                  " </modify>\n");
+  ASSERT_THAT(printedData,
+              ::testing::HasSubstr(
+                  "DELETE { <https://www.openstreetmap.org/way/12> ?p ?o"));
+  ASSERT_THAT(printedData,
+              ::testing::HasSubstr("DELETE { "
+                                   "<https://www.openstreetmap.org/relation/20>"
+                                   " ?p ?o"));
+  ASSERT_THAT(printedData, ::testing::Not(::testing::HasSubstr(
+                               "<https://www.openstreetmap.org/way/11>")));
+  ASSERT_THAT(printedData, ::testing::HasSubstr("7.65"));
+
+  // The state belongs to the original input only.
+  {
+    std::ofstream input(config.input, std::ios::app);
+    input << "\n";
+  }
+  ASSERT_THROW(osm2rdf::osm::UpdateState(config, false), std::runtime_error);
+
+  // Reset std::cerr
+  std::cerr.rdbuf(cerrBufferOrig);
+  std::filesystem::remove(config.input);
+  std::filesystem::remove(config.updateChanges);
+}
+
+}  // namespace osm2rdf::osm
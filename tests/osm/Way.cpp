@@ -18,12 +18,25 @@
 
 #include "osm2rdf/osm/Way.h"
 
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "osmium/builder/attr.hpp"
 #include "osmium/builder/osm_object_builder.hpp"
 
 namespace osm2rdf::osm {
 
+// ____________________________________________________________________________
+TEST(OSM_Way, defaultConstructor) {
+  const osm2rdf::osm::Way w;
+  ASSERT_EQ(std::numeric_limits<osm2rdf::osm::Way::id_t>::max(), w.id());
+  ASSERT_EQ(0, w.nodes().size());
+  ASSERT_TRUE(w.nodes().empty());
+  ASSERT_FALSE(w.closed());
+  ASSERT_FALSE(w.isArea());
+  ASSERT_EQ(w, osm2rdf::osm::Way{});
+}
+
 // ____________________________________________________________________________
 TEST(OSM_Way, FromWay) {
   // Create osmium object
@@ -44,8 +57,8 @@ TEST(OSM_Way, FromWay) {
   ASSERT_EQ(0, w.tags().size());
 
   ASSERT_EQ(2, w.nodes().size());
-  ASSERT_EQ(1, w.nodes().at(0).id());
-  ASSERT_EQ(2, w.nodes().at(1).id());
+  ASSERT_EQ(1, w.nodes()[0].positive_ref());
+  ASSERT_EQ(2, w.nodes()[1].positive_ref());
 
   ASSERT_EQ(2, w.geom().size());
   ASSERT_DOUBLE_EQ(48.0, w.geom().at(0).getX());
@@ -82,8 +95,8 @@ TEST(OSM_Way, FromWayWithTags) {
   ASSERT_EQ("Freiburg", w.tags()[0].second);
 
   ASSERT_EQ(2, w.nodes().size());
-  ASSERT_EQ(1, w.nodes().at(0).id());
-  ASSERT_EQ(2, w.nodes().at(1).id());
+  ASSERT_EQ(1, w.nodes()[0].positive_ref());
+  ASSERT_EQ(2, w.nodes()[1].positive_ref());
 
   ASSERT_EQ(2, w.geom().size());
   ASSERT_DOUBLE_EQ(48.0, w.geom().at(0).getX());
@@ -118,9 +131,9 @@ TEST(OSM_Way, FromClosedWay) {
   ASSERT_EQ(0, w.tags().size());
 
   ASSERT_EQ(3, w.nodes().size());
-  ASSERT_EQ(1, w.nodes().at(0).id());
-  ASSERT_EQ(2, w.nodes().at(1).id());
-  ASSERT_EQ(1, w.nodes().at(2).id());
+  ASSERT_EQ(1, w.nodes()[0].positive_ref());
+  ASSERT_EQ(2, w.nodes()[1].positive_ref());
+  ASSERT_EQ(1, w.nodes()[2].positive_ref());
 
   ASSERT_EQ(3, w.geom().size());
   ASSERT_DOUBLE_EQ(48.0, w.geom().at(0).getX());
@@ -159,11 +172,11 @@ TEST(OSM_Way, FromClosedWayWithDuplicateNodes) {
   ASSERT_EQ(0, w.tags().size());
 
   ASSERT_EQ(5, w.nodes().size());
-  ASSERT_EQ(1, w.nodes().at(0).id());
-  ASSERT_EQ(2, w.nodes().at(1).id());
-  ASSERT_EQ(2, w.nodes().at(2).id());
-  ASSERT_EQ(2, w.nodes().at(3).id());
-  ASSERT_EQ(1, w.nodes().at(4).id());
+  ASSERT_EQ(1, w.nodes()[0].positive_ref());
+  ASSERT_EQ(2, w.nodes()[1].positive_ref());
+  ASSERT_EQ(2, w.nodes()[2].positive_ref());
+  ASSERT_EQ(2, w.nodes()[3].positive_ref());
+  ASSERT_EQ(1, w.nodes()[4].positive_ref());
 
   ASSERT_EQ(3, w.geom().size());
   ASSERT_DOUBLE_EQ(48.0, w.geom().at(0).getX());
@@ -179,6 +192,26 @@ TEST(OSM_Way, FromClosedWayWithDuplicateNodes) {
   ASSERT_DOUBLE_EQ(7.61, w.envelope().getUpperRight().getY());
 }
 
+// ____________________________________________________________________________
+TEST(OSM_Way, length) {
+  // Create osmium object
+  const size_t initial_buffer_size = 10000;
+  osmium::memory::Buffer buffer{initial_buffer_size,
+                                osmium::memory::Buffer::auto_grow::yes};
+  osmium::builder::add_way(buffer, osmium::builder::attr::_id(42),
+                           osmium::builder::attr::_nodes({
+                               {1, {48.0, 7.5}},
+                               {2, {48.3, 7.5}},
+                               {3, {48.3, 7.5}},
+                               {4, {48.3, 7.9}},
+                           }));
+
+  // Create osm2rdf object from osmium object
+  const osm2rdf::osm::Way w{buffer.get<osmium::Way>(0)};
+  ASSERT_NEAR(0.7, w.length(), 1e-9);
+  ASSERT_DOUBLE_EQ(::util::geo::len(w.geom()), w.length());
+}
+
 // ____________________________________________________________________________
 TEST(OSM_Way, isAreaFalseForClosedWayWithoutArea) {
     // Create osmium object
@@ -18,6 +18,9 @@
 
 #include "osm2rdf/ttl/Writer.h"
 
+#include <limits>
+#include <string>
+
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
 #include "osm2rdf/config/Config.h"
@@ -216,6 +219,23 @@ TEST(TTL_WriterNT, generateBlankNode) {
   }
 }
 
+// ____________________________________________________________________________
+TEST(TTL_WriterNT, generateBlankNodeShard) {
+  osm2rdf::config::Config config;
+  config.shards = 4;
+  config.shardWorker = true;
+  config.shard = 3;
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::NT> w{config, nullptr};
+  {
+    const std::string res = w.generateBlankNode();
+    ASSERT_STREQ("_:3_0_0", res.c_str());
+  }
+  {
+    const std::string res = w.generateBlankNode();
+    ASSERT_STREQ("_:3_0_1", res.c_str());
+  }
+}
+
 // ____________________________________________________________________________
 TEST(TTL_WriterTTL, generateBlankNode) {
   osm2rdf::config::Config config;
@@ -341,6 +361,54 @@ TEST(TTL_WriterQLEVER, generateIRI_ID) {
   }
 }
 
+// ____________________________________________________________________________
+TEST(TTL_WriterNT, generateIRI_IDBuffer) {
+  osm2rdf::config::Config config;
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::NT> w{config, nullptr};
+  // The previous content of the buffer is replaced.
+  std::string res = "previous content of the buffer";
+  w.generateIRI(osm2rdf::ttl::constants::NAMESPACE__OSM_NODE, 23, &res);
+  ASSERT_EQ(w.generateIRI(osm2rdf::ttl::constants::NAMESPACE__OSM_NODE, 23),
+            res);
+  w.generateIRI("prefix", 42, &res);
+  ASSERT_EQ(w.generateIRI("prefix", 42), res);
+  w.generateIRI("prefix", std::numeric_limits<uint64_t>::max(), &res);
+  ASSERT_EQ(w.generateIRI("prefix", std::numeric_limits<uint64_t>::max()),
+            res);
+}
+
+// ____________________________________________________________________________
+TEST(TTL_WriterTTL, generateIRI_IDBuffer) {
+  osm2rdf::config::Config config;
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::TTL> w{config, nullptr};
+  // The previous content of the buffer is replaced.
+  std::string res = "previous content of the buffer";
+  w.generateIRI(osm2rdf::ttl::constants::NAMESPACE__OSM_NODE, 23, &res);
+  ASSERT_EQ(w.generateIRI(osm2rdf::ttl::constants::NAMESPACE__OSM_NODE, 23),
+            res);
+  w.generateIRI("prefix", 42, &res);
+  ASSERT_EQ(w.generateIRI("prefix", 42), res);
+  w.generateIRI("prefix", std::numeric_limits<uint64_t>::max(), &res);
+  ASSERT_EQ(w.generateIRI("prefix", std::numeric_limits<uint64_t>::max()),
+            res);
+}
+
+// ____________________________________________________________________________
+TEST(TTL_WriterQLEVER, generateIRI_IDBuffer) {
+  osm2rdf::config::Config config;
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::QLEVER> w{config, nullptr};
+  // The previous content of the buffer is replaced.
+  std::string res = "previous content of the buffer";
+  w.generateIRI(osm2rdf::ttl::constants::NAMESPACE__OSM_NODE, 23, &res);
+  ASSERT_EQ(w.generateIRI(osm2rdf::ttl::constants::NAMESPACE__OSM_NODE, 23),
+            res);
+  w.generateIRI("prefix", 42, &res);
+  ASSERT_EQ(w.generateIRI("prefix", 42), res);
+  w.generateIRI("prefix", std::numeric_limits<uint64_t>::max(), &res);
+  ASSERT_EQ(w.generateIRI("prefix", std::numeric_limits<uint64_t>::max()),
+            res);
+}
+
 // ____________________________________________________________________________
 TEST(TTL_WriterNT, generateIRI_String) {
   osm2rdf::config::Config config;
@@ -532,6 +600,19 @@ TEST(TTL_WriterNT, generateLiteral) {
   }
 }
 
+// ____________________________________________________________________________
+TEST(TTL_WriterNT, generateLiteralBuffer) {
+  osm2rdf::config::Config config;
+  osm2rdf::ttl::Writer<osm2rdf::ttl::format::NT> w{config, nullptr};
+  std::string res = "previous content of the buffer";
+  w.generateLiteral("abc", &res);
+  ASSERT_EQ("\"abc\"", res);
+  w.generateLiteral("a\"b\\c\nd\re", &res);
+  ASSERT_EQ(w.generateLiteral("a\"b\\c\nd\re"), res);
+  w.generateLiteral("", &res);
+  ASSERT_EQ("\"\"", res);
+}
+
 // ____________________________________________________________________________
 TEST(TTL_WriterTTL, generateLiteral) {
   osm2rdf::config::Config config;
@@ -243,4 +243,35 @@ TEST(UTIL_DirectedGraph, getEdges) {
   }
 }
 
+// ____________________________________________________________________________
+TEST(UTIL_DirectedGraph, sortTopologicallyBottomUp) {
+  osm2rdf::util::DirectedGraph<uint8_t> g{};
+  ASSERT_EQ(0, g.sortTopologicallyBottomUp().size());
+  g.addEdge(1, 2);
+  g.addEdge(1, 3);
+  g.addEdge(1, 3);
+  g.addEdge(3, 2);
+  g.addEdge(4, 1);
+  {
+    auto res = g.sortTopologicallyBottomUp();
+    ASSERT_EQ(4, res.size());
+    ASSERT_EQ(2, res[0]);
+    ASSERT_EQ(3, res[1]);
+    ASSERT_EQ(1, res[2]);
+    ASSERT_EQ(4, res[3]);
+  }
+  // Cycle 5 -> 6 -> 5, 7 reaches the cycle, 6 also points to 2.
+  g.addEdge(5, 6);
+  g.addEdge(6, 5);
+  g.addEdge(6, 2);
+  g.addEdge(7, 5);
+  {
+    auto res = g.sortTopologicallyBottomUp();
+    ASSERT_EQ(4, res.size());
+    ASSERT_EQ(std::find(res.begin(), res.end(), 5), res.end());
+    ASSERT_EQ(std::find(res.begin(), res.end(), 6), res.end());
+    ASSERT_EQ(std::find(res.begin(), res.end(), 7), res.end());
+  }
+}
+
 }  // namespace osm2rdf::util
\ No newline at end of file
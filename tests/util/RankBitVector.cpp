@@ -0,0 +1,91 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/RankBitVector.h"
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::util {
+
+// ____________________________________________________________________________
+TEST(UTIL_RankBitVector, empty) {
+  osm2rdf::util::RankBitVector bits;
+  bits.buildRank();
+  ASSERT_TRUE(bits.empty());
+  ASSERT_EQ(0, bits.count());
+  ASSERT_EQ(0, bits.rank(0));
+  ASSERT_EQ(0, bits.rank(1000));
+  ASSERT_FALSE(bits.get(0));
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_RankBitVector, rankAndSelect) {
+  osm2rdf::util::RankBitVector bits;
+  const std::vector<uint64_t> positions{0, 1, 63, 64, 511, 512, 513, 10000};
+  for (auto it = positions.rbegin(); it != positions.rend(); ++it) {
+    bits.set(*it);
+  }
+  bits.buildRank();
+  ASSERT_EQ(positions.size(), bits.count());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    ASSERT_TRUE(bits.get(positions[i]));
+    ASSERT_EQ(i, bits.rank(positions[i]));
+    ASSERT_EQ(i + 1, bits.rank(positions[i] + 1));
+    ASSERT_EQ(positions[i], bits.select(i));
+  }
+  ASSERT_FALSE(bits.get(2));
+  ASSERT_FALSE(bits.get(10001));
+  ASSERT_FALSE(bits.get(1000000));
+  ASSERT_EQ(3, bits.rank(64));
+  ASSERT_EQ(positions.size(), bits.rank(1000000));
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_RankBitVector, fromWords) {
+  osm2rdf::util::RankBitVector bits;
+  for (uint64_t i = 0; i < 5000; i += 7) {
+    bits.set(i);
+  }
+  bits.buildRank();
+  osm2rdf::util::RankBitVector copy{bits.words()};
+  ASSERT_EQ(bits.count(), copy.count());
+  for (uint64_t i = 0; i < 5000; ++i) {
+    ASSERT_EQ(bits.get(i), copy.get(i));
+    ASSERT_EQ(bits.rank(i), copy.rank(i));
+  }
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_RankBitVector, merge) {
+  osm2rdf::util::RankBitVector a;
+  a.set(1);
+  a.set(100);
+  osm2rdf::util::RankBitVector b;
+  b.set(2);
+  b.set(100);
+  b.set(5000);
+  a.merge(b);
+  a.buildRank();
+  ASSERT_EQ(4, a.count());
+  ASSERT_TRUE(a.get(1));
+  ASSERT_TRUE(a.get(2));
+  ASSERT_TRUE(a.get(100));
+  ASSERT_TRUE(a.get(5000));
+}
+
+}  // namespace osm2rdf::util
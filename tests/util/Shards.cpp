@@ -0,0 +1,52 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/Shards.h"
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::util {
+
+// ____________________________________________________________________________
+TEST(UTIL_Shards, shardOfKeepsBlocksTogether) {
+  ASSERT_EQ(0, shardOf(0, 4));
+  ASSERT_EQ(0, shardOf((1 << 16) - 1, 4));
+  ASSERT_EQ(1, shardOf(1 << 16, 4));
+  ASSERT_EQ(3, shardOf(3 << 16, 4));
+  ASSERT_EQ(0, shardOf(4 << 16, 4));
+  ASSERT_EQ(0, shardOf(123456789, 1));
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_Shards, shardOfRange) {
+  ASSERT_EQ(1, shardOfRange(1 << 16, (2 << 16) - 1, 4));
+  ASSERT_EQ(2, shardOfRange(2 << 16, 2 << 16, 4));
+  // Ranges spanning blocks belong to different shards.
+  ASSERT_EQ(4, shardOfRange((1 << 16) - 1, 1 << 16, 4));
+  ASSERT_EQ(4, shardOfRange(0, 4 << 16, 4));
+  ASSERT_EQ(0, shardOfRange(0, 123456789, 1));
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_Shards, shardOutput) {
+  ASSERT_EQ("/tmp/out.ttl.bz2.shard_0",
+            shardOutput("/tmp/out.ttl.bz2", 0).string());
+  ASSERT_EQ("/tmp/out.ttl.shard_12", shardOutput("/tmp/out.ttl", 12).string());
+}
+
+}  // namespace osm2rdf::util
@@ -0,0 +1,79 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/TaskLimiter.h"
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::util {
+
+// ____________________________________________________________________________
+TEST(UTIL_TaskLimiter, unlimited) {
+  osm2rdf::util::TaskLimiter limiter{0, 0};
+  for (size_t i = 0; i < 1000; ++i) {
+    ASSERT_FALSE(limiter.add(1000));
+  }
+  ASSERT_EQ(1000, limiter.objects());
+  ASSERT_EQ(1000000, limiter.bytes());
+  ASSERT_EQ(0, limiter.numWaits());
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_TaskLimiter, maxObjects) {
+  osm2rdf::util::TaskLimiter limiter{3, 0};
+  ASSERT_FALSE(limiter.add(100));
+  ASSERT_FALSE(limiter.add(100));
+  ASSERT_TRUE(limiter.add(100));
+  ASSERT_EQ(1, limiter.numWaits());
+  ASSERT_FALSE(limiter.drained());
+  limiter.done(1, 100);
+  ASSERT_FALSE(limiter.drained());
+  limiter.done(1, 100);
+  ASSERT_TRUE(limiter.drained());
+  ASSERT_EQ(1, limiter.objects());
+  ASSERT_EQ(100, limiter.bytes());
+  ASSERT_FALSE(limiter.add(100));
+  ASSERT_TRUE(limiter.add(100));
+  ASSERT_EQ(2, limiter.numWaits());
+}
+
+TEST(UTIL_TaskLimiter, maxBytes) {
+  osm2rdf::util::TaskLimiter limiter{0, 250};
+  ASSERT_FALSE(limiter.add(100));
+  ASSERT_FALSE(limiter.add(100));
+  ASSERT_TRUE(limiter.add(100));
+  limiter.done(3, 300);
+  ASSERT_TRUE(limiter.drained());
+  ASSERT_TRUE(limiter.add(300));
+  ASSERT_EQ(2, limiter.numWaits());
+  ASSERT_FALSE(limiter.drained());
+}
+
+TEST(UTIL_TaskLimiter, doneBeforeAdd) {
+  osm2rdf::util::TaskLimiter limiter{10, 0};
+  ASSERT_FALSE(limiter.add(100));
+  // A task may finish objects before the producer registered all of them.
+  limiter.done(2, 200);
+  ASSERT_EQ(0, limiter.objects());
+  ASSERT_EQ(0, limiter.bytes());
+  ASSERT_TRUE(limiter.drained());
+  ASSERT_FALSE(limiter.add(100));
+  ASSERT_EQ(0, limiter.objects());
+}
+
+}  // namespace osm2rdf::util
@@ -0,0 +1,63 @@
+// Copyright 2024, University of Freiburg
+// Authors: Axel Lehmann <lehmann@cs.uni-freiburg.de>.
+
+// This file is part of osm2rdf.
+//
+// osm2rdf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm2rdf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm2rdf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm2rdf/util/ThreadCounters.h"
+
+#include "gtest/gtest.h"
+
+namespace osm2rdf::util {
+
+// ____________________________________________________________________________
+TEST(UTIL_ThreadCounters, singleThread) {
+  osm2rdf::util::ThreadCounters counters{1, 3};
+  ASSERT_EQ(0, counters.get(0));
+  ASSERT_EQ(0, counters.get(1));
+  ASSERT_EQ(0, counters.get(2));
+  counters.add(0, 1);
+  counters.add(2, 5);
+  counters.add(2, 5);
+  ASSERT_EQ(1, counters.get(0));
+  ASSERT_EQ(0, counters.get(1));
+  ASSERT_EQ(10, counters.get(2));
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_ThreadCounters, multipleCacheLines) {
+  osm2rdf::util::ThreadCounters counters{2, 20};
+  for (size_t i = 0; i < 20; ++i) {
+    counters.add(i, i);
+  }
+  for (size_t i = 0; i < 20; ++i) {
+    ASSERT_EQ(i, counters.get(i));
+  }
+}
+
+// ____________________________________________________________________________
+TEST(UTIL_ThreadCounters, parallel) {
+  const size_t n = 100000;
+  osm2rdf::util::ThreadCounters counters{4, 2};
+#pragma omp parallel for num_threads(4)
+  for (size_t i = 0; i < n; ++i) {
+    counters.add(0, 1);
+    counters.add(1, 2);
+  }
+  ASSERT_EQ(n, counters.get(0));
+  ASSERT_EQ(2 * n, counters.get(1));
+}
+
+}  // namespace osm2rdf::util